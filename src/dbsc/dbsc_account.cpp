@@ -6,27 +6,88 @@
 #include <bdldfp_decimal.h>
 #include <bsls_assert.h>
 
+#include <algorithm>
 #include <format>
+#include <stdexcept>
+#include <utility>
 
 namespace dbsc {
 
-Account::Account( UuidString const& accountId, std::string const& name, std::string const& description )
+Account::Account( UuidString const& accountId,
+                  std::string const& name,
+                  std::string const& description,
+                  allocator_type const& allocator )
   : mId( accountId )
   , mName( name )
   , mDescription( description )
+  , mTransactions( allocator )
+  , mTransactionIndex( allocator )
+  , mBalanceIndex( allocator )
+  , mWeeklyRollup( RollupPeriod::kWeek, allocator )
+  , mMonthlyRollup( RollupPeriod::kMonth, allocator )
+  , mAmountStats( allocator )
 {
-  using namespace BloombergLP::bdldfp::DecimalLiterals;
-  BSLS_ASSERT( mBalance == "0.0"_d64 );
 }
 
-Account::Account( std::string const& name, std::string const& description )
-  : Account( UuidStringUtil::generate(), name, description )
+Account::Account( std::string const& name, std::string const& description, allocator_type const& allocator )
+  : Account( UuidStringUtil::generate(), name, description, allocator )
 {
 }
 
+Account::Account( Account const& original, allocator_type const& allocator )
+  : mId( original.mId )
+  , mName( original.mName )
+  , mDescription( original.mDescription )
+  , mTransactions( original.mTransactions, allocator )
+  , mTransactionIndex( original.mTransactionIndex, allocator )
+  , mBalanceIndex( original.mBalanceIndex, allocator )
+  , mWeeklyRollup( original.mWeeklyRollup, allocator )
+  , mMonthlyRollup( original.mMonthlyRollup, allocator )
+  , mAmountStats( original.mAmountStats, allocator )
+  , mIsActive( original.mIsActive )
+{
+}
+
+Account::Account( Account&& original ) noexcept = default;
+
+Account::Account( Account&& original, allocator_type const& allocator )
+  : mId( original.mId )
+  , mName( std::move( original.mName ) )
+  , mDescription( std::move( original.mDescription ) )
+  , mTransactions( std::move( original.mTransactions ), allocator )
+  , mTransactionIndex( std::move( original.mTransactionIndex ), allocator )
+  , mBalanceIndex( std::move( original.mBalanceIndex ), allocator )
+  , mWeeklyRollup( std::move( original.mWeeklyRollup ), allocator )
+  , mMonthlyRollup( std::move( original.mMonthlyRollup ), allocator )
+  , mAmountStats( std::move( original.mAmountStats ), allocator )
+  , mIsActive( original.mIsActive )
+{
+}
+
+auto Account::operator=( Account const& rhs ) -> Account& = default;
+
+auto Account::operator=( Account&& rhs ) -> Account& = default;
+
+auto Account::get_allocator() const noexcept -> allocator_type
+{
+  return mTransactions.get_allocator();
+}
+
 auto Account::balance() const -> BloombergLP::bdldfp::Decimal64
 {
-  return mBalance;
+  return mTransactions.total();
+}
+
+auto Account::balanceAsOf( TimeStamp timeStamp ) const -> BloombergLP::bdldfp::Decimal64
+{
+  return mBalanceIndex.balanceAsOf( timeStamp );
+}
+
+auto Account::transactionsBetween( TimeStamp begin, TimeStamp end ) const
+  -> std::ranges::subrange< ChronologicalIterator >
+{
+  auto const rows = mBalanceIndex.rowsBetween( begin, end );
+  return { ChronologicalIterator( this, rows.begin() ), ChronologicalIterator( this, rows.end() ) };
 }
 
 auto Account::description() const -> std::string const&
@@ -56,54 +117,174 @@ auto Account::isActive() const -> bool
 
 auto Account::begin() -> iterator
 {
-  return mTransactions.begin();
+  return iterator( this, 0 );
 }
 
 auto Account::begin() const -> const_iterator
 {
-  return mTransactions.begin();
+  return const_iterator( this, 0 );
 }
 
 auto Account::cbegin() const noexcept -> const_iterator
 {
-  return mTransactions.cbegin();
+  return const_iterator( this, 0 );
 }
 
 auto Account::end() -> iterator
 {
-  return mTransactions.end();
+  return iterator( this, static_cast< TransactionStore::Row >( mTransactions.size() ) );
 }
 
 auto Account::end() const -> const_iterator
 {
-  return mTransactions.end();
+  return const_iterator( this, static_cast< TransactionStore::Row >( mTransactions.size() ) );
 }
 
 auto Account::cend() const noexcept -> const_iterator
 {
-  return mTransactions.cend();
+  return const_iterator( this, static_cast< TransactionStore::Row >( mTransactions.size() ) );
 }
 
 auto Account::contains( UuidString const& transactionId ) const -> bool
 {
-  return mTransactions.contains( transactionId );
+  return mTransactionIndex.contains( transactionId );
 }
 
-auto Account::transaction( UuidString const& transactionId ) const -> Transaction const&
+auto Account::contains( std::string_view transactionId ) const -> bool
 {
-  return mTransactions.at( transactionId );
+  return mTransactionIndex.contains( transactionId );
+}
+
+auto Account::transaction( UuidString const& transactionId ) const -> Transaction
+{
+  auto const position = mTransactionIndex.find( transactionId );
+  if ( not position.has_value() ) {
+    throw std::out_of_range( std::format( "Transaction {0} does not exist.", transactionId ) );
+  }
+  return mTransactions.materialize( *position, mId );
+}
+
+auto Account::transaction( std::string_view transactionId ) const -> Transaction
+{
+  auto const position = mTransactionIndex.find( transactionId );
+  if ( not position.has_value() ) {
+    throw std::out_of_range( std::format( "Transaction {0} does not exist.", transactionId ) );
+  }
+  return mTransactions.materialize( *position, mId );
+}
+
+auto Account::rowOf( UuidString const& transactionId ) const -> std::optional< TransactionStore::Row >
+{
+  auto const position = mTransactionIndex.find( transactionId );
+  if ( not position.has_value() ) {
+    return std::nullopt;
+  }
+  return static_cast< TransactionStore::Row >( *position );
+}
+
+auto Account::transactions() const noexcept -> TransactionStore const&
+{
+  return mTransactions;
+}
+
+auto Account::balances() const noexcept -> BalanceIndex const&
+{
+  return mBalanceIndex;
+}
+
+auto Account::rollup( RollupPeriod period ) const noexcept -> PeriodRollup const&
+{
+  return period == RollupPeriod::kWeek ? mWeeklyRollup : mMonthlyRollup;
+}
+
+auto Account::amountStats() const noexcept -> AmountStats const&
+{
+  return mAmountStats;
+}
+
+auto Account::largestBetween( AmountDirection direction, std::size_t count, TimeStamp begin, TimeStamp end ) const
+  -> std::vector< RankedAmount >
+{
+  TopAmounts largest { direction, std::min( count, mTransactions.size() ) };
+  for ( BalanceIndex::Row const row : mBalanceIndex.rowsBetween( begin, end ) ) {
+    largest.add( { mId, mTransactions.id( row ), mTransactions.amount( row ), mTransactions.timestamp( row ) } );
+  }
+  return largest.entries();
 }
 
 void Account::logTransaction( Transaction const& transaction )
 {
-  UuidString const transactionId = transaction.transactionId();
+  BSLS_ASSERT( transaction.owningPartyId() == mId );
+  UuidString const& transactionId = transaction.transactionId();
+  auto const position             = static_cast< UuidIndex::Position >( mTransactions.size() );
+
+  prepareToLog( transactionId );
+  mTransactions.append( transaction );
+  mBalanceIndex.insert( transaction.timestamp(), transaction.amount() );
+  mWeeklyRollup.add( transaction.timestamp(), transaction.amount() );
+  mMonthlyRollup.add( transaction.timestamp(), transaction.amount() );
+  mAmountStats.add( { mId, transactionId, transaction.amount(), transaction.timestamp() } );
+  mTransactionIndex.insert( transactionId, position );
+}
+
+void Account::logTransfer( std::shared_ptr< Transfer const > const& transfer )
+{
+  BSLS_ASSERT( transfer != nullptr );
+  BSLS_ASSERT( transfer->involves( mId ) );
+  auto const position = static_cast< UuidIndex::Position >( mTransactions.size() );
 
-  try {
-    mTransactions.insert( { transactionId, transaction } );
-  } catch ( std::out_of_range& /*error*/ ) {
-    throw DuplicateUuidException( std::format( "Transaction {0} already exists.", transactionId.view() ) );
+  prepareToLog( transfer->id() );
+  mTransactions.appendTransfer( transfer, mId );
+  mBalanceIndex.insert( transfer->timestamp(), transfer->amountFor( mId ) );
+  mWeeklyRollup.add( transfer->timestamp(), transfer->amountFor( mId ) );
+  mMonthlyRollup.add( transfer->timestamp(), transfer->amountFor( mId ) );
+  mAmountStats.add( { mId, transfer->id(), transfer->amountFor( mId ), transfer->timestamp() } );
+  mTransactionIndex.insert( transfer->id(), position );
+}
+
+void Account::logSplit( std::shared_ptr< Split const > const& split )
+{
+  BSLS_ASSERT( split != nullptr );
+  BSLS_ASSERT( split->involves( mId ) );
+  auto const position = static_cast< UuidIndex::Position >( mTransactions.size() );
+
+  prepareToLog( split->id() );
+  mTransactions.appendSplit( split, mId );
+  mBalanceIndex.insert( split->timestamp(), split->amountFor( mId ) );
+  mWeeklyRollup.add( split->timestamp(), split->amountFor( mId ) );
+  mMonthlyRollup.add( split->timestamp(), split->amountFor( mId ) );
+  mAmountStats.add( { mId, split->id(), split->amountFor( mId ), split->timestamp() } );
+  mTransactionIndex.insert( split->id(), position );
+}
+
+void Account::reserve( std::size_t transactionCount )
+{
+  mTransactions.reserveForAppend( transactionCount );
+  mTransactionIndex.reserve( mTransactionIndex.size() + transactionCount );
+  mBalanceIndex.reserve( mBalanceIndex.size() + transactionCount );
+  mWeeklyRollup.reserveOnePeriod();
+  mMonthlyRollup.reserveOnePeriod();
+  mAmountStats.reserve( transactionCount );
+}
+
+void Account::rebuildRollups()
+{
+  mWeeklyRollup.clear();
+  mMonthlyRollup.clear();
+  mAmountStats.clear();
+  auto const timeStamps = mTransactions.timestamps();
+  auto const amounts    = mTransactions.amounts();
+  for ( std::size_t row = 0; row < timeStamps.size(); ++row ) {
+    mWeeklyRollup.add( timeStamps[row], amounts[row] );
+    mMonthlyRollup.add( timeStamps[row], amounts[row] );
+    mAmountStats.add(
+      { mId, mTransactions.id( static_cast< TransactionStore::Row >( row ) ), amounts[row], timeStamps[row] } );
   }
-  mBalance += mTransactions.at( transactionId ).amount();
+}
+
+void Account::setNotesPool( std::shared_ptr< NotesPool > pool )
+{
+  mTransactions.setNotesPool( std::move( pool ) );
 }
 
 void Account::deactivate()
@@ -116,6 +297,17 @@ void Account::activate()
   mIsActive = true;
 }
 
+void Account::prepareToLog( UuidString const& transactionId )
+{
+  if ( mTransactionIndex.contains( transactionId ) ) {
+    throw DuplicateUuidException( std::format( "Transaction {0} already exists.", transactionId ) );
+  }
+  // Everything grows before anything changes, and the id is indexed last, so
+  // a failure to log leaves the account as it was. Only the store may still
+  // allocate, to intern notes, and it does so before appending.
+  reserve( 1 );
+}
+
 } // namespace dbsc
 
 // -----------------------------------------------------------------------------
@@ -13,16 +13,61 @@
 //  backbone of the budgeting system. Accounts store Transactions, keeps track
 //  of balance, and stores user-defined metadata such as the account name and
 //  description.
+//
+//  Transactions are stored column-wise in the order they were logged (see
+//  dbsc_transactionstore) and located by id through a flat hash index (see
+//  dbsc_uuidindex), so `contains` and `transaction` cost one or two cache
+//  misses regardless of account size. Iteration visits transactions in
+//  logging order, which is chronological for transactions made through
+//  dbsc::AccountBook, and yields each one as a materialized Transaction value.
+//  Scans that need only some attributes should read the columns of
+//  `transactions()` directly.
+//
+//  A time-ordered index of the amounts (see dbsc_balanceindex) answers
+//  `balanceAsOf` in logarithmic time, and `transactionsBetween` in
+//  O(log n + k) for k transactions in the range. Transactions may be logged in
+//  any timestamp order; backdated ones are placed chronologically in the
+//  index. The current balance is the store's running total, kept in fixed
+//  point (see dbsc_money).
+//
+//  Each account also keeps weekly and monthly rollups of its inflows and
+//  outflows (see dbsc_periodrollup), updated in O(1) as transactions are
+//  logged, so per-period reports read them instead of the transactions.
+//  Likewise, its amount statistics (see dbsc_amountstats) keep its largest
+//  deposits and withdrawals and sketches of their distributions, and
+//  `largestBetween` selects the largest amounts of a time range with a bounded
+//  heap rather than a sort.
+//
+//  Account is allocator-aware in the BDE style: its transaction store and
+//  index draw their memory from the allocator supplied at construction, and
+//  containers of Accounts (such as dbsc::AccountBook) propagate theirs. The
+//  name and description are short and remain ordinary strings.
 
+#include <dbsc_amountstats.h>
+#include <dbsc_balanceindex.h>
+#include <dbsc_periodrollup.h>
 #include <dbsc_registerexception.h>
 #include <dbsc_sharedapi.h>
+#include <dbsc_split.h>
+#include <dbsc_topamounts.h>
 #include <dbsc_transaction.h>
+#include <dbsc_transactionstore.h>
+#include <dbsc_transfer.h>
+#include <dbsc_uuidindex.h>
 #include <dbsc_uuidstring.h>
 
 #include <bdldfp_decimal.fwd.h>
+#include <bsl_memory.h>
 
-#include <map>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace dbsc {
 
@@ -37,18 +82,125 @@ DBSC_REGISTER_EXCEPTION( InactiveAccountException, "Attempted to modify an inact
 class Account
 {
 public:
-  using const_iterator =                                          // NOLINT
-    std::map< UuidString, Transaction >::const_iterator;          // NOLINT
-  using iterator = std::map< UuidString, Transaction >::iterator; // NOLINT
+  /// Forward iterator over [TransactionId, Transaction] pairs in logging
+  /// order. The Transaction is materialized from the columns on dereference.
+  /// Transactions are immutable once logged, so there is no mutable iterator.
+  class const_iterator // NOLINT
+  {
+  public:
+    using iterator_concept = std::forward_iterator_tag;
+    using reference        = std::pair< UuidString const&, Transaction >;
+    /// See dbsc::AccountBook::BasicIterator.
+    using value_type      = reference;
+    using difference_type = std::ptrdiff_t;
+
+    const_iterator() = default;
+
+    const_iterator( Account const* account, TransactionStore::Row row )
+      : mAccount( account )
+      , mRow( row )
+    {
+    }
+
+    [[nodiscard]] auto operator*() const -> reference
+    {
+      return { mAccount->mTransactions.id( mRow ), mAccount->mTransactions.materialize( mRow, mAccount->mId ) };
+    }
+
+    auto operator++() -> const_iterator&
+    {
+      ++mRow;
+      return *this;
+    }
+
+    auto operator++( int ) -> const_iterator
+    {
+      const_iterator previous = *this;
+      ++mRow;
+      return previous;
+    }
+
+    [[nodiscard]] friend auto operator==( const_iterator const& a, const_iterator const& b ) -> bool = default;
+
+  private:
+    Account const* mAccount { nullptr };
+    TransactionStore::Row mRow { 0 };
+  };
+
+  /// Forward iterator over [TransactionId, Transaction] pairs in
+  /// chronological order; see `transactionsBetween`.
+  class ChronologicalIterator
+  {
+  public:
+    using iterator_concept = std::forward_iterator_tag;
+    using reference        = const_iterator::reference;
+    using value_type       = reference;
+    using difference_type  = std::ptrdiff_t;
+
+    /// See BalanceIndex::RowIterator.
+    ChronologicalIterator()
+      : mAccount( nullptr )
+    {
+    }
+
+    ChronologicalIterator( Account const* account, BalanceIndex::RowIterator row )
+      : mAccount( account )
+      , mRow( row )
+    {
+    }
+
+    [[nodiscard]] auto operator*() const -> reference { return *const_iterator( mAccount, *mRow ); }
+
+    auto operator++() -> ChronologicalIterator&
+    {
+      ++mRow;
+      return *this;
+    }
+
+    auto operator++( int ) -> ChronologicalIterator
+    {
+      ChronologicalIterator previous = *this;
+      ++mRow;
+      return previous;
+    }
+
+    [[nodiscard]] friend auto operator==( ChronologicalIterator const& a, ChronologicalIterator const& b ) -> bool
+    {
+      return a.mRow == b.mRow;
+    }
+
+  private:
+    Account const* mAccount;
+    BalanceIndex::RowIterator mRow;
+  };
+
+  using iterator       = const_iterator;          // NOLINT
+  using allocator_type = bsl::allocator< char >; // NOLINT
 
   [[nodiscard]] DBSC_API explicit Account( UuidString const& accountId,
                                            std::string const& name,
-                                           std::string const& description );
-  [[nodiscard]] DBSC_API explicit Account( std::string const& name, std::string const& description );
+                                           std::string const& description,
+                                           allocator_type const& allocator = allocator_type() );
+  [[nodiscard]] DBSC_API explicit Account( std::string const& name,
+                                           std::string const& description,
+                                           allocator_type const& allocator = allocator_type() );
+  DBSC_API Account( Account const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API Account( Account&& original ) noexcept;
+  DBSC_API Account( Account&& original, allocator_type const& allocator );
+  DBSC_API auto operator=( Account const& rhs ) -> Account&;
+  DBSC_API auto operator=( Account&& rhs ) -> Account&;
 
   // Accessors
 
   [[nodiscard]] DBSC_API auto balance() const -> BloombergLP::bdldfp::Decimal64;
+  /// @return the balance including every transaction with a timestamp at or
+  /// before @p timeStamp.
+  [[nodiscard]] DBSC_API auto balanceAsOf( TimeStamp timeStamp ) const -> BloombergLP::bdldfp::Decimal64;
+  /// @return the transactions with a timestamp in [@p begin, @p end), in
+  /// chronological order (logging order among equal timestamps). The range
+  /// is lazy and valid until the next transaction is logged.
+  [[nodiscard]] DBSC_API auto transactionsBetween( TimeStamp begin, TimeStamp end ) const
+    -> std::ranges::subrange< ChronologicalIterator >;
   [[nodiscard]] DBSC_API auto description() const -> std::string const&;
   [[nodiscard]] DBSC_API auto id() const -> UuidString const&;
   [[nodiscard]] DBSC_API auto name() const -> std::string const&;
@@ -59,14 +211,41 @@ public:
   [[nodiscard]] DBSC_API auto end() -> iterator;
   [[nodiscard]] DBSC_API auto end() const -> const_iterator;
   [[nodiscard]] DBSC_API auto cend() const noexcept -> const_iterator;
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
 
   /// Query if this account has a transaction with the provided Id.
   [[nodiscard]] DBSC_API auto contains( UuidString const& transactionId ) const -> bool;
+  /// Query by the textual form of the id without constructing a UuidString.
+  [[nodiscard]] DBSC_API auto contains( std::string_view transactionId ) const -> bool;
 
   /// Retrieve the transaction data associated with the input transactionID.
-  /// Propagates the @c std::out_of_range error if the transaction doesn't exist
-  /// for the account.
-  [[nodiscard]] DBSC_API auto transaction( UuidString const& transactionId ) const -> Transaction const&;
+  /// Throws @c std::out_of_range if the transaction doesn't exist for the
+  /// account.
+  [[nodiscard]] DBSC_API auto transaction( UuidString const& transactionId ) const -> Transaction;
+  [[nodiscard]] DBSC_API auto transaction( std::string_view transactionId ) const -> Transaction;
+
+  /// @return the row of `transactions()` holding @p transactionId, if any.
+  [[nodiscard]] DBSC_API auto rowOf( UuidString const& transactionId ) const -> std::optional< TransactionStore::Row >;
+
+  /// The columnar store of this account's transactions, in logging order.
+  [[nodiscard]] DBSC_API auto transactions() const noexcept -> TransactionStore const&;
+  /// The chronological index of the store's rows and their running balances.
+  [[nodiscard]] DBSC_API auto balances() const noexcept -> BalanceIndex const&;
+
+  /// The totals of this account's transactions per @p period.
+  [[nodiscard]] DBSC_API auto rollup( RollupPeriod period ) const noexcept -> PeriodRollup const&;
+
+  /// The largest amounts and the amount distributions of this account's
+  /// transactions.
+  [[nodiscard]] DBSC_API auto amountStats() const noexcept -> AmountStats const&;
+
+  /// @return the @p count largest amounts of @p direction among the
+  /// transactions with a timestamp in [@p begin, @p end), largest first. Costs
+  /// O(log n + k log count) for k transactions in the range.
+  [[nodiscard]] DBSC_API auto largestBetween( AmountDirection direction,
+                                              std::size_t count,
+                                              TimeStamp begin,
+                                              TimeStamp end ) const -> std::vector< RankedAmount >;
 
   /// Queries if the account is open for making new transactions.
   [[nodiscard]] DBSC_API auto isActive() const -> bool;
@@ -74,11 +253,37 @@ public:
   // Manipulators
 
   /// Store the provided transaction into the account's store.
+  /// The transaction's owning party must be this account.
   /// Throws `dbsc::DuplicateUuidException` if the transaction is a duplicate.
   /// Throws `dbsc::ClosedAccountException` if the account is closed at the time
   /// this function is called.
   DBSC_API void logTransaction( Transaction const& transaction );
 
+  /// Store this account's leg of @p transfer, sharing the record with the
+  /// other party's account.
+  /// Throws `dbsc::DuplicateUuidException` if the transaction is a duplicate.
+  /// @pre `transfer` is non-null and this account is one of its parties.
+  DBSC_API void logTransfer( std::shared_ptr< Transfer const > const& transfer );
+
+  /// Store this account's leg of @p split, sharing the record with the other
+  /// accounts it involves.
+  /// Throws `dbsc::DuplicateUuidException` if the transaction is a duplicate.
+  /// @pre `split` is non-null and involves this account.
+  DBSC_API void logSplit( std::shared_ptr< Split const > const& split );
+
+  /// Ensure @p transactionCount more transactions can be logged without
+  /// allocating, provided their notes are already interned in this account's
+  /// pool and they fall in at most one week and one month the rollups do not
+  /// yet hold. Logging cannot then fail for lack of memory.
+  DBSC_API void reserve( std::size_t transactionCount );
+
+  /// Recompute the rollups and amount statistics from the transactions.
+  DBSC_API void rebuildRollups();
+
+  /// Intern this account's notes into @p pool (see
+  /// `TransactionStore::setNotesPool`).
+  DBSC_API void setNotesPool( std::shared_ptr< NotesPool > pool );
+
   /// Sets this account's status to "read-only". No further transactions can be
   /// added.
   DBSC_API void deactivate();
@@ -87,14 +292,31 @@ public:
   /// transactions.
   DBSC_API void activate();
 
-  [[nodiscard]] DBSC_API friend auto operator==( Account const& a, Account const& b ) -> bool = default;
+  /// Accounts are equal if their metadata match and they hold the same
+  /// transactions in the same order.
+  [[nodiscard]] friend auto operator==( Account const& a, Account const& b ) -> bool
+  {
+    return a.mId == b.mId && a.mName == b.mName && a.mDescription == b.mDescription && a.mIsActive == b.mIsActive
+        && a.mTransactions == b.mTransactions;
+  }
 
 private:
+  /// Throw `dbsc::DuplicateUuidException` if @p transactionId is already
+  /// logged; otherwise reserve room to log one more transaction.
+  void prepareToLog( UuidString const& transactionId );
+
   UuidString mId;
   std::string mName {};
   std::string mDescription {};
-  BloombergLP::bdldfp::Decimal64 mBalance {};
-  std::map< UuidString, Transaction > mTransactions {};
+  /// Also maintains the balance, as its total.
+  TransactionStore mTransactions;
+  /// Maps transaction ids to rows of `mTransactions`.
+  UuidIndex mTransactionIndex;
+  /// Orders the rows of `mTransactions` by timestamp.
+  BalanceIndex mBalanceIndex;
+  PeriodRollup mWeeklyRollup;
+  PeriodRollup mMonthlyRollup;
+  AmountStats mAmountStats;
   bool mIsActive { true };
 };
 
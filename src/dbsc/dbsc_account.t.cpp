@@ -1,5 +1,7 @@
 // dbsc_account.t.cpp
 #include <dbsc_account.h>
+#include <dbsc_amountstats.h>
+#include <dbsc_topamounts.h>
 #include <dbsc_transaction.h>
 #include <dbsc_uuidstring.h>
 
@@ -10,6 +12,8 @@
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 using namespace BloombergLP;
 using namespace bdldfp::DecimalLiterals;
@@ -51,9 +55,119 @@ static void testAccountAccessors()
   BSLS_ASSERT( sampleAccount().balance() == "0.0"_d64 );
 }
 
+static void testBalanceAsOf()
+{
+  dbsc::Account account { "Backdated", "" };
+  auto const now       = std::chrono::system_clock::now();
+  auto const yesterday = now - std::chrono::hours( 24 );
+  account.logTransaction(
+    { dbsc::UuidStringUtil::generate(), account.id(), dbsc::UuidString(), "50.00"_d64, now, "" } );
+  account.logTransaction(
+    { dbsc::UuidStringUtil::generate(), account.id(), dbsc::UuidString(), "-20.00"_d64, yesterday, "" } );
+
+  BSLS_ASSERT( account.balance() == "30.00"_d64 );
+  BSLS_ASSERT( account.balanceAsOf( yesterday - std::chrono::seconds( 1 ) ) == "0.00"_d64 );
+  BSLS_ASSERT( account.balanceAsOf( yesterday ) == "-20.00"_d64 );
+  BSLS_ASSERT( account.balanceAsOf( now ) == "30.00"_d64 );
+  BSLS_ASSERT( account.balances().runningBalance( 0 ) == "30.00"_d64 );
+}
+
+static void testTransactionsBetween()
+{
+  dbsc::Account account { "Statement", "" };
+  auto const october  = std::chrono::sys_days( std::chrono::year( 2025 ) / 10 / 1 );
+  auto const november = std::chrono::sys_days( std::chrono::year( 2025 ) / 11 / 1 );
+  auto const log      = [&account]( std::chrono::sys_days day, bdldfp::Decimal64 amount ) {
+    auto const transactionId = dbsc::UuidStringUtil::generate();
+    account.logTransaction( { transactionId, account.id(), dbsc::UuidString(), amount, day, "" } );
+    return transactionId;
+  };
+  auto const late = log( october + std::chrono::days( 20 ), "3.00"_d64 );
+  static_cast< void >( log( november, "4.00"_d64 ) );
+  auto const early = log( october, "1.00"_d64 );
+  static_cast< void >( log( october - std::chrono::days( 1 ), "2.00"_d64 ) );
+
+  std::vector< dbsc::UuidString > ids;
+  bdldfp::Decimal64 total {};
+  for ( auto const& [transactionId, transaction] : account.transactionsBetween( october, november ) ) {
+    ids.push_back( transactionId );
+    total += transaction.amount();
+  }
+  BSLS_ASSERT( ids == std::vector< dbsc::UuidString >( { early, late } ) );
+  BSLS_ASSERT( total == "4.00"_d64 );
+  BSLS_ASSERT( account.transactionsBetween( november, october ).empty() );
+}
+
+static void testRollups()
+{
+  dbsc::Account account { "Rollups", "" };
+  auto const october = std::chrono::sys_days( std::chrono::year( 2025 ) / 10 / 1 );
+  auto const postings = { std::pair( 2, "100.00"_d64 ), std::pair( 9, "-30.00"_d64 ), std::pair( 40, "-1.00"_d64 ) };
+  for ( auto const& [day, amount] : postings ) {
+    account.logTransaction( { dbsc::UuidStringUtil::generate(),
+                              account.id(),
+                              dbsc::UuidString(),
+                              amount,
+                              october + std::chrono::days( day ),
+                              "" } );
+  }
+  dbsc::PeriodTotals const monthly = account.rollup( dbsc::RollupPeriod::kMonth ).totals( october );
+  BSLS_ASSERT( monthly.mCount == 2 );
+  BSLS_ASSERT( monthly.net() == "70.00"_d64 );
+  BSLS_ASSERT( account.rollup( dbsc::RollupPeriod::kWeek ).size() == 3 );
+
+  auto const weekly = account.rollup( dbsc::RollupPeriod::kWeek ).buckets();
+  account.rebuildRollups();
+  BSLS_ASSERT( account.rollup( dbsc::RollupPeriod::kMonth ).totals( october ) == monthly );
+  BSLS_ASSERT( account.rollup( dbsc::RollupPeriod::kWeek ).buckets().size() == weekly.size() );
+}
+
+static void testAmountStats()
+{
+  dbsc::Account account { "Groceries", "" };
+  auto const january  = std::chrono::sys_days( std::chrono::year( 2025 ) / 1 / 1 );
+  auto const postings = { std::pair( -40, "-90.00"_d64 ), std::pair( 3, "-12.50"_d64 ), std::pair( 10, "-80.00"_d64 ),
+                          std::pair( 20, "300.00"_d64 ),  std::pair( 30, "-45.00"_d64 ) };
+  for ( auto const& [day, amount] : postings ) {
+    account.logTransaction( { dbsc::UuidStringUtil::generate(),
+                              account.id(),
+                              dbsc::UuidString(),
+                              amount,
+                              january + std::chrono::days( day ),
+                              "" } );
+  }
+
+  dbsc::AmountStats const& stats = account.amountStats();
+  BSLS_ASSERT( stats.sketch( dbsc::AmountDirection::kOutflow ).count() == 4 );
+  BSLS_ASSERT( stats.quantile( dbsc::AmountDirection::kOutflow, 0.5 ) == "45.00"_d64 );
+  BSLS_ASSERT( stats.largest( dbsc::AmountDirection::kOutflow ).entries().front().mAmount == "-90.00"_d64 );
+  BSLS_ASSERT( stats.largest( dbsc::AmountDirection::kInflow ).size() == 1 );
+
+  // This year's two largest withdrawals; the one from last year is excluded.
+  auto const nextJanuary = std::chrono::sys_days( std::chrono::year( 2026 ) / 1 / 1 );
+
+  std::vector< dbsc::RankedAmount > const largest
+    = account.largestBetween( dbsc::AmountDirection::kOutflow, 2, january, nextJanuary );
+  BSLS_ASSERT( largest.size() == 2 );
+  BSLS_ASSERT( largest[0].mAmount == "-80.00"_d64 );
+  BSLS_ASSERT( largest[1].mAmount == "-45.00"_d64 );
+  BSLS_ASSERT( largest[0].mAccountId == account.id() );
+  BSLS_ASSERT( account.transaction( largest[0].mTransactionId ).amount() == "-80.00"_d64 );
+  BSLS_ASSERT( account.largestBetween( dbsc::AmountDirection::kInflow, 10, january, nextJanuary ).size() == 1 );
+
+  auto const before = stats.largest( dbsc::AmountDirection::kOutflow ).entries();
+  account.rebuildRollups();
+  BSLS_ASSERT( account.amountStats().largest( dbsc::AmountDirection::kOutflow ).entries() == before );
+  BSLS_ASSERT( account.amountStats().sketch( dbsc::AmountDirection::kOutflow ).count() == 4 );
+}
+
 int main()
 {
   testAccountAccessors();
+  testBalanceAsOf();
+  testTransactionsBetween();
+  testRollups();
+  testAmountStats();
 
   // Test transaction retrieval
   sampleAccountMut().logTransaction( kExampleTransaction );
@@ -1,37 +1,147 @@
 // dbsc_accountbook.cpp
 #include "dbsc_accountbook.h"
 
+#include <dbsc_parallelutil.h>
+#include <dbsc_split.h>
 #include <dbsc_transaction.h>
+#include <dbsc_transfer.h>
 
 #include <bdldfp_decimal.h>
+#include <bsls_assert.h>
 
+#include <algorithm>
 #include <chrono>
 #include <format>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace dbsc {
 
-AccountBook::AccountBook( std::string const& ownerName )
+namespace {
+  /// Tags a transaction-id registry entry whose id may not be reused.
+  constexpr UuidIndex::Position kClosedTransactionIdFlag = 1U << 31;
+} // namespace
+
+AccountBook::AccountBook( std::string const& ownerName, allocator_type const& allocator )
+  : AccountBook( ownerName, std::allocate_shared< NotesPool >( allocator ), allocator )
+{
+}
+
+AccountBook::AccountBook( std::string const& ownerName,
+                          std::shared_ptr< NotesPool > notesPool,
+                          allocator_type const& allocator )
   : mOwner( ownerName )
+  , mAccounts( allocator )
+  , mAccountIndex( allocator )
+  , mAccountOrder( allocator )
+  , mTransactionIds( allocator )
+  , mNotesPool( std::move( notesPool ) )
+  , mNotesIndex( allocator )
+  , mFlows( allocator )
+{
+  BSLS_ASSERT( mNotesPool != nullptr );
+}
+
+AccountBook::AccountBook( AccountBook const& original, allocator_type const& allocator )
+  : mOwner( original.mOwner )
+  , mAccounts( original.mAccounts, allocator )
+  , mAccountIndex( original.mAccountIndex, allocator )
+  , mAccountOrder( original.mAccountOrder, allocator )
+  , mTransactionIds( original.mTransactionIds, allocator )
+  , mNotesPool( original.mNotesPool )
+  , mNotesIndex( original.mNotesIndex, allocator )
+  , mFlows( original.mFlows, allocator )
+  , mTransactionIdPolicy( original.mTransactionIdPolicy )
+{
+}
+
+AccountBook::AccountBook( AccountBook&& original )
+  : mOwner( std::move( original.mOwner ) )
+  , mAccounts( std::move( original.mAccounts ) )
+  , mAccountIndex( std::move( original.mAccountIndex ) )
+  , mAccountOrder( std::move( original.mAccountOrder ) )
+  , mTransactionIds( std::move( original.mTransactionIds ) )
+  // Shared rather than moved, so that @p original can still post.
+  , mNotesPool( original.mNotesPool )
+  , mNotesIndex( std::move( original.mNotesIndex ) )
+  , mFlows( std::move( original.mFlows ) )
+  , mTransactionIdPolicy( original.mTransactionIdPolicy )
 {
 }
 
+AccountBook::AccountBook( AccountBook&& original, allocator_type const& allocator )
+  : mOwner( std::move( original.mOwner ) )
+  , mAccounts( std::move( original.mAccounts ), allocator )
+  , mAccountIndex( std::move( original.mAccountIndex ), allocator )
+  , mAccountOrder( std::move( original.mAccountOrder ), allocator )
+  , mTransactionIds( std::move( original.mTransactionIds ), allocator )
+  , mNotesPool( original.mNotesPool )
+  , mNotesIndex( std::move( original.mNotesIndex ), allocator )
+  , mFlows( std::move( original.mFlows ), allocator )
+  , mTransactionIdPolicy( original.mTransactionIdPolicy )
+{
+}
+
+auto AccountBook::operator=( AccountBook const& rhs ) -> AccountBook& = default;
+
+auto AccountBook::operator=( AccountBook&& rhs ) -> AccountBook&
+{
+  mOwner               = std::move( rhs.mOwner );
+  mAccounts            = std::move( rhs.mAccounts );
+  mAccountIndex        = std::move( rhs.mAccountIndex );
+  mAccountOrder        = std::move( rhs.mAccountOrder );
+  mTransactionIds      = std::move( rhs.mTransactionIds );
+  mNotesPool           = rhs.mNotesPool;
+  mNotesIndex          = std::move( rhs.mNotesIndex );
+  mFlows               = std::move( rhs.mFlows );
+  mTransactionIdPolicy = rhs.mTransactionIdPolicy;
+  return *this;
+}
+
+auto AccountBook::get_allocator() const noexcept -> allocator_type
+{
+  return mAccounts.get_allocator();
+}
+
 auto AccountBook::account( UuidString const& accountId ) const -> Account const&
 {
-  try {
-    return mAccountsMap.at( accountId );
-  } catch ( std::out_of_range const& ) {
-    throw NonExistentAccountException( std::format( "Account with id {} does not exist.", accountId.view() ) );
+  return account( handle( accountId ) );
+}
+
+auto AccountBook::account( AccountHandle handle ) const -> Account const&
+{
+  if ( handle.index() >= mAccounts.size() ) {
+    throw NonExistentAccountException( std::format( "Account with handle {} does not exist.", handle.index() ) );
   }
+  return mAccounts[handle.index()];
 }
 
-auto AccountBook::accountMut( UuidString const& accountId ) -> Account&
+auto AccountBook::accountMut( AccountHandle handle ) -> Account&
 {
-  try {
-    return mAccountsMap.at( accountId );
-  } catch ( std::out_of_range const& ) {
-    throw NonExistentAccountException( std::format( "Account with id {} does not exist.", accountId.view() ) );
+  return const_cast< Account& >( std::as_const( *this ).account( handle ) );
+}
+
+auto AccountBook::handle( UuidString const& accountId ) const -> AccountHandle
+{
+  auto const position = mAccountIndex.find( accountId );
+  if ( not position.has_value() ) {
+    throw NonExistentAccountException( std::format( "Account with id {} does not exist.", accountId ) );
   }
+  return AccountHandle( *position );
+}
+
+auto AccountBook::handle( std::string_view accountId ) const -> AccountHandle
+{
+  auto const position = mAccountIndex.find( accountId );
+  if ( not position.has_value() ) {
+    throw NonExistentAccountException( std::format( "Account with id {} does not exist.", accountId ) );
+  }
+  return AccountHandle( *position );
 }
 
 auto AccountBook::owner() const -> std::string const&
@@ -41,55 +151,103 @@ auto AccountBook::owner() const -> std::string const&
 
 auto AccountBook::begin() -> iterator
 {
-  return mAccountsMap.begin();
+  return { mAccountOrder.cbegin(), &mAccounts };
 }
 
 auto AccountBook::begin() const -> const_iterator
 {
-  return mAccountsMap.begin();
+  return { mAccountOrder.cbegin(), &mAccounts };
 }
 
 auto AccountBook::cbegin() const noexcept -> const_iterator
 {
-  return mAccountsMap.cbegin();
+  return { mAccountOrder.cbegin(), &mAccounts };
 }
 
 auto AccountBook::end() -> iterator
 {
-  return mAccountsMap.end();
+  return { mAccountOrder.cend(), &mAccounts };
 }
 
 auto AccountBook::end() const -> const_iterator
 {
-  return mAccountsMap.end();
+  return { mAccountOrder.cend(), &mAccounts };
 }
 
 auto AccountBook::cend() const noexcept -> const_iterator
 {
-  return mAccountsMap.cend();
+  return { mAccountOrder.cend(), &mAccounts };
 }
 
 auto AccountBook::accountCount() const -> int
 {
-  return static_cast< int >( mAccountsMap.size() );
+  return static_cast< int >( mAccounts.size() );
+}
+
+auto AccountBook::transactionIdPolicy() const -> TransactionIdPolicy
+{
+  return mTransactionIdPolicy;
+}
+
+auto AccountBook::notesPool() const -> NotesPool const&
+{
+  return *mNotesPool;
+}
+
+auto AccountBook::notesIndex() const -> NotesIndex const&
+{
+  return mNotesIndex;
+}
+
+auto AccountBook::flows() const -> FlowGraph const&
+{
+  return mFlows;
+}
+
+auto AccountBook::amountStats() const -> AmountStats
+{
+  AmountStats stats;
+  for ( Account const& account : mAccounts ) {
+    stats.merge( account.amountStats() );
+  }
+  return stats;
+}
+
+auto AccountBook::largestBetween( AmountDirection direction, std::size_t count, TimeStamp begin, TimeStamp end ) const
+  -> std::vector< RankedAmount >
+{
+  std::size_t legCount = 0;
+  for ( Account const& account : mAccounts ) {
+    legCount += account.transactions().size();
+  }
+  TopAmounts largest { direction, std::min( count, legCount ) };
+  for ( Account const& account : mAccounts ) {
+    for ( RankedAmount const& amount : account.largestBetween( direction, count, begin, end ) ) {
+      largest.add( amount );
+    }
+  }
+  return largest.entries();
+}
+
+auto AccountBook::containsTransaction( UuidString const& transactionId ) const -> bool
+{
+  return mTransactionIds.contains( transactionId );
+}
+
+void AccountBook::setTransactionIdPolicy( TransactionIdPolicy policy )
+{
+  mTransactionIdPolicy = policy;
 }
 
 auto AccountBook::createAccount( std::string const& accountName, std::string const& accountDescription ) -> UuidString
 {
   // This function must never fail, so continously generate ids until a unique
   // one is found.
-  bool accountAdded { false };
-  UuidString accountId;
-
-  while ( not accountAdded ) {
-    Account newAccount { accountName, accountDescription };
-    if ( not mAccountsMap.contains( newAccount.id() ) ) {
-      accountId                           = newAccount.id();
-      auto const [_, insertionSuccessful] = mAccountsMap.insert( { accountId, std::move( newAccount ) } );
-      BSLS_ASSERT( insertionSuccessful );
-      accountAdded = true;
-    }
+  UuidString accountId = UuidStringUtil::generate();
+  while ( mAccountIndex.contains( accountId ) ) {
+    accountId = UuidStringUtil::generate();
   }
+  insertAccount( Account { accountId, accountName, accountDescription, get_allocator() } );
 
   return accountId;
 }
@@ -100,60 +258,354 @@ auto AccountBook::makeTransaction(
   UuidString const& firstPartyId,
   std::optional< std::reference_wrapper< UuidString const > > internalSecondPartyIdOpt ) -> UuidString
 {
+  return makeTransaction( amount,
+                          notes,
+                          handle( firstPartyId ),
+                          internalSecondPartyIdOpt ? std::optional( handle( internalSecondPartyIdOpt->get() ) )
+                                                   : std::nullopt );
+}
 
-  bool const internalSecondPartyIsPresent = internalSecondPartyIdOpt.has_value();
-  if ( not account( firstPartyId ).isActive()
-       || ( internalSecondPartyIsPresent && not account( internalSecondPartyIdOpt.value() ).isActive() ) ) {
-    throw InactiveAccountException( "Attempted to make a transaction on an inactive account." );
+auto AccountBook::makeTransaction( BloombergLP::bdldfp::Decimal64 amount,
+                                   std::string const& notes,
+                                   AccountHandle firstParty,
+                                   std::optional< AccountHandle > internalSecondPartyOpt ) -> UuidString
+{
+  TransactionRequest const request { amount, notes, firstParty, internalSecondPartyOpt };
+  return makeTransactions( { &request, 1 } ).front();
+}
+
+auto AccountBook::makeTransactions( std::span< TransactionRequest const > requests ) -> std::vector< UuidString >
+{
+  BSLS_ASSERT( requests.size() < kClosedTransactionIdFlag );
+
+  // Validate every party before modifying the book.
+  for ( TransactionRequest const& request : requests ) {
+    Account const& firstParty  = account( request.mFirstParty );
+    Account const* secondParty =
+      request.mInternalSecondPartyOpt ? &account( *request.mInternalSecondPartyOpt ) : nullptr;
+    if ( not firstParty.isActive() || ( secondParty != nullptr && not secondParty->isActive() ) ) {
+      throw InactiveAccountException( "Attempted to make a transaction on an inactive account." );
+    }
+    if ( secondParty == &firstParty ) {
+      throw std::invalid_argument( "A transfer requires two distinct parties." );
+    }
   }
 
-  auto generateId = [&firstPartyId, &internalSecondPartyIdOpt, internalSecondPartyIsPresent, this]() {
-    bool idGenerated { false };
-    UuidString generatedId;
-    while ( not idGenerated ) {
-      generatedId = UuidStringUtil::generate();
-      if ( account( firstPartyId ).contains( generatedId )
-           || ( internalSecondPartyIsPresent
-                && account( internalSecondPartyIdOpt.value() ).contains( generatedId ) ) ) {
-        // no-opt; continue loop
-      } else {
-        idGenerated = true;
-      }
+  TimeStamp const timeStamp              = std::chrono::system_clock::now();
+  std::vector< UuidString > const newIds = generateTransactionIds( requests.size(), timeStamp );
+
+  // Build the records and intern the notes, so that logging below neither
+  // allocates nor interns.
+  std::vector< Notes > notes;
+  std::vector< std::shared_ptr< Transfer const > > transfers( requests.size() );
+  notes.reserve( requests.size() );
+  for ( std::size_t i = 0; i < requests.size(); ++i ) {
+    TransactionRequest const& request = requests[i];
+    notes.emplace_back( mNotesPool, mNotesPool->intern( request.mNotes ) );
+    if ( request.mInternalSecondPartyOpt ) {
+      // One shared record; each account derives its own leg from it.
+      transfers[i] = std::allocate_shared< Transfer >( get_allocator(),
+                                                       newIds[i],
+                                                       account( request.mFirstParty ).id(),
+                                                       account( *request.mInternalSecondPartyOpt ).id(),
+                                                       request.mAmount,
+                                                       timeStamp,
+                                                       notes[i] );
     }
+  }
 
-    return generatedId;
+  // Group the legs by account so that each account's columns are appended in
+  // one run, keeping request order within an account.
+  struct Leg
+  {
+    std::uint32_t mAccount;
+    std::uint32_t mRequest;
   };
+  std::vector< Leg > legs;
+  legs.reserve( requests.size() * 2 );
+  for ( std::uint32_t i = 0; i < requests.size(); ++i ) {
+    legs.push_back( { requests[i].mFirstParty.index(), i } );
+    if ( requests[i].mInternalSecondPartyOpt ) {
+      legs.push_back( { requests[i].mInternalSecondPartyOpt->index(), i } );
+    }
+  }
+  std::ranges::stable_sort( legs, std::less(), &Leg::mAccount );
+
+  mTransactionIds.reserve( mTransactionIds.size() + requests.size() );
+  for ( auto run = legs.begin(); run != legs.end(); ) {
+    auto const runEnd = std::ranges::find_if( run, legs.end(), [run]( Leg const& leg ) {
+      return leg.mAccount != run->mAccount;
+    } );
+    mAccounts[run->mAccount].reserve( static_cast< std::size_t >( runEnd - run ) );
+    run = runEnd;
+  }
+
+  // Every id is fresh and all storage is reserved, so the postings below are
+  // all-or-nothing.
+  for ( Leg const& leg : legs ) {
+    Account& owner = mAccounts[leg.mAccount];
+    if ( auto const& transfer = transfers[leg.mRequest] ) {
+      owner.logTransfer( transfer );
+    } else {
+      owner.logTransaction(
+        { newIds[leg.mRequest], owner.id(), {}, requests[leg.mRequest].mAmount, timeStamp, notes[leg.mRequest] } );
+    }
+  }
+  // Both legs (if any) are now logged, so the ids are closed to further use.
+  for ( std::size_t i = 0; i < requests.size(); ++i ) {
+    mTransactionIds.insert( newIds[i], requests[i].mFirstParty.index() | kClosedTransactionIdFlag );
+  }
+  // Each account's new rows are indexed on its first leg; later legs find
+  // nothing left to do. Indexing allocates and may throw after the postings;
+  // the indexes then add the rows they missed on the account's next update.
+  for ( Leg const& leg : legs ) {
+    mNotesIndex.update( AccountHandle( leg.mAccount ), mAccounts[leg.mAccount].transactions() );
+    mFlows.update( AccountHandle( leg.mAccount ), mAccounts[leg.mAccount].transactions() );
+  }
+  return newIds;
+}
 
-  UuidString const transactionId = generateId();
-  TimeStamp const timeStamp      = std::chrono::system_clock::now();
-  UuidString const secondPartyId = internalSecondPartyIdOpt ? *internalSecondPartyIdOpt : UuidString();
+auto AccountBook::makeSplitTransaction( BloombergLP::bdldfp::Decimal64 amount,
+                                        std::string const& notes,
+                                        std::span< SplitAllocation const > allocations ) -> UuidString
+{
+  std::vector< SplitLeg > legs;
+  legs.reserve( allocations.size() );
+  for ( SplitAllocation const& allocation : allocations ) {
+    Account const& party = account( allocation.mAccount );
+    if ( not party.isActive() ) {
+      throw InactiveAccountException( "Attempted to make a transaction on an inactive account." );
+    }
+    legs.push_back( { party.id(), allocation.mAmount } );
+  }
 
-  accountMut( firstPartyId ).logTransaction( { transactionId, firstPartyId, secondPartyId, amount, timeStamp, notes } );
-  if ( internalSecondPartyIsPresent ) {
-    accountMut( internalSecondPartyIdOpt.value() )
-      .logTransaction( { transactionId, internalSecondPartyIdOpt.value(), firstPartyId, -amount, timeStamp, notes } );
+  TimeStamp const timeStamp = std::chrono::system_clock::now();
+  UuidString const splitId  = generateTransactionIds( 1, timeStamp ).front();
+  // The record validates the legs; every account shares it.
+  auto const split = std::allocate_shared< Split >(
+    get_allocator(), splitId, amount, timeStamp, Notes( mNotesPool, mNotesPool->intern( notes ) ), legs );
+
+  mTransactionIds.reserve( mTransactionIds.size() + 1 );
+  for ( SplitAllocation const& allocation : allocations ) {
+    mAccounts[allocation.mAccount.index()].reserve( 1 );
+  }
+
+  // The id is fresh, the accounts distinct and all storage reserved, so the
+  // postings below are all-or-nothing.
+  for ( SplitAllocation const& allocation : allocations ) {
+    mAccounts[allocation.mAccount.index()].logSplit( split );
+  }
+  mTransactionIds.insert( splitId, allocations.front().mAccount.index() | kClosedTransactionIdFlag );
+  // Indexing allocates and may throw after the postings; the indexes then add
+  // the rows they missed on each account's next update.
+  for ( SplitAllocation const& allocation : allocations ) {
+    mNotesIndex.update( allocation.mAccount, mAccounts[allocation.mAccount.index()].transactions() );
+    mFlows.update( allocation.mAccount, mAccounts[allocation.mAccount.index()].transactions() );
   }
-  return transactionId;
+  return splitId;
+}
+
+auto AccountBook::generateTransactionIds( std::size_t count, TimeStamp timeStamp ) const -> std::vector< UuidString >
+{
+  auto generateId = [timeStamp, this]() {
+    return mTransactionIdPolicy == TransactionIdPolicy::kTimeOrdered ? UuidStringUtil::generateTimeOrdered( timeStamp )
+                                                                     : UuidStringUtil::generate();
+  };
+
+  std::vector< UuidString > ids( count );
+  if ( mTransactionIdPolicy == TransactionIdPolicy::kTimeOrdered ) {
+    std::ranges::generate( ids, generateId );
+  } else {
+    UuidStringUtil::generateBatch( ids );
+  }
+
+  // Replace any id that is already in the book or repeated within the batch.
+  UuidIndex batchIds;
+  batchIds.reserve( count );
+  for ( std::uint32_t i = 0; i < count; ++i ) {
+    while ( mTransactionIds.contains( ids[i] ) || not batchIds.insert( ids[i], i ) ) {
+      ids[i] = generateId();
+    }
+  }
+  return ids;
 }
 
 void AccountBook::deactivate( UuidString const& accountId )
 {
-  accountMut( accountId ).deactivate();
+  deactivate( handle( accountId ) );
+}
+
+void AccountBook::deactivate( AccountHandle handle )
+{
+  accountMut( handle ).deactivate();
 }
 
 void AccountBook::activate( UuidString const& accountId )
 {
-  accountMut( accountId ).activate();
+  activate( handle( accountId ) );
+}
+
+void AccountBook::activate( AccountHandle handle )
+{
+  accountMut( handle ).activate();
+}
+
+void AccountBook::rebuildRollups( unsigned threadCount )
+{
+  ParallelUtil::forEachTask( mAccounts.size(),
+                             ParallelUtil::threadCountFor( threadCount, mAccounts.size() ),
+                             [this]( std::size_t i, unsigned ) { mAccounts[i].rebuildRollups(); } );
+}
+
+void AccountBook::migrateToTimeOrderedTransactionIds()
+{
+  // Both legs of a transfer share an id, so the replacement must be decided
+  // once per original id rather than once per Transaction object.
+  std::map< UuidString, UuidString > replacementIds;
+  for ( auto const& account : mAccounts ) {
+    for ( auto const& [transactionId, transaction] : account ) {
+      if ( UuidStringUtil::version( transactionId ) == 7 || replacementIds.contains( transactionId ) ) {
+        continue;
+      }
+      replacementIds.insert( { transactionId, UuidStringUtil::generateTimeOrdered( transaction.timestamp() ) } );
+    }
+  }
+
+  // Re-keyed transfer and split records, so all legs keep sharing one record.
+  std::map< UuidString, std::shared_ptr< Transfer const > > migratedTransfers;
+  std::map< UuidString, std::shared_ptr< Split const > > migratedSplits;
+  for ( auto& account : mAccounts ) {
+    Account migrated { account.id(), account.name(), account.description(), get_allocator() };
+    migrated.setNotesPool( mNotesPool );
+    TransactionStore const& store = account.transactions();
+    for ( TransactionStore::Row row = 0; row < store.size(); ++row ) {
+      auto const replacement = replacementIds.find( store.id( row ) );
+      UuidString const& newId = replacement == replacementIds.end() ? store.id( row ) : replacement->second;
+      if ( auto const& transfer = store.transfer( row ) ) {
+        auto [position, inserted] = migratedTransfers.try_emplace( newId, transfer );
+        if ( inserted && newId != transfer->id() ) {
+          position->second = std::allocate_shared< Transfer >( get_allocator(),
+                                                               newId,
+                                                               transfer->sourceId(),
+                                                               transfer->destinationId(),
+                                                               transfer->sourceAmount(),
+                                                               transfer->timestamp(),
+                                                               transfer->sharedNotes() );
+        }
+        migrated.logTransfer( position->second );
+      } else if ( auto const& split = store.split( row ) ) {
+        auto [position, inserted] = migratedSplits.try_emplace( newId, split );
+        if ( inserted && newId != split->id() ) {
+          position->second = std::allocate_shared< Split >(
+            get_allocator(), newId, split->amount(), split->timestamp(), split->sharedNotes(), split->legs() );
+        }
+        migrated.logSplit( position->second );
+      } else {
+        Transaction const transaction = store.materialize( row, account.id() );
+        migrated.logTransaction( { newId,
+                                   transaction.owningPartyId(),
+                                   transaction.otherPartyId(),
+                                   transaction.amount(),
+                                   transaction.timestamp(),
+                                   transaction.sharedNotes() } );
+      }
+    }
+    if ( not account.isActive() ) {
+      migrated.deactivate();
+    }
+    account = std::move( migrated );
+  }
+
+  // Rows keep their positions, notes and parties, so the notes index and the
+  // flow graph are unaffected.
+  mTransactionIds.clear();
+  for ( std::uint32_t index = 0; index < mAccounts.size(); ++index ) {
+    registerTransactionIds( AccountHandle( index ) );
+  }
+
+  mTransactionIdPolicy = TransactionIdPolicy::kTimeOrdered;
 }
 
 void AccountBook::addParsedAccount( Account account )
 {
-  auto const accountId = account.id();
-  try {
-    mAccountsMap.insert( { accountId, std::move( account ) } );
-  } catch ( std::out_of_range const& ) {
-    throw DuplicateUuidException( std::format(
-      "Account with id {} already exists with name '{}'.", accountId.view(), this->account( accountId ).name() ) );
+  if ( auto const existing = mAccountIndex.find( account.id() ) ) {
+    throw DuplicateUuidException( std::format( "Account with id {} already exists with name '{}'.",
+                                               account.id(),
+                                               this->account( AccountHandle( *existing ) ).name() ) );
+  }
+
+  // Validate every id before modifying the book.
+  AccountHandle const prospectiveHandle { static_cast< std::uint32_t >( mAccounts.size() ) };
+  TransactionStore const& store = account.transactions();
+  for ( TransactionStore::Row row = 0; row < store.size(); ++row ) {
+    static_cast< void >( transactionIdEntry( store, row, prospectiveHandle ) );
+  }
+
+  mTransactionIds.reserve( mTransactionIds.size() + static_cast< std::size_t >( account.transactionCount() ) );
+  AccountHandle const handle = insertAccount( std::move( account ) );
+  registerTransactionIds( handle );
+  mNotesIndex.update( handle, mAccounts[handle.index()].transactions() );
+  mFlows.update( handle, mAccounts[handle.index()].transactions() );
+}
+
+auto AccountBook::insertAccount( Account account ) -> AccountHandle
+{
+  // Handles share registry entries with @c kClosedTransactionIdFlag.
+  BSLS_ASSERT( mAccounts.size() < kClosedTransactionIdFlag );
+  AccountHandle const handle { static_cast< std::uint32_t >( mAccounts.size() ) };
+  account.setNotesPool( mNotesPool );
+  bool const insertionSuccessful = mAccountIndex.insert( account.id(), handle.index() );
+  BSLS_ASSERT( insertionSuccessful );
+
+  auto const orderPosition = std::ranges::upper_bound(
+    mAccountOrder, account.id(), std::less(), [this]( AccountHandle other ) { return mAccounts[other.index()].id(); } );
+  mAccountOrder.insert( orderPosition, handle );
+  mAccounts.push_back( std::move( account ) );
+  return handle;
+}
+
+auto AccountBook::transactionIdEntry( TransactionStore const& store,
+                                      TransactionStore::Row row,
+                                      AccountHandle owner ) const -> UuidIndex::Position
+{
+  UuidString const& transactionId = store.id( row );
+  auto const& split               = store.split( row );
+  bool const isTransfer           = not UuidStringUtil::isNil( store.counterpartyId( row ) );
+  auto const existing             = mTransactionIds.find( transactionId );
+  if ( not existing.has_value() ) {
+    return isTransfer ? owner.index() : owner.index() | kClosedTransactionIdFlag;
+  }
+
+  std::uint32_t const firstOwnerIndex = *existing & ~kClosedTransactionIdFlag;
+  Account const& firstOwner           = mAccounts[firstOwnerIndex];
+  bool isLaterLeg                     = false;
+  if ( split != nullptr ) {
+    // The id is acceptable as another leg of the split the first owner holds.
+    auto const firstRow = firstOwner.rowOf( transactionId );
+    auto const& firstSplit =
+      firstRow.has_value() ? firstOwner.transactions().split( *firstRow ) : std::shared_ptr< Split const >();
+    isLaterLeg = firstOwnerIndex != owner.index() && firstSplit != nullptr && *firstSplit == *split;
+  } else {
+    // The id is acceptable only as the second leg of an open transfer whose
+    // first leg names this transaction's owner as its counterparty.
+    isLaterLeg = isTransfer && ( *existing & kClosedTransactionIdFlag ) == 0 && firstOwnerIndex != owner.index()
+              && firstOwner.id() == store.counterpartyId( row );
+  }
+  if ( not isLaterLeg ) {
+    throw DuplicateUuidException(
+      std::format( "Transaction {} already exists in account {}.", transactionId, firstOwner.id() ) );
+  }
+  return firstOwnerIndex | kClosedTransactionIdFlag;
+}
+
+void AccountBook::registerTransactionIds( AccountHandle owner )
+{
+  TransactionStore const& store = account( owner ).transactions();
+  for ( TransactionStore::Row row = 0; row < store.size(); ++row ) {
+    auto const entry = transactionIdEntry( store, row, owner );
+    if ( not mTransactionIds.insert( store.id( row ), entry ) ) {
+      mTransactionIds.update( store.id( row ), entry );
+    }
   }
 }
 
@@ -8,20 +8,109 @@
 //  dbsc::AccountBook: a collection of multiple dbsc::Accounts.
 //  dbsc::NonExistingAccountException: an error that signals that the queried
 //  account does not exist.
+//  dbsc::TransactionIdPolicy: selects how new transaction ids are minted.
 //
 //@DESCRIPTION: This component defines a collection of accounts. The primary
 //  purpose is to allow iteration over a single user's accounts.
+//
+//  Transaction ids are random (UUIDv4) by default. Under
+//  `TransactionIdPolicy::kTimeOrdered`, new ids are UUIDv7 values derived from
+//  the transaction's timestamp, so the ids sort by creation time. An Account
+//  still stores its transactions in logging order; walk them chronologically
+//  with `BookViewUtil::transactionsInTimeOrderOf` or the account's
+//  dbsc::BalanceIndex. Existing books can be converted with
+//  `AccountBook::migrateToTimeOrderedTransactionIds`.
+//
+//  Accounts are stored contiguously in creation order. Each one can be
+//  addressed either by its persistent UuidString or by an AccountHandle, the
+//  account's position in that storage. Ids are resolved through a flat hash
+//  index (see dbsc_uuidindex); handle-based overloads skip that lookup
+//  entirely, which matters when posting many transactions against the same
+//  few accounts. Iteration order (ascending id) is kept in a separate list of
+//  handles.
+//
+//  The book also keeps a registry of every transaction id it holds, so
+//  uniqueness of new ids, and of ids read from storage, is checked book-wide
+//  in constant time. An id may appear in more than one account only as the
+//  two legs of one internal transfer, or as the legs of one split.
+//
+//  `makeTransactions` posts a batch of transactions at once: every party is
+//  validated and every id minted before the book is modified, the storage
+//  each account needs is reserved up front, and the legs are then appended
+//  account by account. The batch is applied completely or not at all.
+//  `makeTransaction` is a batch of one.
+//
+//  `makeSplitTransaction` divides one external amount among several accounts
+//  as a single dbsc::Split record, posted to every account it involves or to
+//  none.
+//
+//  The book keeps a dbsc::NotesIndex of the words in its notes, updated as
+//  transactions are posted or accounts added, so `notesIndex().findPhrase(
+//  "costco" )` finds every transaction mentioning Costco without a scan.
+//  Postings name accounts by AccountHandle.
+//
+//  It likewise keeps a dbsc::FlowGraph of who pays whom: `flows().netFlow(
+//  groceries, savingsId, october, november )` is the net amount the groceries
+//  account received from savings in October, found in logarithmic time.
+//
+//  Every account maintains weekly and monthly rollups as it logs transactions
+//  (see dbsc_periodrollup), and its amount statistics (see dbsc_amountstats).
+//  `rebuildRollups` recomputes both for the whole book in parallel. The
+//  statistics of the accounts merge into those of the book: `amountStats`
+//  and `largestBetween` answer for every account at once without sorting any.
+//
+//  AccountBook is allocator-aware in the BDE style. Its accounts, their
+//  transaction columns and indices, the notes pool, and the transfer and split
+//  records it creates are all obtained from the allocator supplied at construction.
+//  A book can thus live entirely in a `bdlma::SequentialAllocator` or a
+//  multipool: it is built from a few large allocations, and once the book is
+//  destroyed its memory can be released in one step. Transient values, such
+//  as materialized Transactions, use the default allocator.
+//
+/// Usage
+/// -----
+/// Example 1: Loading a book into an arena
+///
+/// ```cpp
+/// BloombergLP::bdlma::SequentialAllocator arena;
+/// {
+///     dbsc::AccountBook book = dbsc::readAccountBook< dbsc::TomlSerializer >( path, &arena );
+///     use(book);
+/// }
+/// arena.release();
+/// ```
 
 #include <dbsc_account.h>
+#include <dbsc_accounthandle.h>
+#include <dbsc_amountstats.h>
+#include <dbsc_flowgraph.h>
+#include <dbsc_notesindex.h>
+#include <dbsc_notespool.h>
 #include <dbsc_registerexception.h>
 #include <dbsc_sharedapi.h>
+#include <dbsc_split.h>
+#include <dbsc_topamounts.h>
+#include <dbsc_transaction.h>
+#include <dbsc_uuidindex.h>
 #include <dbsc_uuidstring.h>
 
-#include <bdldfp_decimal.fwd.h>
+#include <bdldfp_decimal.h>
+#include <bsl_deque.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <map>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace dbsc {
 
@@ -30,25 +119,143 @@ class Account;
 
 DBSC_REGISTER_EXCEPTION( NonExistentAccountException, "" );
 
+/// How AccountBook mints ids for new transactions.
+enum class TransactionIdPolicy
+{
+  /// UUIDv4; ids carry no ordering information.
+  kRandom,
+  /// UUIDv7; id order matches timestamp order.
+  kTimeOrdered,
+};
+
+/// One transaction to be posted by `AccountBook::makeTransactions`. The
+/// fields have the meaning of the corresponding `makeTransaction` arguments.
+struct TransactionRequest
+{
+  BloombergLP::bdldfp::Decimal64 mAmount;
+  /// Only read during the call; the book keeps its own copy.
+  std::string_view mNotes;
+  AccountHandle mFirstParty;
+  std::optional< AccountHandle > mInternalSecondPartyOpt {};
+};
+
+/// One account's share of a split posted by `AccountBook::makeSplitTransaction`.
+struct SplitAllocation
+{
+  AccountHandle mAccount;
+  BloombergLP::bdldfp::Decimal64 mAmount;
+};
+
 /// A collection of Accounts for a given user. This class allows for iteration
-/// over its Accounts by way of key-value pairs [AccountId, Account]. It is
-/// also responsible for recording transactions and can open new accounts as
-/// well as toggle the status of an existing status (active/closed).
+/// over its Accounts by way of key-value pairs [AccountId, Account] in
+/// ascending id order. It is also responsible for recording transactions and
+/// can open new accounts as well as toggle the status of an existing status
+/// (active/closed).
 class AccountBook
-
 {
+  using AccountOrder   = bsl::vector< AccountHandle >;
+  using AccountStorage = bsl::deque< Account >;
+
+  /// Forward iterator over [AccountId, Account] pairs. Dereferencing yields a
+  /// pair of references, so structured bindings work as they would for a map.
+  template< typename AccountType >
+  class BasicIterator
+  {
+    using StorageType = std::conditional_t< std::is_const_v< AccountType >, AccountStorage const, AccountStorage >;
+
+  public:
+    using iterator_concept = std::forward_iterator_tag;
+    using reference        = std::pair< UuidString const&, AccountType& >;
+    /// The proxy doubles as the value type; this keeps the iterator a valid
+    /// `std::forward_iterator` without relying on `std::pair`'s C++23
+    /// common_reference support.
+    using value_type      = reference;
+    using difference_type = std::ptrdiff_t;
+
+    BasicIterator() = default;
+
+    BasicIterator( AccountOrder::const_iterator position, StorageType* storage )
+      : mPosition( position )
+      , mStorage( storage )
+    {
+    }
+
+    /// Allow iterator -> const_iterator conversion.
+    template< typename OtherAccountType >
+      requires( std::is_const_v< AccountType > && not std::is_const_v< OtherAccountType > )
+    BasicIterator( BasicIterator< OtherAccountType > const& other )
+      : mPosition( other.mPosition )
+      , mStorage( other.mStorage )
+    {
+    }
+
+    [[nodiscard]] auto operator*() const -> reference
+    {
+      AccountType& account = ( *mStorage )[mPosition->index()];
+      return { account.id(), account };
+    }
+
+    auto operator++() -> BasicIterator&
+    {
+      ++mPosition;
+      return *this;
+    }
+
+    auto operator++( int ) -> BasicIterator
+    {
+      BasicIterator previous = *this;
+      ++mPosition;
+      return previous;
+    }
+
+    [[nodiscard]] friend auto operator==( BasicIterator const& a, BasicIterator const& b ) -> bool
+    {
+      return a.mPosition == b.mPosition;
+    }
+
+  private:
+    template< typename >
+    friend class BasicIterator;
+
+    AccountOrder::const_iterator mPosition {};
+    StorageType* mStorage { nullptr };
+  };
+
 public:
-  using const_iterator =                                      // NOLINT
-    std::map< UuidString, Account >::const_iterator;          // NOLINT
-  using iterator = std::map< UuidString, Account >::iterator; // NOLINT
+  using const_iterator = BasicIterator< Account const >; // NOLINT
+  using iterator       = BasicIterator< Account >;       // NOLINT
+  using allocator_type = bsl::allocator< char >;         // NOLINT
 
-  DBSC_API AccountBook( std::string const& ownerName );
+  DBSC_API AccountBook( std::string const& ownerName, allocator_type const& allocator = allocator_type() );
+  /// Intern the notes of the book in @p notesPool, which may be shared with
+  /// other books (see dbsc_bookset).
+  /// @pre `notesPool != nullptr`
+  DBSC_API AccountBook( std::string const& ownerName,
+                        std::shared_ptr< NotesPool > notesPool,
+                        allocator_type const& allocator = allocator_type() );
+  /// The copy shares the notes pool and transfer records of @p original, so
+  /// the allocator of @p original must outlive it.
+  DBSC_API AccountBook( AccountBook const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API AccountBook( AccountBook&& original );
+  DBSC_API AccountBook( AccountBook&& original, allocator_type const& allocator );
+  DBSC_API auto operator=( AccountBook const& rhs ) -> AccountBook&;
+  DBSC_API auto operator=( AccountBook&& rhs ) -> AccountBook&;
 
   // Accessors
 
   /// @return the account referred to by the identifier string.
   /// @throw @c dbsc::NonExistentAccount if the account does not exist.
   [[nodiscard]] DBSC_API auto account( UuidString const& accountId ) const -> Account const&;
+  /// @return the account referred to by the handle.
+  /// @throw @c dbsc::NonExistentAccount if the handle was not issued by this
+  /// book.
+  [[nodiscard]] DBSC_API auto account( AccountHandle handle ) const -> Account const&;
+
+  /// @return the handle of the account with the provided id.
+  /// @throw @c dbsc::NonExistentAccount if the account does not exist.
+  [[nodiscard]] DBSC_API auto handle( UuidString const& accountId ) const -> AccountHandle;
+  /// Resolve the textual form of an id without constructing a UuidString.
+  [[nodiscard]] DBSC_API auto handle( std::string_view accountId ) const -> AccountHandle;
 
   [[nodiscard]] DBSC_API auto owner() const -> std::string const&;
 
@@ -60,10 +267,53 @@ public:
   [[nodiscard]] DBSC_API auto cend() const noexcept -> const_iterator;
 
   [[nodiscard]] DBSC_API auto accountCount() const -> int;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+  [[nodiscard]] DBSC_API auto transactionIdPolicy() const -> TransactionIdPolicy;
+
+  /// The pool holding the notes of every account in the book; see
+  /// `NotesPool::stats()` for deduplication figures.
+  [[nodiscard]] DBSC_API auto notesPool() const -> NotesPool const&;
+
+  /// The word index of the notes of every transaction in the book.
+  [[nodiscard]] DBSC_API auto notesIndex() const -> NotesIndex const&;
+
+  /// @return the totals of the transactions between each account and each
+  /// other party.
+  [[nodiscard]] DBSC_API auto flows() const -> FlowGraph const&;
+
+  /// @return the merge of the amount statistics of every account (see
+  /// `Account::amountStats`).
+  [[nodiscard]] DBSC_API auto amountStats() const -> AmountStats;
+
+  /// @return the @p count largest amounts of @p direction among the
+  /// transactions of every account with a timestamp in [@p begin, @p end),
+  /// largest first (see `Account::largestBetween`). A transfer between two
+  /// accounts of the book counts once in each direction.
+  [[nodiscard]] DBSC_API auto largestBetween( AmountDirection direction,
+                                              std::size_t count,
+                                              TimeStamp begin,
+                                              TimeStamp end ) const -> std::vector< RankedAmount >;
+
+  /// Query if any account in the book holds a transaction with this id.
+  [[nodiscard]] DBSC_API auto containsTransaction( UuidString const& transactionId ) const -> bool;
+
   // Manipulators
 
+  /// Select how ids are minted for transactions made from now on. Existing
+  /// transactions keep their ids.
+  DBSC_API void setTransactionIdPolicy( TransactionIdPolicy policy );
+
+  /// Re-key every transaction that does not already have a time-ordered id
+  /// with a UUIDv7 derived from its timestamp, and switch the book to
+  /// `TransactionIdPolicy::kTimeOrdered`. Both legs of an internal transfer
+  /// receive the same new id, so `Transaction::isPair` continues to hold.
+  /// Balances, timestamps, and account states are unchanged.
+  DBSC_API void migrateToTimeOrderedTransactionIds();
+
   /// Create a new account based on the provided information, returning the
-  /// account's Id.
+  /// account's Id. Use `handle()` to obtain the account's AccountHandle.
   DBSC_API auto createAccount( std::string const& accountName, std::string const& description ) -> UuidString;
 
   /// @brief Record the transaction for the provided accountId and amounts.
@@ -77,8 +327,9 @@ public:
   ///
   /// To represent a deposit into @p firstPartyId, @p amount should be positive.
   /// Negative values represent withdrawals. If @p internalSecondPartyIdOpt is non-null, both
-  /// accounts will share the same TimeStamp and transaction Id for their
-  /// respective copies.
+  /// accounts share a single dbsc::Transfer record, from which each derives
+  /// its own leg. A transfer from an account to itself throws
+  /// @c std::invalid_argument.
   ///
   /// @return the transaction id
   DBSC_API auto makeTransaction( BloombergLP::bdldfp::Decimal64 amount,
@@ -87,20 +338,99 @@ public:
                                  std::optional< std::reference_wrapper< UuidString const > > internalSecondPartyIdOpt )
     -> UuidString;
 
+  /// Handle-based equivalent of the overload above.
+  DBSC_API auto makeTransaction( BloombergLP::bdldfp::Decimal64 amount,
+                                 std::string const& transactionNotes,
+                                 AccountHandle firstParty,
+                                 std::optional< AccountHandle > internalSecondPartyOpt ) -> UuidString;
+
+  /// Post every request in @p requests, all with the same timestamp, and
+  /// @return their transaction ids in request order. Within each account,
+  /// transactions are logged in request order.
+  ///
+  /// The whole batch is validated before the book is modified, with the same
+  /// exceptions as `makeTransaction`; if any request is invalid, or memory
+  /// runs out while posting, nothing is posted. Should memory run out later,
+  /// while the notes index or flow graph is updated, the batch stays posted
+  /// and those indexes add its rows on the account's next posting.
+  DBSC_API auto makeTransactions( std::span< TransactionRequest const > requests ) -> std::vector< UuidString >;
+
+  /// @brief Record @p amount, received from or paid to an external party, as
+  /// divided among the accounts of @p allocations.
+  ///
+  /// Every account logs its share of one shared dbsc::Split record, under one
+  /// id and timestamp. Positive shares are deposits, negative ones
+  /// withdrawals. Throws @c dbsc::NonExistentAccountException or
+  /// @c dbsc::InactiveAccountException as `makeTransaction` does, and
+  /// @c std::invalid_argument if @p allocations is empty, names an account
+  /// twice, or does not sum to @p amount. Nothing is posted if an exception
+  /// is thrown while posting; one thrown later, while the notes index or flow
+  /// graph is updated, leaves the split posted, as for `makeTransactions`.
+  ///
+  /// @return the transaction id
+  DBSC_API auto makeSplitTransaction( BloombergLP::bdldfp::Decimal64 amount,
+                                      std::string const& transactionNotes,
+                                      std::span< SplitAllocation const > allocations ) -> UuidString;
+
+  /// Recompute the rollups and amount statistics of every account (see
+  /// `Account::rebuildRollups`)
+  /// using @p threadCount threads (0 selects one per hardware thread). The
+  /// accounts are independent, so they are divided among the threads.
+  DBSC_API void rebuildRollups( unsigned threadCount = 0 );
+
   /// Modify the writability of a given account.
   /// @throw @c dbsc::NonExistentAccount if account does not exist.
   DBSC_API void deactivate( UuidString const& accountId );
+  DBSC_API void deactivate( AccountHandle handle );
   DBSC_API void activate( UuidString const& accountId );
+  DBSC_API void activate( AccountHandle handle );
 
   /// Insert the account into the collection.
+  /// @throw @c dbsc::DuplicateUuidException if an account with the same id
+  /// already exists, or if one of its transaction ids is already in the book
+  /// and is not the counterpart leg of an internal transfer or another leg of
+  /// the same split. The book is
+  /// unchanged if an exception is thrown.
   /// @note This function is intended for de-serialization purposes.
   DBSC_API void addParsedAccount( Account account );
 
 private:
-  DBSC_API auto accountMut( UuidString const& accountId ) -> Account&;
+  DBSC_API auto accountMut( AccountHandle handle ) -> Account&;
+  /// Append @p account to the storage and index it. Assumes the id is unique.
+  DBSC_API auto insertAccount( Account account ) -> AccountHandle;
+  /// @return the registry entry the transaction at @p row of @p store would
+  /// have once logged to @p owner.
+  /// @throw @c dbsc::DuplicateUuidException if the id conflicts with the
+  /// registry.
+  DBSC_API auto transactionIdEntry( TransactionStore const& store,
+                                    TransactionStore::Row row,
+                                    AccountHandle owner ) const -> UuidIndex::Position;
+  /// Record every transaction of @p owner in the registry.
+  DBSC_API void registerTransactionIds( AccountHandle owner );
+  /// @return @p count distinct transaction ids, minted under the current
+  /// policy for @p timeStamp, none of which is in the book.
+  DBSC_API auto generateTransactionIds( std::size_t count, TimeStamp timeStamp ) const -> std::vector< UuidString >;
 
   std::string mOwner {};
-  std::map< UuidString, Account > mAccountsMap {};
+  /// Deque rather than vector so that references returned by `account()`
+  /// survive later insertions.
+  AccountStorage mAccounts;
+  /// Maps account ids to handles.
+  UuidIndex mAccountIndex;
+  /// Handles sorted by account id; defines iteration order.
+  AccountOrder mAccountOrder;
+  /// Maps every transaction id in the book to the handle of the first
+  /// account that logged it. The handle is tagged once no further transfer leg
+  /// may use the id (external transactions and splits, or transfers with both
+  /// legs present). Further legs of a split are recognized by their record.
+  UuidIndex mTransactionIds;
+  /// Interns the notes of every account in the book.
+  std::shared_ptr< NotesPool > mNotesPool;
+  /// Indexes the words of those notes; updated after every posting.
+  NotesIndex mNotesIndex;
+  /// Totals per account and other party; updated after every posting.
+  FlowGraph mFlows;
+  TransactionIdPolicy mTransactionIdPolicy { TransactionIdPolicy::kRandom };
 };
 } // namespace dbsc
 
@@ -1,14 +1,25 @@
 // dbsc_accountbook.t.cpp
 #include <dbsc_account.h>
 #include <dbsc_accountbook.h>
+#include <dbsc_amountstats.h>
+#include <dbsc_topamounts.h>
 #include <dbsc_uuidstring.h>
 
 #include <bdldfp_decimal.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
 #include <bsls_assert.h>
 
+#include <algorithm>
+#include <chrono>
+#include <format>
 #include <functional>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace {
 
@@ -78,6 +89,359 @@ int main()
   tryMakeTransaction( secondAccountId, std::nullopt );
   tryMakeTransaction( accountId, std::nullopt );
   tryMakeTransaction( accountId, secondAccountId );
+
+  // Handle-based access mirrors the id-based API.
+  auto const firstHandle  = accountBook.handle( accountId );
+  auto const secondHandle = accountBook.handle( secondAccountId );
+  BSLS_ASSERT( firstHandle != secondHandle );
+  BSLS_ASSERT( &accountBook.account( firstHandle ) == &accountBook.account( accountId ) );
+  auto const handleTransactionId =
+    accountBook.makeTransaction( kTransactionAmount, "Handle transaction", firstHandle, secondHandle );
+  BSLS_ASSERT( accountBook.account( firstHandle ).balance() == kTransactionAmount );
+  BSLS_ASSERT( accountBook.account( secondHandle ).balance() == BloombergLP::bdldfp::Decimal64() );
+  BSLS_ASSERT( dbsc::Transaction::isPair( accountBook.account( firstHandle ).transaction( handleTransactionId ),
+                                          accountBook.account( secondHandle ).transaction( handleTransactionId ) ) );
+  accountBook.deactivate( secondHandle );
+  try {
+    accountBook.makeTransaction( kTransactionAmount, "", firstHandle, secondHandle );
+    BSLS_ASSERT( false );
+  } catch ( dbsc::InactiveAccountException const& ) {
+  }
+  accountBook.activate( secondHandle );
+  accountBook.makeTransaction( -kTransactionAmount, "", firstHandle, secondHandle );
+
+  // Re-adding an existing account is rejected.
+  try {
+    accountBook.addParsedAccount( accountBook.account( firstHandle ) );
+    BSLS_ASSERT( false );
+  } catch ( dbsc::DuplicateUuidException const& ) {
+  }
+
+  // Time-ordered ids: iteration order is chronological.
+  auto isChronological = []( dbsc::Account const& account ) {
+    return std::ranges::is_sorted(
+      account, std::less(), []( auto const& entry ) { return entry.second.timestamp(); } );
+  };
+  BSLS_ASSERT( accountBook.transactionIdPolicy() == dbsc::TransactionIdPolicy::kRandom );
+  accountBook.migrateToTimeOrderedTransactionIds();
+  BSLS_ASSERT( accountBook.transactionIdPolicy() == dbsc::TransactionIdPolicy::kTimeOrdered );
+  BSLS_ASSERT( accountBook.account( accountId ).balance() == BloombergLP::bdldfp::Decimal64() );
+  BSLS_ASSERT( accountBook.account( secondAccountId ).balance() == kTransactionAmount );
+  BSLS_ASSERT( not accountBook.account( secondAccountId ).contains( transactionId ) );
+  for ( auto const& [id, transaction] : accountBook.account( secondAccountId ) ) {
+    BSLS_ASSERT( dbsc::UuidStringUtil::version( id ) == 7 );
+    BSLS_ASSERT( dbsc::Transaction::isPair( transaction, accountBook.account( accountId ).transaction( id ) ) );
+  }
+
+  for ( [[maybe_unused]] auto _ : std::views::iota( 0, 50 ) ) {
+    accountBook.makeTransaction( kTransactionAmount, "", accountId, secondAccountId );
+  }
+  BSLS_ASSERT( isChronological( accountBook.account( accountId ) ) );
+  BSLS_ASSERT( isChronological( accountBook.account( secondAccountId ) ) );
+
+  // Internal transfers share a single record between both accounts.
+  {
+    auto const sharedId = accountBook.makeTransaction( kTransactionAmount, "shared", accountId, secondAccountId );
+    auto rowOf          = [&sharedId]( dbsc::Account const& account ) {
+      auto const& ids = account.transactions().ids();
+      return static_cast< dbsc::TransactionStore::Row >( std::ranges::find( ids, sharedId ) - ids.begin() );
+    };
+    dbsc::Account const& first  = accountBook.account( accountId );
+    dbsc::Account const& second = accountBook.account( secondAccountId );
+    auto const& record          = first.transactions().transfer( rowOf( first ) );
+    BSLS_ASSERT( record != nullptr );
+    BSLS_ASSERT( record.get() == second.transactions().transfer( rowOf( second ) ).get() );
+    BSLS_ASSERT( dbsc::Transaction::isPair( first.transaction( sharedId ), second.transaction( sharedId ) ) );
+  }
+  // Notes are interned once per book, across accounts.
+  {
+    auto const before = accountBook.notesPool().stats();
+    accountBook.makeTransaction( kTransactionAmount, "Groceries", accountId, std::nullopt );
+    accountBook.makeTransaction( kTransactionAmount, "Groceries", secondAccountId, std::nullopt );
+    auto const after = accountBook.notesPool().stats();
+    BSLS_ASSERT( after.mUniqueCount == before.mUniqueCount + 1 );
+    BSLS_ASSERT( after.bytesSaved() == before.bytesSaved() + std::string_view( "Groceries" ).size() );
+  }
+  try {
+    accountBook.makeTransaction( kTransactionAmount, "", accountId, accountId );
+    BSLS_ASSERT( false );
+  } catch ( std::invalid_argument const& ) {
+  }
+
+  // Transaction-id registry
+  {
+    dbsc::AccountBook book { std::string { kOwnerName } };
+    auto const depositId = book.makeTransaction( kTransactionAmount, "", book.createAccount( "Deposits", "" ), {} );
+    BSLS_ASSERT( book.containsTransaction( depositId ) );
+    BSLS_ASSERT( not book.containsTransaction( dbsc::UuidStringUtil::generate() ) );
+
+    auto const timeStamp =
+      std::chrono::time_point_cast< dbsc::TimeStamp::duration >( std::chrono::system_clock::now() );
+    auto makeAccount     = [timeStamp]( dbsc::UuidString const& accountId,
+                                    dbsc::UuidString const& transactionId,
+                                    dbsc::UuidString const& otherPartyId,
+                                    BloombergLP::bdldfp::Decimal64 amount ) {
+      dbsc::Account account { accountId, "Parsed", "" };
+      account.logTransaction( { transactionId, account.id(), otherPartyId, amount, timeStamp, "" } );
+      return account;
+    };
+
+    // An external transaction may not reuse an id held elsewhere.
+    try {
+      book.addParsedAccount( makeAccount( dbsc::UuidStringUtil::generate(), depositId, {}, kTransactionAmount ) );
+      BSLS_ASSERT( false );
+    } catch ( dbsc::DuplicateUuidException const& ) {
+    }
+    BSLS_ASSERT( book.accountCount() == 1 );
+
+    // The two legs of a transfer share an id; a third use is rejected.
+    auto const transferId = dbsc::UuidStringUtil::generate();
+    auto const senderId   = dbsc::UuidStringUtil::generate();
+    auto const receiverId = dbsc::UuidStringUtil::generate();
+    book.addParsedAccount( makeAccount( senderId, transferId, receiverId, -kTransactionAmount ) );
+    BSLS_ASSERT( book.containsTransaction( transferId ) );
+    book.addParsedAccount( makeAccount( receiverId, transferId, senderId, kTransactionAmount ) );
+    BSLS_ASSERT( book.accountCount() == 3 );
+    try {
+      book.addParsedAccount(
+        makeAccount( dbsc::UuidStringUtil::generate(), transferId, senderId, kTransactionAmount ) );
+      BSLS_ASSERT( false );
+    } catch ( dbsc::DuplicateUuidException const& ) {
+    }
+    BSLS_ASSERT( book.accountCount() == 3 );
+
+    book.migrateToTimeOrderedTransactionIds();
+    BSLS_ASSERT( not book.containsTransaction( depositId ) );
+    for ( auto const& [_, account] : book ) {
+      for ( auto const& [transactionId, transaction] : account ) {
+        BSLS_ASSERT( book.containsTransaction( transactionId ) );
+      }
+    }
+  }
+
+  // Test: bulk posting
+  {
+    dbsc::AccountBook book { std::string { kOwnerName } };
+    auto const payroll = book.handle( book.createAccount( "Payroll", "" ) );
+    std::vector< dbsc::AccountHandle > employees;
+    for ( int i = 0; i < 10; ++i ) {
+      employees.push_back( book.handle( book.createAccount( "Employee", "" ) ) );
+    }
+
+    std::vector< dbsc::TransactionRequest > requests { { "1000.00"_d64, "Funding", payroll } };
+    for ( auto const employee : employees ) {
+      requests.push_back( { "-50.00"_d64, "Salary", payroll, employee } );
+    }
+    auto const ids = book.makeTransactions( requests );
+    BSLS_ASSERT( ids.size() == requests.size() );
+    BSLS_ASSERT( book.account( payroll ).balance() == "500.00"_d64 );
+    BSLS_ASSERT( book.account( payroll ).transactionCount() == 11 );
+    for ( std::size_t i = 0; i < employees.size(); ++i ) {
+      auto const& employee = book.account( employees[i] );
+      BSLS_ASSERT( employee.balance() == "50.00"_d64 );
+      BSLS_ASSERT( dbsc::Transaction::isPair( employee.transaction( ids[i + 1] ),
+                                              book.account( payroll ).transaction( ids[i + 1] ) ) );
+    }
+    // Legs are logged in request order.
+    BSLS_ASSERT( std::ranges::equal( book.account( payroll ).transactions().ids(), ids ) );
+    BSLS_ASSERT( std::ranges::all_of( ids, [&book]( auto const& id ) { return book.containsTransaction( id ); } ) );
+
+    // An invalid request anywhere in the batch leaves the book unchanged.
+    book.deactivate( employees.back() );
+    try {
+      static_cast< void >( book.makeTransactions( requests ) );
+      BSLS_ASSERT( false );
+    } catch ( dbsc::InactiveAccountException const& ) {
+    }
+    book.activate( employees.back() );
+    requests.push_back( { "1.00"_d64, "", payroll, payroll } );
+    try {
+      static_cast< void >( book.makeTransactions( requests ) );
+      BSLS_ASSERT( false );
+    } catch ( std::invalid_argument const& ) {
+    }
+    BSLS_ASSERT( book.account( payroll ).transactionCount() == 11 );
+    BSLS_ASSERT( book.account( employees.front() ).transactionCount() == 1 );
+    BSLS_ASSERT( book.makeTransactions( {} ).empty() );
+  }
+
+  // Test: split transactions
+  {
+    dbsc::AccountBook book { std::string { kOwnerName } };
+    auto const checking = book.handle( book.createAccount( "Checking", "" ) );
+    auto const rent     = book.handle( book.createAccount( "Rent", "" ) );
+    auto const savings  = book.handle( book.createAccount( "Savings", "" ) );
+
+    std::vector< dbsc::SplitAllocation > allocations {
+      { checking, "500.00"_d64 }, { rent, "1200.00"_d64 }, { savings, "300.00"_d64 } };
+    auto const splitId = book.makeSplitTransaction( "2000.00"_d64, "Paycheck", allocations );
+    BSLS_ASSERT( book.containsTransaction( splitId ) );
+    BSLS_ASSERT( book.account( rent ).balance() == "1200.00"_d64 );
+    BSLS_ASSERT( book.account( savings ).transaction( splitId ).notes() == "Paycheck" );
+    BSLS_ASSERT( dbsc::UuidStringUtil::isNil( book.account( checking ).transaction( splitId ).otherPartyId() ) );
+
+    // One record, shared by every account.
+    auto const row = *book.account( rent ).rowOf( splitId );
+    BSLS_ASSERT( book.account( rent ).transactions().split( row )
+                 == book.account( checking ).transactions().split( *book.account( checking ).rowOf( splitId ) ) );
+
+    // Re-adding the accounts of a split is accepted leg by leg.
+    dbsc::AccountBook copy { std::string { kOwnerName } };
+    for ( auto const& [_, account] : book ) {
+      copy.addParsedAccount( account );
+    }
+    BSLS_ASSERT( copy.account( book.account( savings ).id() ).balance() == "300.00"_d64 );
+
+    copy.migrateToTimeOrderedTransactionIds();
+    auto const& migratedRent    = copy.account( book.account( rent ).id() );
+    auto const& migratedSavings = copy.account( book.account( savings ).id() );
+    auto const migratedId       = migratedRent.transactions().id( 0 );
+    BSLS_ASSERT( migratedId != splitId );
+    BSLS_ASSERT( migratedSavings.contains( migratedId ) );
+    BSLS_ASSERT( migratedRent.transactions().split( 0 ) == migratedSavings.transactions().split( 0 ) );
+
+    // Unbalanced, repeated, or inactive allocations post nothing.
+    allocations.back().mAmount = "1.00"_d64;
+    try {
+      static_cast< void >( book.makeSplitTransaction( "2000.00"_d64, "", allocations ) );
+      BSLS_ASSERT( false );
+    } catch ( std::invalid_argument const& ) {
+    }
+    try {
+      static_cast< void >(
+        book.makeSplitTransaction( "2.00"_d64, "", std::vector< dbsc::SplitAllocation > { { rent, "1.00"_d64 },
+                                                                                           { rent, "1.00"_d64 } } ) );
+      BSLS_ASSERT( false );
+    } catch ( std::invalid_argument const& ) {
+    }
+    book.deactivate( savings );
+    try {
+      static_cast< void >( book.makeSplitTransaction( "1201.00"_d64, "", allocations ) );
+      BSLS_ASSERT( false );
+    } catch ( dbsc::InactiveAccountException const& ) {
+    }
+    BSLS_ASSERT( book.account( checking ).transactionCount() == 1 );
+    BSLS_ASSERT( book.account( rent ).transactionCount() == 1 );
+  }
+
+  // Test: allocator support
+  {
+    BloombergLP::bslma::TestAllocator defaultAllocator( "default" );
+    BloombergLP::bslma::DefaultAllocatorGuard const guard( &defaultAllocator );
+    BloombergLP::bslma::TestAllocator bookAllocator( "book" );
+    BloombergLP::bslma::TestAllocator copyAllocator( "copy" );
+    {
+      dbsc::AccountBook book { std::string { kOwnerName }, &bookAllocator };
+      BSLS_ASSERT( book.get_allocator() == dbsc::AccountBook::allocator_type( &bookAllocator ) );
+
+      auto const checking = book.handle( book.createAccount( "Checking", "" ) );
+      auto const savings  = book.handle( book.createAccount( "Savings", "" ) );
+      BSLS_ASSERT( book.account( checking ).get_allocator() == book.get_allocator() );
+      for ( int i = 0; i < 100; ++i ) {
+        static_cast< void >( book.makeTransaction( "10.00"_d64, "Paycheck", checking, std::nullopt ) );
+        static_cast< void >( book.makeTransaction( "-2.50"_d64, "Savings", checking, savings ) );
+      }
+      book.migrateToTimeOrderedTransactionIds();
+      BSLS_ASSERT( book.account( savings ).transactionCount() == 100 );
+
+      // A copy made with another allocator draws from that one.
+      dbsc::Account const copy { book.account( checking ), &copyAllocator };
+      BSLS_ASSERT( copy == book.account( checking ) );
+      BSLS_ASSERT( copyAllocator.numBlocksInUse() > 0 );
+
+      // Only temporaries may use the default allocator.
+      BSLS_ASSERT( bookAllocator.numBlocksInUse() > 0 );
+      BSLS_ASSERT( defaultAllocator.numBlocksInUse() == 0 );
+    }
+    BSLS_ASSERT( bookAllocator.numBlocksInUse() == 0 );
+    BSLS_ASSERT( copyAllocator.numBlocksInUse() == 0 );
+  }
+
+  // Test: rollups
+  {
+    dbsc::AccountBook book { std::string { kOwnerName } };
+    std::vector< dbsc::AccountHandle > handles;
+    for ( int i = 0; i < 8; ++i ) {
+      handles.push_back( book.handle( book.createAccount( std::format( "Envelope {}", i ), "" ) ) );
+    }
+    for ( int i = 0; i < 64; ++i ) {
+      static_cast< void >(
+        book.makeTransaction( "-1.25"_d64, "Spending", handles[i % 8], handles[( i + 1 ) % 8] ) );
+    }
+    auto const postedAt     = book.account( handles[0] ).transactions().timestamp( 0 );
+    auto const monthlyTotal = [&book, postedAt]( dbsc::AccountHandle handle ) {
+      return book.account( handle ).rollup( dbsc::RollupPeriod::kMonth ).totals( postedAt );
+    };
+    BSLS_ASSERT( monthlyTotal( handles[0] ).mCount == 16 );
+    BSLS_ASSERT( monthlyTotal( handles[0] ).mOutflow == "10.00"_d64 );
+    BSLS_ASSERT( monthlyTotal( handles[0] ).net() == "0.00"_d64 );
+
+    std::vector< dbsc::PeriodTotals > before;
+    for ( dbsc::AccountHandle const handle : handles ) {
+      before.push_back( monthlyTotal( handle ) );
+    }
+    book.rebuildRollups( 3 );
+    for ( std::size_t i = 0; i < handles.size(); ++i ) {
+      BSLS_ASSERT( monthlyTotal( handles[i] ) == before[i] );
+    }
+  }
+
+  // Test: book-wide amount statistics
+  {
+    dbsc::AccountBook book { std::string { kOwnerName } };
+    auto const rent      = book.handle( book.createAccount( "Rent", "" ) );
+    auto const groceries = book.handle( book.createAccount( "Groceries", "" ) );
+    static_cast< void >( book.makeTransaction( "2000.00"_d64, "Paycheck", rent, std::nullopt ) );
+    static_cast< void >( book.makeTransaction( "-1500.00"_d64, "Rent", rent, std::nullopt ) );
+    static_cast< void >( book.makeTransaction( "-200.00"_d64, "To groceries", rent, groceries ) );
+    for ( int i = 1; i <= 9; ++i ) {
+      static_cast< void >(
+        book.makeTransaction( BloombergLP::bdldfp::Decimal64( -10 * i ), "Market", groceries, std::nullopt ) );
+    }
+
+    dbsc::AmountStats const stats = book.amountStats();
+    BSLS_ASSERT( stats.sketch( dbsc::AmountDirection::kOutflow ).count() == 11 );
+    BSLS_ASSERT( stats.sketch( dbsc::AmountDirection::kInflow ).count() == 2 );
+    BSLS_ASSERT( stats.quantile( dbsc::AmountDirection::kOutflow, 0.5 ) == "60"_d64 );
+    auto const withdrawals = stats.largest( dbsc::AmountDirection::kOutflow ).entries();
+    BSLS_ASSERT( withdrawals[0].mAmount == "-1500.00"_d64 );
+    BSLS_ASSERT( withdrawals[1].mAmount == "-200.00"_d64 );
+    BSLS_ASSERT( withdrawals[2].mAmount == "-90"_d64 );
+    BSLS_ASSERT( withdrawals[2].mAccountId == book.account( groceries ).id() );
+
+    auto const postedAt = book.account( rent ).transactions().timestamp( 0 );
+    auto const largest
+      = book.largestBetween( dbsc::AmountDirection::kInflow, 5, postedAt, postedAt + std::chrono::days( 1 ) );
+    BSLS_ASSERT( largest.size() == 2 );
+    BSLS_ASSERT( largest[0].mAmount == "2000.00"_d64 );
+    BSLS_ASSERT( largest[1].mAmount == "200.00"_d64 );
+    BSLS_ASSERT( largest[1].mAccountId == book.account( groceries ).id() );
+    BSLS_ASSERT( book.largestBetween( dbsc::AmountDirection::kInflow, 5, postedAt, postedAt ).empty() );
+  }
+
+  // Test: a moved-from book can still post
+  {
+    dbsc::AccountBook source { std::string { kOwnerName } };
+    static_cast< void >( source.createAccount( "Checking", "" ) );
+    dbsc::AccountBook const moved { std::move( source ) };
+    BSLS_ASSERT( moved.accountCount() == 1 );
+
+    auto const checking = source.handle( source.createAccount( "Checking", "" ) );
+    auto const savings  = source.handle( source.createAccount( "Savings", "" ) );
+    static_cast< void >( source.makeTransaction( "50.00"_d64, "Deposit", checking, std::nullopt ) );
+    std::vector< dbsc::SplitAllocation > const allocations { { checking, "30.00"_d64 }, { savings, "20.00"_d64 } };
+    static_cast< void >( source.makeSplitTransaction( "50.00"_d64, "Deposit", allocations ) );
+    BSLS_ASSERT( source.account( checking ).balance() == "80.00"_d64 );
+    BSLS_ASSERT( source.notesPool().stats().mUniqueCount == 1 );
+
+    dbsc::AccountBook target { std::string { kOwnerName } };
+    target = std::move( source );
+    BSLS_ASSERT( target.accountCount() == 2 );
+    auto const cash = source.handle( source.createAccount( "Cash", "" ) );
+    static_cast< void >( source.makeTransaction( "5.00"_d64, "Deposit", cash, std::nullopt ) );
+    BSLS_ASSERT( source.accountCount() == 1 );
+    BSLS_ASSERT( &source.notesPool() == &target.notesPool() );
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,345 @@
+// dbsc_accountbookaudit.cpp
+#include "dbsc_accountbookaudit.h"
+
+#include <dbsc_account.h>
+#include <dbsc_parallelutil.h>
+#include <dbsc_split.h>
+#include <dbsc_transaction.h>
+#include <dbsc_transactionstore.h>
+#include <dbsc_uuidindex.h>
+
+#include <bdldfp_decimal.h>
+#include <bdldfp_decimalutil.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+namespace dbsc {
+
+namespace {
+  /// Rows per leg-checking task; large enough to amortize claiming a task,
+  /// small enough to balance the load across threads.
+  constexpr TransactionStore::Row kRowsPerTask = 1U << 16;
+
+  /// A unit of work: the balance check of an account, or its legs in
+  /// [mFirst, mLast).
+  struct Task
+  {
+    std::uint32_t mAccount;
+    bool mIsBalanceCheck;
+    TransactionStore::Row mFirst;
+    TransactionStore::Row mLast;
+  };
+
+  /// @return how far two sums of the amounts of @p store, added in different
+  /// orders, may differ through rounding alone: for n amounts of magnitudes
+  /// summing to m, `n * m * 10^-15`. Each Decimal64 addition rounds by at most
+  /// half a unit in the 16th significant digit of a partial sum no larger
+  /// than m, so either side is off by at most half that. Sums that fit in 16
+  /// digits, as those of amounts held in dbsc::Money units usually do, are
+  /// exact; a real discrepancy between them is at least one Money unit.
+  [[nodiscard]] auto roundingTolerance( TransactionStore const& store ) -> BloombergLP::bdldfp::Decimal64
+  {
+    BloombergLP::bdldfp::Decimal64 magnitudes {};
+    for ( BloombergLP::bdldfp::Decimal64 const amount : store.amounts() ) {
+      magnitudes += amount < BloombergLP::bdldfp::Decimal64() ? -amount : amount;
+    }
+    return magnitudes
+         * BloombergLP::bdldfp::DecimalUtil::makeDecimal64( static_cast< long long >( store.size() ), -15 );
+  }
+
+  /// Query if sums @p a and @p b agree within @p tolerance.
+  [[nodiscard]] auto agree( BloombergLP::bdldfp::Decimal64 a,
+                            BloombergLP::bdldfp::Decimal64 b,
+                            BloombergLP::bdldfp::Decimal64 tolerance ) -> bool
+  {
+    BloombergLP::bdldfp::Decimal64 const difference = a < b ? b - a : a - b;
+    return difference <= tolerance;
+  }
+
+  /// What one thread gathered.
+  struct Partial
+  {
+    std::vector< AuditFinding > mFindings {};
+    std::size_t mTransferLegCount { 0 };
+    std::size_t mSplitLegCount { 0 };
+  };
+
+  /// The read-only state shared by the threads of one run.
+  class Auditor
+  {
+  public:
+    explicit Auditor( AccountBook const& book )
+      : mBook( book )
+    {
+      mAccounts.reserve( static_cast< std::size_t >( book.accountCount() ) );
+      mAccountIndex.reserve( static_cast< std::size_t >( book.accountCount() ) );
+      for ( auto const& [accountId, account] : book ) {
+        mAccountIndex.insert( accountId, static_cast< UuidIndex::Position >( mAccounts.size() ) );
+        mAccounts.push_back( &account );
+      }
+    }
+
+    [[nodiscard]] auto accounts() const -> std::vector< Account const* > const& { return mAccounts; }
+
+    void checkBalance( Account const& account, Partial& partial ) const
+    {
+      TransactionStore const& store = account.transactions();
+      auto const rowCount           = static_cast< TransactionStore::Row >( store.size() );
+      auto const recomputed         = store.sumAmounts( 0, rowCount );
+      // The three totals add the amounts in different orders.
+      auto const tolerance = roundingTolerance( store );
+      if ( not agree( account.balance(), recomputed, tolerance ) ) {
+        report( partial,
+                AuditFinding::Kind::kBalanceMismatch,
+                account,
+                {},
+                std::format( "balance is {} but the transactions sum to {}",
+                             TransactionUtil::currencyToString( account.balance() ),
+                             TransactionUtil::currencyToString( recomputed ) ) );
+      }
+      if ( account.balances().size() != store.size() ) {
+        report( partial,
+                AuditFinding::Kind::kBalanceIndexMismatch,
+                account,
+                {},
+                std::format( "the index holds {} of {} rows", account.balances().size(), store.size() ) );
+      } else if ( not agree( account.balances().total(), recomputed, tolerance ) ) {
+        report( partial,
+                AuditFinding::Kind::kBalanceIndexMismatch,
+                account,
+                {},
+                std::format( "the index totals {} but the transactions sum to {}",
+                             TransactionUtil::currencyToString( account.balances().total() ),
+                             TransactionUtil::currencyToString( recomputed ) ) );
+      }
+    }
+
+    void checkRows( Account const& account,
+                    TransactionStore::Row first,
+                    TransactionStore::Row last,
+                    Partial& partial ) const
+    {
+      TransactionStore const& store = account.transactions();
+      for ( TransactionStore::Row row = first; row < last; ++row ) {
+        UuidString const& transactionId = store.id( row );
+        if ( not mBook.containsTransaction( transactionId ) ) {
+          report( partial,
+                  AuditFinding::Kind::kUnregisteredTransaction,
+                  account,
+                  transactionId,
+                  "the id is not in the book's registry" );
+        }
+        if ( auto const& split = store.split( row ) ) {
+          ++partial.mSplitLegCount;
+          checkSplitLeg( account, row, *split, partial );
+        } else if ( not UuidStringUtil::isNil( store.counterpartyId( row ) ) ) {
+          ++partial.mTransferLegCount;
+          checkTransferLeg( account, row, partial );
+        }
+      }
+    }
+
+  private:
+    [[nodiscard]] auto find( UuidString const& accountId ) const -> Account const*
+    {
+      auto const position = mAccountIndex.find( accountId );
+      return position.has_value() ? mAccounts[*position] : nullptr;
+    }
+
+    void checkTransferLeg( Account const& account, TransactionStore::Row row, Partial& partial ) const
+    {
+      TransactionStore const& store   = account.transactions();
+      UuidString const& transactionId = store.id( row );
+      UuidString const& counterpartyId = store.counterpartyId( row );
+      Account const* const counterparty = find( counterpartyId );
+      if ( counterparty == nullptr ) {
+        report( partial,
+                AuditFinding::Kind::kUnknownCounterparty,
+                account,
+                transactionId,
+                std::format( "counterparty {} is not in the book", counterpartyId ) );
+        return;
+      }
+      auto const counterpartRow = counterparty->rowOf( transactionId );
+      if ( not counterpartRow.has_value() ) {
+        report( partial,
+                AuditFinding::Kind::kMissingCounterpart,
+                account,
+                transactionId,
+                std::format( "counterparty {} holds no leg with this id", counterpartyId ) );
+        return;
+      }
+      // The conditions of Transaction::isPair, read from the columns.
+      TransactionStore const& other = counterparty->transactions();
+      bool const isPair             = store.amount( row ) == -other.amount( *counterpartRow )
+                       && store.timestamp( row ) == other.timestamp( *counterpartRow )
+                       && store.notes( row ) == other.notes( *counterpartRow )
+                       && other.counterpartyId( *counterpartRow ) == account.id();
+      if ( not isPair ) {
+        report( partial,
+                AuditFinding::Kind::kMismatchedCounterpart,
+                account,
+                transactionId,
+                std::format( "the leg held by {} does not pair with this one", counterpartyId ) );
+      }
+    }
+
+    void checkSplitLeg( Account const& account, TransactionStore::Row row, Split const& split, Partial& partial ) const
+    {
+      TransactionStore const& store   = account.transactions();
+      UuidString const& transactionId = store.id( row );
+      if ( split.id() != transactionId || not split.involves( account.id() )
+           || split.amountFor( account.id() ) != store.amount( row ) ) {
+        report( partial,
+                AuditFinding::Kind::kSplitMismatch,
+                account,
+                transactionId,
+                "the row disagrees with its split record" );
+        return;
+      }
+      for ( SplitLeg const& leg : split.legs() ) {
+        if ( leg.mAccountId == account.id() ) {
+          continue;
+        }
+        Account const* const other = find( leg.mAccountId );
+        auto const otherRow        = other != nullptr ? other->rowOf( transactionId ) : std::nullopt;
+        auto const* const otherSplit =
+          otherRow.has_value() ? other->transactions().split( *otherRow ).get() : nullptr;
+        if ( otherSplit == nullptr || ( otherSplit != &split && not( *otherSplit == split ) ) ) {
+          report( partial,
+                  AuditFinding::Kind::kSplitMismatch,
+                  account,
+                  transactionId,
+                  std::format( "account {} does not hold this split", leg.mAccountId ) );
+        }
+      }
+    }
+
+    static void report( Partial& partial,
+                        AuditFinding::Kind kind,
+                        Account const& account,
+                        UuidString const& transactionId,
+                        std::string detail )
+    {
+      partial.mFindings.push_back( { kind, account.id(), transactionId, std::move( detail ) } );
+    }
+
+    AccountBook const& mBook;
+    /// The accounts in book order, and their positions by id.
+    std::vector< Account const* > mAccounts;
+    UuidIndex mAccountIndex;
+  };
+} // namespace
+
+auto AuditFinding::kindName( Kind kind ) -> std::string_view
+{
+  switch ( kind ) {
+  case Kind::kBalanceMismatch:
+    return "balance mismatch";
+  case Kind::kBalanceIndexMismatch:
+    return "balance index mismatch";
+  case Kind::kUnknownCounterparty:
+    return "unknown counterparty";
+  case Kind::kMissingCounterpart:
+    return "missing counterpart";
+  case Kind::kMismatchedCounterpart:
+    return "mismatched counterpart";
+  case Kind::kSplitMismatch:
+    return "split mismatch";
+  case Kind::kUnregisteredTransaction:
+    return "unregistered transaction";
+  }
+  return "unknown";
+}
+
+auto operator<<( std::ostream& stream, AuditReport const& report ) -> std::ostream&
+{
+  stream << std::format( "Audited {} accounts and {} transactions ({} transfer legs, {} split legs) with {} "
+                         "threads in {} ms: {} findings\n",
+                         report.mAccountCount,
+                         report.mTransactionCount,
+                         report.mTransferLegCount,
+                         report.mSplitLegCount,
+                         report.mThreadCount,
+                         std::chrono::duration_cast< std::chrono::milliseconds >( report.mElapsed ).count(),
+                         report.mFindings.size() );
+  for ( AuditFinding const& finding : report.mFindings ) {
+    stream << std::format( "  {}: account {}", AuditFinding::kindName( finding.mKind ), finding.mAccountId );
+    if ( not UuidStringUtil::isNil( finding.mTransactionId ) ) {
+      stream << std::format( ", transaction {}", finding.mTransactionId );
+    }
+    stream << ": " << finding.mDetail << '\n';
+  }
+  return stream;
+}
+
+AccountBookAudit::AccountBookAudit( AccountBook const& book, unsigned threadCount )
+  : mBook( book )
+  , mThreadCount( threadCount )
+{
+}
+
+auto AccountBookAudit::run() const -> AuditReport
+{
+  auto const start = std::chrono::steady_clock::now();
+  Auditor const auditor { mBook };
+  AuditReport report;
+  report.mAccountCount = auditor.accounts().size();
+
+  std::vector< Task > tasks;
+  for ( std::uint32_t account = 0; account < auditor.accounts().size(); ++account ) {
+    auto const rowCount = static_cast< TransactionStore::Row >( auditor.accounts()[account]->transactions().size() );
+    report.mTransactionCount += rowCount;
+    tasks.push_back( { account, true, 0, rowCount } );
+    for ( TransactionStore::Row first = 0; first < rowCount; first += std::min( kRowsPerTask, rowCount - first ) ) {
+      tasks.push_back( { account, false, first, first + std::min( kRowsPerTask, rowCount - first ) } );
+    }
+  }
+
+  report.mThreadCount = ParallelUtil::threadCountFor( mThreadCount, tasks.size() );
+  std::vector< Partial > partials( report.mThreadCount );
+  ParallelUtil::forEachTask( tasks.size(), report.mThreadCount, [&]( std::size_t i, unsigned thread ) {
+    Task const& task       = tasks[i];
+    Account const& account = *auditor.accounts()[task.mAccount];
+    if ( task.mIsBalanceCheck ) {
+      auditor.checkBalance( account, partials[thread] );
+    } else {
+      auditor.checkRows( account, task.mFirst, task.mLast, partials[thread] );
+    }
+  } );
+
+  for ( Partial& partial : partials ) {
+    report.mTransferLegCount += partial.mTransferLegCount;
+    report.mSplitLegCount += partial.mSplitLegCount;
+    std::ranges::move( partial.mFindings, std::back_inserter( report.mFindings ) );
+  }
+  std::ranges::sort( report.mFindings, std::less(), []( AuditFinding const& finding ) {
+    return std::tie( finding.mAccountId, finding.mTransactionId, finding.mKind );
+  } );
+  report.mElapsed = std::chrono::steady_clock::now() - start;
+  return report;
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
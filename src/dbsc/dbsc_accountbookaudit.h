@@ -0,0 +1,146 @@
+// dbsc_accountbookaudit.h
+#ifndef INCLUDED_DBSC_ACCOUNTBOOKAUDIT
+#define INCLUDED_DBSC_ACCOUNTBOOKAUDIT
+
+//@PURPOSE: Provide a parallel consistency check of a whole AccountBook.
+//
+//@CLASSES:
+//  dbsc::AccountBookAudit: verifies balances and cross-account records of a
+//    book using a pool of threads.
+//  dbsc::AuditFinding: one inconsistency found by an audit.
+//  dbsc::AuditReport: the findings and statistics of one audit run.
+//
+//@DESCRIPTION: A book is normally consistent by construction, but one read
+//  from storage is only as good as the file. An audit verifies, for every
+//  account:
+//
+//  - the balance: the account's running total, the sum recomputed from its
+//    amounts, and the total of its balance index must agree, and the index
+//    must cover every row. These sums add the amounts in different orders,
+//    so they need only agree within the rounding of n Decimal64 additions,
+//    taken as `n * m * 10^-15` for n amounts of magnitudes summing to m.
+//    For most books that is far below the smallest dbsc::Money unit, so a
+//    real discrepancy still shows;
+//  - every transfer leg: the counterparty must be an account of the book,
+//    holding a leg with the same id that `Transaction::isPair` accepts;
+//  - every split leg: the split must involve the account with the row's
+//    amount, and every other account of the split must hold the same record;
+//  - every transaction id is in the book's registry.
+//
+//  The work is divided into tasks (one balance check per account, and the
+//  legs in blocks of rows), which the threads claim from a shared counter, so
+//  a book dominated by one large account still uses every thread. Each
+//  transaction is visited once and nothing is materialized; legs are compared
+//  column by column. The book must not be modified while an audit runs.
+//
+//  Findings are reported in a deterministic order (by account id, then
+//  transaction id), whatever the number of threads.
+//
+/// Usage
+/// -----
+/// Example 1: Checking a book after loading it
+///
+/// ```cpp
+/// dbsc::AccountBook const book = dbsc::readAccountBook< dbsc::TomlSerializer >( path );
+/// dbsc::AuditReport const report = dbsc::AccountBookAudit( book ).run();
+/// if ( not report.isClean() ) {
+///     std::cerr << report;
+/// }
+/// ```
+
+#include <dbsc_accountbook.h>
+#include <dbsc_sharedapi.h>
+#include <dbsc_uuidstring.h>
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dbsc {
+
+/// One inconsistency found by an audit.
+struct AuditFinding
+{
+  enum class Kind
+  {
+    /// The balance disagrees with the sum of the amounts.
+    kBalanceMismatch,
+    /// The balance index disagrees with the transactions.
+    kBalanceIndexMismatch,
+    /// A transfer leg names a counterparty that is not in the book.
+    kUnknownCounterparty,
+    /// The counterparty holds no leg with the transfer's id.
+    kMissingCounterpart,
+    /// The counterparty's leg does not pair with this one.
+    kMismatchedCounterpart,
+    /// A split leg disagrees with its record or with another account.
+    kSplitMismatch,
+    /// The transaction id is missing from the book's registry.
+    kUnregisteredTransaction,
+  };
+
+  [[nodiscard]] DBSC_API static auto kindName( Kind kind ) -> std::string_view;
+
+  Kind mKind;
+  UuidString mAccountId;
+  /// Nil for findings about the account as a whole.
+  UuidString mTransactionId;
+  std::string mDetail;
+};
+
+/// The outcome of `AccountBookAudit::run`.
+struct AuditReport
+{
+  std::vector< AuditFinding > mFindings {};
+  std::size_t mAccountCount { 0 };
+  std::size_t mTransactionCount { 0 };
+  std::size_t mTransferLegCount { 0 };
+  std::size_t mSplitLegCount { 0 };
+  unsigned mThreadCount { 0 };
+  std::chrono::nanoseconds mElapsed {};
+
+  [[nodiscard]] auto isClean() const noexcept -> bool { return mFindings.empty(); }
+};
+
+/// Write a summary line followed by one line per finding.
+DBSC_API auto operator<<( std::ostream& stream, AuditReport const& report ) -> std::ostream&;
+
+/// Verifies the internal consistency of an AccountBook.
+class AccountBookAudit
+{
+public:
+  /// Prepare to audit @p book, which must outlive this object, with
+  /// @p threadCount threads (0 selects one per hardware thread).
+  DBSC_API explicit AccountBookAudit( AccountBook const& book, unsigned threadCount = 0 );
+
+  /// Audit the book and @return the report. May be called repeatedly.
+  [[nodiscard]] DBSC_API auto run() const -> AuditReport;
+
+private:
+  AccountBook const& mBook;
+  unsigned mThreadCount;
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
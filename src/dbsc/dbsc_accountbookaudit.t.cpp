@@ -0,0 +1,149 @@
+// dbsc_accountbookaudit.t.cpp
+// Test driver for dbsc::AccountBookAudit
+#include <dbsc_account.h>
+#include <dbsc_accountbook.h>
+#include <dbsc_accountbookaudit.h>
+#include <dbsc_transaction.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+using Kind = dbsc::AuditFinding::Kind;
+
+static void testCleanBook()
+{
+  dbsc::AccountBook book { std::string { "Owner" } };
+  auto const checking = book.handle( book.createAccount( "Checking", "" ) );
+  auto const savings  = book.handle( book.createAccount( "Savings", "" ) );
+  auto const rent     = book.handle( book.createAccount( "Rent", "" ) );
+  static_cast< void >( book.makeTransaction( "100.00"_d64, "Deposit", checking, std::nullopt ) );
+  static_cast< void >( book.makeTransaction( "-25.00"_d64, "Transfer", checking, savings ) );
+  std::vector< dbsc::SplitAllocation > const allocations { { checking, "500.00"_d64 }, { rent, "1200.00"_d64 } };
+  static_cast< void >( book.makeSplitTransaction( "1700.00"_d64, "Paycheck", allocations ) );
+
+  for ( unsigned threadCount : { 1U, 4U } ) {
+    dbsc::AuditReport const report = dbsc::AccountBookAudit( book, threadCount ).run();
+    BSLS_ASSERT( report.isClean() );
+    BSLS_ASSERT( report.mAccountCount == 3 );
+    BSLS_ASSERT( report.mTransactionCount == 5 );
+    BSLS_ASSERT( report.mTransferLegCount == 2 );
+    BSLS_ASSERT( report.mSplitLegCount == 2 );
+    BSLS_ASSERT( report.mThreadCount >= 1 && report.mThreadCount <= threadCount );
+  }
+
+  dbsc::AccountBook const empty { std::string { "Owner" } };
+  BSLS_ASSERT( dbsc::AccountBookAudit( empty ).run().isClean() );
+}
+
+static void testInexactAmounts()
+{
+  // Amounts finer than dbsc::Money units, interleaved with large exact ones
+  // whose sums exceed 16 digits, round differently in each of the sums the
+  // audit compares.
+  dbsc::AccountBook book { std::string { "Owner" } };
+  auto const trading = book.handle( book.createAccount( "Trading", "" ) );
+  auto const savings = book.handle( book.createAccount( "Savings", "" ) );
+  for ( int i = 0; i < 200; ++i ) {
+    static_cast< void >( book.makeTransaction( "987654321098.7654"_d64, "Sale", trading, std::nullopt ) );
+    static_cast< void >( book.makeTransaction( "0.000123456789"_d64, "Interest", trading, std::nullopt ) );
+    static_cast< void >( book.makeTransaction( "-987654321097.1234"_d64, "Purchase", trading, savings ) );
+    static_cast< void >( book.makeTransaction( "-0.333333333333333"_d64, "Fee", trading, std::nullopt ) );
+  }
+  BSLS_ASSERT( not book.account( trading ).transactions().amountsAreExact() );
+  BSLS_ASSERT( book.account( savings ).transactions().amountsAreExact() );
+
+  dbsc::AuditReport const report = dbsc::AccountBookAudit( book, 2 ).run();
+  BSLS_ASSERT( report.isClean() );
+}
+
+static void testCorruptBook()
+{
+  auto const timeStamp =
+    std::chrono::time_point_cast< dbsc::TimeStamp::duration >( std::chrono::system_clock::now() );
+  auto makeAccount = [timeStamp]( dbsc::UuidString const& accountId,
+                                  dbsc::UuidString const& transactionId,
+                                  dbsc::UuidString const& otherPartyId,
+                                  BloombergLP::bdldfp::Decimal64 amount ) {
+    dbsc::Account account { accountId, "Parsed", "" };
+    account.logTransaction( { transactionId, account.id(), otherPartyId, amount, timeStamp, "" } );
+    return account;
+  };
+
+  dbsc::AccountBook book { std::string { "Owner" } };
+  // A transfer whose legs disagree on the amount.
+  auto const mismatchedId = dbsc::UuidStringUtil::generate();
+  auto const senderId     = dbsc::UuidStringUtil::generate();
+  auto const receiverId   = dbsc::UuidStringUtil::generate();
+  book.addParsedAccount( makeAccount( senderId, mismatchedId, receiverId, "-10.00"_d64 ) );
+  book.addParsedAccount( makeAccount( receiverId, mismatchedId, senderId, "9.00"_d64 ) );
+  // A transfer whose counterparty holds no leg with its id.
+  auto const orphanId = dbsc::UuidStringUtil::generate();
+  book.addParsedAccount( makeAccount( dbsc::UuidStringUtil::generate(), orphanId, senderId, "5.00"_d64 ) );
+  // A transfer to an account that is not in the book.
+  auto const strayId  = dbsc::UuidStringUtil::generate();
+  auto const strandId = dbsc::UuidStringUtil::generate();
+  book.addParsedAccount( makeAccount( strandId, strayId, dbsc::UuidStringUtil::generate(), "1.00"_d64 ) );
+
+  dbsc::AuditReport const report = dbsc::AccountBookAudit( book, 1 ).run();
+  auto const count = [&report]( Kind kind, dbsc::UuidString const& transactionId ) {
+    return std::ranges::count_if( report.mFindings, [&]( dbsc::AuditFinding const& finding ) {
+      return finding.mKind == kind && finding.mTransactionId == transactionId;
+    } );
+  };
+  BSLS_ASSERT( count( Kind::kMismatchedCounterpart, mismatchedId ) == 2 );
+  BSLS_ASSERT( count( Kind::kMissingCounterpart, orphanId ) == 1 );
+  BSLS_ASSERT( count( Kind::kUnknownCounterparty, strayId ) == 1 );
+  BSLS_ASSERT( report.mFindings.size() == 4 );
+  BSLS_ASSERT( std::ranges::is_sorted( report.mFindings, {}, &dbsc::AuditFinding::mAccountId ) );
+
+  // The findings do not depend on the number of threads.
+  dbsc::AuditReport const parallel = dbsc::AccountBookAudit( book, 4 ).run();
+  BSLS_ASSERT( parallel.mFindings.size() == report.mFindings.size() );
+  for ( std::size_t i = 0; i < report.mFindings.size(); ++i ) {
+    BSLS_ASSERT( parallel.mFindings[i].mKind == report.mFindings[i].mKind );
+    BSLS_ASSERT( parallel.mFindings[i].mAccountId == report.mFindings[i].mAccountId );
+    BSLS_ASSERT( parallel.mFindings[i].mTransactionId == report.mFindings[i].mTransactionId );
+  }
+
+  std::ostringstream stream;
+  stream << report;
+  BSLS_ASSERT( stream.str().find( "4 findings" ) != std::string::npos );
+  BSLS_ASSERT( stream.str().find( std::format( "unknown counterparty: account {}, transaction {}", strandId, strayId ) )
+               != std::string::npos );
+}
+} // namespace
+
+auto main() -> int
+{
+  testCleanBook();
+  testInexactAmounts();
+  testCorruptBook();
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
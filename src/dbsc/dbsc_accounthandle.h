@@ -0,0 +1,61 @@
+// dbsc_accounthandle.h
+#ifndef INCLUDED_DBSC_ACCOUNTHANDLE
+#define INCLUDED_DBSC_ACCOUNTHANDLE
+
+//@PURPOSE: Provide a dense, book-local reference to an Account.
+//
+//@CLASSES:
+//  dbsc::AccountHandle: a dense, book-local index of an Account.
+//
+//@DESCRIPTION: Handles are issued by dbsc::AccountBook, which is the only
+//  class that can create them. This component lets structures that refer to
+//  the accounts of a book (such as dbsc::NotesIndex) store handles without
+//  depending on the book itself.
+
+#include <compare>
+#include <cstdint>
+
+namespace dbsc {
+
+class AccountBook;
+
+/// Identifies an Account by its position in the owning AccountBook. Handles
+/// are only meaningful for the book that issued them and remain valid for that
+/// book's lifetime, since accounts are never removed.
+class AccountHandle
+{
+public:
+  [[nodiscard]] constexpr auto index() const noexcept -> std::uint32_t { return mIndex; }
+
+  [[nodiscard]] constexpr auto operator<=>( AccountHandle const& other ) const = default;
+
+private:
+  friend class AccountBook;
+  constexpr explicit AccountHandle( std::uint32_t index ) noexcept
+    : mIndex( index )
+  {
+  }
+
+  std::uint32_t mIndex;
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,134 @@
+// dbsc_amountstats.cpp
+#include "dbsc_amountstats.h"
+
+#include <dbsc_money.h>
+
+#include <bdldfp_decimalutil.h>
+
+#include <limits>
+#include <utility>
+
+namespace dbsc {
+
+namespace {
+/// @return @p magnitude in Money units, rounded to the nearest one, and
+/// saturated if it is out of range.
+auto unitsOf( BloombergLP::bdldfp::Decimal64 magnitude ) -> QuantileSketch::Value
+{
+  if ( auto const money = Money::fromDecimal( magnitude ) ) {
+    return money->units();
+  }
+  using BloombergLP::bdldfp::DecimalUtil;
+  auto const units = MoneyUtil::unitsFromDecimal(
+    DecimalUtil::round( DecimalUtil::multiplyByPowerOf10( magnitude, Money::kScale ) ), 0 );
+  return units ? *units : std::numeric_limits< QuantileSketch::Value >::max();
+}
+} // namespace
+
+AmountStats::AmountStats( allocator_type const& allocator )
+  : mDeposits( AmountDirection::kInflow, kTrackedCount, allocator )
+  , mWithdrawals( AmountDirection::kOutflow, kTrackedCount, allocator )
+  , mInflows( allocator )
+  , mOutflows( allocator )
+{
+}
+
+AmountStats::AmountStats( AmountStats const& original, allocator_type const& allocator )
+  : mDeposits( original.mDeposits, allocator )
+  , mWithdrawals( original.mWithdrawals, allocator )
+  , mInflows( original.mInflows, allocator )
+  , mOutflows( original.mOutflows, allocator )
+{
+}
+
+AmountStats::AmountStats( AmountStats&& original ) noexcept = default;
+
+AmountStats::AmountStats( AmountStats&& original, allocator_type const& allocator )
+  : mDeposits( std::move( original.mDeposits ), allocator )
+  , mWithdrawals( std::move( original.mWithdrawals ), allocator )
+  , mInflows( std::move( original.mInflows ), allocator )
+  , mOutflows( std::move( original.mOutflows ), allocator )
+{
+}
+
+auto AmountStats::operator=( AmountStats const& rhs ) -> AmountStats& = default;
+
+auto AmountStats::operator=( AmountStats&& rhs ) -> AmountStats& = default;
+
+auto AmountStats::largest( AmountDirection direction ) const noexcept -> TopAmounts const&
+{
+  return direction == AmountDirection::kInflow ? mDeposits : mWithdrawals;
+}
+
+auto AmountStats::sketch( AmountDirection direction ) const noexcept -> QuantileSketch const&
+{
+  return direction == AmountDirection::kInflow ? mInflows : mOutflows;
+}
+
+auto AmountStats::quantile( AmountDirection direction, double fraction ) const
+  -> std::optional< BloombergLP::bdldfp::Decimal64 >
+{
+  QuantileSketch const& distribution = sketch( direction );
+  if ( distribution.isEmpty() ) {
+    return std::nullopt;
+  }
+  return Money::fromUnits( distribution.quantile( fraction ) ).toDecimal();
+}
+
+auto AmountStats::get_allocator() const noexcept -> allocator_type
+{
+  return mInflows.get_allocator();
+}
+
+void AmountStats::add( RankedAmount const& amount )
+{
+  BloombergLP::bdldfp::Decimal64 const zero {};
+  if ( amount.mAmount > zero ) {
+    mDeposits.add( amount );
+    mInflows.add( unitsOf( amount.mAmount ) );
+  } else if ( amount.mAmount < zero ) {
+    mWithdrawals.add( amount );
+    mOutflows.add( unitsOf( -amount.mAmount ) );
+  }
+}
+
+void AmountStats::merge( AmountStats const& other )
+{
+  mDeposits.merge( other.mDeposits );
+  mWithdrawals.merge( other.mWithdrawals );
+  mInflows.merge( other.mInflows );
+  mOutflows.merge( other.mOutflows );
+}
+
+void AmountStats::reserve( std::size_t count )
+{
+  mInflows.reserve( count );
+  mOutflows.reserve( count );
+}
+
+void AmountStats::clear()
+{
+  mDeposits.clear();
+  mWithdrawals.clear();
+  mInflows.clear();
+  mOutflows.clear();
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
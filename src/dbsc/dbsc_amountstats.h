@@ -0,0 +1,123 @@
+// dbsc_amountstats.h
+#ifndef INCLUDED_DBSC_AMOUNTSTATS
+#define INCLUDED_DBSC_AMOUNTSTATS
+
+//@PURPOSE: Provide the largest amounts and amount percentiles of an account.
+//
+//@CLASSES:
+//  dbsc::AmountStats: the largest deposits and withdrawals, and sketches of
+//    the distribution of each, maintained as amounts are added.
+//
+//@DESCRIPTION: Dashboards show an account's largest transactions and the
+//  percentiles of its spending. AmountStats keeps both current as the account
+//  logs transactions, so neither requires copying out and sorting its
+//  transactions: a dbsc::TopAmounts of the `kTrackedCount` largest deposits
+//  and another of the largest withdrawals, and a dbsc::QuantileSketch of the
+//  magnitudes of each.
+//
+//  The sketches hold magnitudes in `dbsc::Money` units, so percentiles are
+//  exact amounts of the sample; an amount with more decimal places than
+//  Money is rounded to the nearest unit. Zero amounts count in neither
+//  direction.
+//
+//  Statistics merge: the merge of the statistics of several accounts is that
+//  of their union, with the accuracy of each sketch unchanged, which is how
+//  dbsc::AccountBook answers for the whole book.
+//
+//  Memory is bounded whatever the number of amounts, at about 6 KB per
+//  direction, and obtained from the allocator supplied at construction.
+//
+/// Usage
+/// -----
+/// Example 1: The 90th percentile of an account's spending
+///
+/// ```cpp
+/// dbsc::AmountStats const& stats = account.amountStats();
+/// if ( auto const p90 = stats.quantile( dbsc::AmountDirection::kOutflow, 0.9 ) ) {
+///     std::println( "90% of purchases are below {}", *p90 );
+/// }
+/// ```
+
+#include <dbsc_quantilesketch.h>
+#include <dbsc_sharedapi.h>
+#include <dbsc_topamounts.h>
+
+#include <bdldfp_decimal.h>
+#include <bsl_memory.h>
+
+#include <cstddef>
+#include <optional>
+
+namespace dbsc {
+
+/// Running top-N and quantile summaries of a stream of amounts.
+class AmountStats
+{
+public:
+  using allocator_type = bsl::allocator< char >; // NOLINT
+
+  /// The number of largest deposits, and of largest withdrawals, kept.
+  static constexpr std::size_t kTrackedCount = 32;
+
+  DBSC_API explicit AmountStats( allocator_type const& allocator = allocator_type() );
+  DBSC_API AmountStats( AmountStats const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API AmountStats( AmountStats&& original ) noexcept;
+  DBSC_API AmountStats( AmountStats&& original, allocator_type const& allocator );
+  DBSC_API auto operator=( AmountStats const& rhs ) -> AmountStats&;
+  DBSC_API auto operator=( AmountStats&& rhs ) -> AmountStats&;
+
+  /// The `kTrackedCount` largest amounts of @p direction, or all of them if
+  /// there are fewer.
+  [[nodiscard]] DBSC_API auto largest( AmountDirection direction ) const noexcept -> TopAmounts const&;
+
+  /// The distribution of the magnitudes of the amounts of @p direction, in
+  /// `dbsc::Money` units.
+  [[nodiscard]] DBSC_API auto sketch( AmountDirection direction ) const noexcept -> QuantileSketch const&;
+
+  /// @return the approximate @p fraction quantile of the magnitudes of the
+  /// amounts of @p direction (0.5 is the median), or nothing if there are
+  /// none.
+  /// @pre `0 <= fraction <= 1`
+  [[nodiscard]] DBSC_API auto quantile( AmountDirection direction, double fraction ) const
+    -> std::optional< BloombergLP::bdldfp::Decimal64 >;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+  DBSC_API void add( RankedAmount const& amount );
+
+  /// Add the amounts summarized by @p other.
+  DBSC_API void merge( AmountStats const& other );
+
+  /// Ensure @p count more amounts can be added without allocating.
+  DBSC_API void reserve( std::size_t count );
+
+  /// Forget every amount.
+  DBSC_API void clear();
+
+private:
+  TopAmounts mDeposits;
+  TopAmounts mWithdrawals;
+  QuantileSketch mInflows;
+  QuantileSketch mOutflows;
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,123 @@
+// dbsc_amountstats.t.cpp
+// Test driver for dbsc::AmountStats
+#include <dbsc_amountstats.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bslma_testallocator.h>
+#include <bsls_assert.h>
+
+#include <chrono>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+using namespace std::chrono;
+
+static auto amountOf( BloombergLP::bdldfp::Decimal64 amount ) -> dbsc::RankedAmount
+{
+  static dbsc::UuidString const accountId = dbsc::UuidStringUtil::generate();
+  return { accountId, dbsc::UuidStringUtil::generate(), amount, sys_days( year( 2025 ) / 6 / 1 ) };
+}
+
+static void testStats()
+{
+  dbsc::AmountStats stats;
+  BSLS_ASSERT( not stats.quantile( dbsc::AmountDirection::kOutflow, 0.5 ).has_value() );
+
+  // Withdrawals of 1.00 to 100.00, and one deposit.
+  for ( int cents = 100; cents <= 10'000; cents += 100 ) {
+    stats.add( amountOf( -BloombergLP::bdldfp::Decimal64( cents ) / 100 ) );
+  }
+  stats.add( amountOf( "2500.00"_d64 ) );
+  stats.add( amountOf( "0.00"_d64 ) );
+
+  dbsc::QuantileSketch const& outflows = stats.sketch( dbsc::AmountDirection::kOutflow );
+  BSLS_ASSERT( outflows.count() == 100 );
+  BSLS_ASSERT( outflows.max() == 1'000'000 );
+  BSLS_ASSERT( stats.sketch( dbsc::AmountDirection::kInflow ).count() == 1 );
+  BSLS_ASSERT( stats.quantile( dbsc::AmountDirection::kOutflow, 0.5 ) == "50.00"_d64 );
+  BSLS_ASSERT( stats.quantile( dbsc::AmountDirection::kOutflow, 0.9 ) == "90.00"_d64 );
+  BSLS_ASSERT( stats.quantile( dbsc::AmountDirection::kInflow, 0.5 ) == "2500.00"_d64 );
+
+  dbsc::TopAmounts const& withdrawals = stats.largest( dbsc::AmountDirection::kOutflow );
+  BSLS_ASSERT( withdrawals.size() == dbsc::AmountStats::kTrackedCount );
+  BSLS_ASSERT( withdrawals.entries().front().mAmount == "-100.00"_d64 );
+  BSLS_ASSERT( withdrawals.entries().back().mAmount == "-69.00"_d64 );
+  BSLS_ASSERT( stats.largest( dbsc::AmountDirection::kInflow ).size() == 1 );
+
+  // Amounts finer than a Money unit are rounded for the sketch only.
+  dbsc::AmountStats fine;
+  fine.add( amountOf( "-0.00004"_d64 ) );
+  fine.add( amountOf( "-0.00006"_d64 ) );
+  BSLS_ASSERT( fine.sketch( dbsc::AmountDirection::kOutflow ).count() == 2 );
+  BSLS_ASSERT( fine.largest( dbsc::AmountDirection::kOutflow ).entries().front().mAmount == "-0.00006"_d64 );
+
+  stats.clear();
+  BSLS_ASSERT( stats.sketch( dbsc::AmountDirection::kOutflow ).isEmpty() );
+  BSLS_ASSERT( stats.largest( dbsc::AmountDirection::kOutflow ).size() == 0 );
+}
+
+static void testMerge()
+{
+  dbsc::AmountStats first;
+  dbsc::AmountStats second;
+  for ( int units = 1; units <= 50; ++units ) {
+    first.add( amountOf( BloombergLP::bdldfp::Decimal64( units ) ) );
+    second.add( amountOf( BloombergLP::bdldfp::Decimal64( units + 50 ) ) );
+  }
+  second.add( amountOf( "-1.00"_d64 ) );
+
+  dbsc::AmountStats merged;
+  merged.merge( first );
+  merged.merge( second );
+  BSLS_ASSERT( merged.sketch( dbsc::AmountDirection::kInflow ).count() == 100 );
+  BSLS_ASSERT( merged.sketch( dbsc::AmountDirection::kOutflow ).count() == 1 );
+  BSLS_ASSERT( merged.quantile( dbsc::AmountDirection::kInflow, 0.25 ) == "25"_d64 );
+  BSLS_ASSERT( merged.largest( dbsc::AmountDirection::kInflow ).entries().front().mAmount == "100"_d64 );
+  BSLS_ASSERT( merged.largest( dbsc::AmountDirection::kInflow ).entries().back().mAmount == "69"_d64 );
+}
+
+static void testAllocator()
+{
+  BloombergLP::bslma::TestAllocator allocator;
+  {
+    dbsc::AmountStats stats { &allocator };
+    stats.reserve( 5'000 );
+    auto const blocks = allocator.numBlocksTotal();
+    for ( int units = 1; units <= 5'000; ++units ) {
+      stats.add( amountOf( BloombergLP::bdldfp::Decimal64( units % 2 == 0 ? units : -units ) ) );
+    }
+    BSLS_ASSERT( allocator.numBlocksTotal() == blocks );
+
+    dbsc::AmountStats const copy { stats, &allocator };
+    BSLS_ASSERT( copy.quantile( dbsc::AmountDirection::kInflow, 0.5 )
+                 == stats.quantile( dbsc::AmountDirection::kInflow, 0.5 ) );
+  }
+  BSLS_ASSERT( allocator.numBlocksInUse() == 0 );
+}
+} // namespace
+
+auto main() -> int
+{
+  testStats();
+  testMerge();
+  testAllocator();
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,282 @@
+// dbsc_balanceindex.cpp
+#include "dbsc_balanceindex.h"
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace dbsc {
+
+namespace {
+  /// Derive a node's heap priority from its row. Rows are sequential, so
+  /// mix the bits to obtain priorities that behave like random ones.
+  constexpr auto priorityFor( std::uint32_t row ) -> std::uint32_t
+  {
+    row ^= row >> 16;
+    row *= 0x7feb352dU;
+    row ^= row >> 15;
+    row *= 0x846ca68bU;
+    row ^= row >> 16;
+    return row;
+  }
+} // namespace
+
+BalanceIndex::BalanceIndex( allocator_type const& allocator )
+  : mNodes( allocator )
+{
+}
+
+BalanceIndex::BalanceIndex( BalanceIndex const& original, allocator_type const& allocator )
+  : mNodes( original.mNodes, allocator )
+  , mRoot( original.mRoot )
+  , mFirst( original.mFirst )
+{
+}
+
+BalanceIndex::BalanceIndex( BalanceIndex&& original ) noexcept
+  : mNodes( std::move( original.mNodes ) )
+  , mRoot( std::exchange( original.mRoot, kNil ) )
+  , mFirst( std::exchange( original.mFirst, kNil ) )
+{
+}
+
+BalanceIndex::BalanceIndex( BalanceIndex&& original, allocator_type const& allocator )
+  : mNodes( std::move( original.mNodes ), allocator )
+  , mRoot( std::exchange( original.mRoot, kNil ) )
+  , mFirst( std::exchange( original.mFirst, kNil ) )
+{
+  original.mNodes.clear();
+}
+
+auto BalanceIndex::operator=( BalanceIndex const& rhs ) -> BalanceIndex&
+{
+  mNodes = rhs.mNodes;
+  mRoot  = rhs.mRoot;
+  mFirst = rhs.mFirst;
+  return *this;
+}
+
+auto BalanceIndex::operator=( BalanceIndex&& rhs ) -> BalanceIndex&
+{
+  mNodes = std::move( rhs.mNodes );
+  mRoot  = std::exchange( rhs.mRoot, kNil );
+  mFirst = std::exchange( rhs.mFirst, kNil );
+  rhs.mNodes.clear();
+  return *this;
+}
+
+auto BalanceIndex::size() const noexcept -> std::size_t
+{
+  return mNodes.size();
+}
+
+auto BalanceIndex::empty() const noexcept -> bool
+{
+  return mNodes.empty();
+}
+
+auto BalanceIndex::total() const -> BloombergLP::bdldfp::Decimal64
+{
+  return subtreeSum( mRoot );
+}
+
+auto BalanceIndex::balanceAsOf( TimeStamp timeStamp ) const -> BloombergLP::bdldfp::Decimal64
+{
+  BloombergLP::bdldfp::Decimal64 balance {};
+  std::uint32_t node = mRoot;
+  while ( node != kNil ) {
+    Node const& current = mNodes[node];
+    if ( current.mTimeStamp <= timeStamp ) {
+      balance += subtreeSum( current.mLeft ) + current.mAmount;
+      node = current.mRight;
+    } else {
+      node = current.mLeft;
+    }
+  }
+  return balance;
+}
+
+auto BalanceIndex::countAsOf( TimeStamp timeStamp ) const -> std::size_t
+{
+  std::size_t count  = 0;
+  std::uint32_t node = mRoot;
+  while ( node != kNil ) {
+    Node const& current = mNodes[node];
+    if ( current.mTimeStamp <= timeStamp ) {
+      count += subtreeSize( current.mLeft ) + 1;
+      node = current.mRight;
+    } else {
+      node = current.mLeft;
+    }
+  }
+  return count;
+}
+
+auto BalanceIndex::runningBalance( Row row ) const -> BloombergLP::bdldfp::Decimal64
+{
+  BSLS_ASSERT( row < size() );
+  BloombergLP::bdldfp::Decimal64 balance {};
+  std::uint32_t node = mRoot;
+  while ( node != kNil ) {
+    Node const& current = mNodes[node];
+    if ( not precedes( row, node ) ) {
+      balance += subtreeSum( current.mLeft ) + current.mAmount;
+      node = current.mRight;
+    } else {
+      node = current.mLeft;
+    }
+  }
+  return balance;
+}
+
+auto BalanceIndex::rowsInTimeOrder() const -> std::vector< Row >
+{
+  std::vector< Row > rows;
+  rows.reserve( size() );
+  for ( std::uint32_t node = mFirst; node != kNil; node = mNodes[node].mNext ) {
+    rows.push_back( node );
+  }
+  return rows;
+}
+
+auto BalanceIndex::rows() const -> RowRange
+{
+  return { RowIterator( this, mFirst ), RowIterator( this, kNil ) };
+}
+
+auto BalanceIndex::rowsBetween( TimeStamp begin, TimeStamp end ) const -> RowRange
+{
+  if ( end <= begin ) {
+    return {};
+  }
+  return { RowIterator( this, firstAtOrAfter( begin ) ), RowIterator( this, firstAtOrAfter( end ) ) };
+}
+
+auto BalanceIndex::get_allocator() const noexcept -> allocator_type
+{
+  return mNodes.get_allocator();
+}
+
+void BalanceIndex::insert( TimeStamp timeStamp, BloombergLP::bdldfp::Decimal64 amount )
+{
+  BSLS_ASSERT( size() < kNil );
+  auto const node = static_cast< std::uint32_t >( size() );
+
+  // The new node follows every node at or before its timestamp; the last of
+  // those is its predecessor in the chronological list.
+  std::uint32_t predecessor = kNil;
+  for ( std::uint32_t current = mRoot; current != kNil; ) {
+    if ( mNodes[current].mTimeStamp <= timeStamp ) {
+      predecessor = current;
+      current     = mNodes[current].mRight;
+    } else {
+      current = mNodes[current].mLeft;
+    }
+  }
+  std::uint32_t const next = predecessor == kNil ? mFirst : mNodes[predecessor].mNext;
+
+  // Only the append can fail; relinking does not allocate.
+  mNodes.push_back( { timeStamp, amount, amount, 1, priorityFor( node ), kNil, kNil, next } );
+  ( predecessor == kNil ? mFirst : mNodes[predecessor].mNext ) = node;
+  mRoot = insertInto( mRoot, node );
+}
+
+void BalanceIndex::reserve( std::size_t count )
+{
+  // Keep growth geometric when called ahead of every small batch.
+  if ( count > mNodes.capacity() ) {
+    mNodes.reserve( std::max( count, mNodes.capacity() * 2 ) );
+  }
+}
+
+auto BalanceIndex::precedes( std::uint32_t a, std::uint32_t b ) const -> bool
+{
+  return mNodes[a].mTimeStamp < mNodes[b].mTimeStamp || ( mNodes[a].mTimeStamp == mNodes[b].mTimeStamp && a < b );
+}
+
+auto BalanceIndex::subtreeSum( std::uint32_t node ) const -> BloombergLP::bdldfp::Decimal64
+{
+  return node == kNil ? BloombergLP::bdldfp::Decimal64() : mNodes[node].mSubtreeSum;
+}
+
+auto BalanceIndex::subtreeSize( std::uint32_t node ) const -> std::uint32_t
+{
+  return node == kNil ? 0 : mNodes[node].mSubtreeSize;
+}
+
+void BalanceIndex::update( std::uint32_t node )
+{
+  Node& current        = mNodes[node];
+  current.mSubtreeSum  = subtreeSum( current.mLeft ) + current.mAmount + subtreeSum( current.mRight );
+  current.mSubtreeSize = subtreeSize( current.mLeft ) + 1 + subtreeSize( current.mRight );
+}
+
+void BalanceIndex::split( std::uint32_t root, std::uint32_t pivot, std::uint32_t& before, std::uint32_t& after )
+{
+  if ( root == kNil ) {
+    before = kNil;
+    after  = kNil;
+    return;
+  }
+  if ( precedes( root, pivot ) ) {
+    split( mNodes[root].mRight, pivot, mNodes[root].mRight, after );
+    before = root;
+  } else {
+    split( mNodes[root].mLeft, pivot, before, mNodes[root].mLeft );
+    after = root;
+  }
+  update( root );
+}
+
+auto BalanceIndex::insertInto( std::uint32_t root, std::uint32_t node ) -> std::uint32_t
+{
+  if ( root == kNil ) {
+    return node;
+  }
+  if ( mNodes[node].mPriority > mNodes[root].mPriority ) {
+    split( root, node, mNodes[node].mLeft, mNodes[node].mRight );
+    update( node );
+    return node;
+  }
+  if ( precedes( node, root ) ) {
+    mNodes[root].mLeft = insertInto( mNodes[root].mLeft, node );
+  } else {
+    mNodes[root].mRight = insertInto( mNodes[root].mRight, node );
+  }
+  update( root );
+  return root;
+}
+
+auto BalanceIndex::firstAtOrAfter( TimeStamp timeStamp ) const -> std::uint32_t
+{
+  std::uint32_t first = kNil;
+  for ( std::uint32_t node = mRoot; node != kNil; ) {
+    if ( mNodes[node].mTimeStamp < timeStamp ) {
+      node = mNodes[node].mRight;
+    } else {
+      first = node;
+      node  = mNodes[node].mLeft;
+    }
+  }
+  return first;
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,228 @@
+// dbsc_balanceindex.h
+#ifndef INCLUDED_DBSC_BALANCEINDEX
+#define INCLUDED_DBSC_BALANCEINDEX
+
+//@PURPOSE: Provide a time-ordered index of amounts with running balances.
+//
+//@CLASSES:
+//  dbsc::BalanceIndex: an ordered set of (timestamp, row, amount) entries
+//    supporting prefix-sum queries.
+//
+//@DESCRIPTION: This component defines the structure an Account uses to answer
+//  "what was the balance at time t" without scanning its transactions. Each
+//  row of the account's store has one entry, keyed by its timestamp; entries
+//  with equal timestamps are ordered by row, i.e. by logging order.
+//
+//  Entries are kept in a treap (a binary search tree balanced by random
+//  priorities) whose nodes carry the sum and count of their subtree. A prefix
+//  sum over a Fenwick tree would answer the same queries, but cannot take an
+//  entry in the middle of the order without rebuilding; the treap accepts
+//  backdated entries in O(log n) expected time and keeps every running
+//  balance correct. `balanceAsOf`, `countAsOf` and `runningBalance` all
+//  descend a single path and are O(log n) expected as well.
+//
+//  Nodes live in one array, in row order, and refer to each other by
+//  position, so the node of row `r` is found without a search. The array is
+//  obtained from the allocator supplied at construction.
+//
+//  Each node also links to its chronological successor, so `rowsBetween`
+//  finds the first row of a time range by one descent and then walks the
+//  links: O(log n + k) for k rows, without allocating.
+//
+/// Usage
+/// -----
+/// Example 1: Balance on a given date
+///
+/// ```cpp
+/// dbsc::BalanceIndex index;
+/// index.insert( marchTenth, "100.00"_d64 ); // row 0
+/// index.insert( marchFirst, "-40.00"_d64 ); // row 1, backdated
+/// assert( index.balanceAsOf( marchFirst ) == "-40.00"_d64 );
+/// assert( index.runningBalance( 0 ) == "60.00"_d64 );
+/// ```
+///
+/// Example 2: Rows in a time range
+///
+/// ```cpp
+/// for ( dbsc::BalanceIndex::Row row : index.rowsBetween( marchFirst, marchTenth ) ) {
+///     // row 1 only; the range excludes its end
+/// }
+/// ```
+
+#include <dbsc_sharedapi.h>
+#include <dbsc_transaction.h>
+
+#include <bdldfp_decimal.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+namespace dbsc {
+
+/// A time-ordered multiset of amounts answering prefix-sum queries.
+class BalanceIndex
+{
+public:
+  /// A row of the store whose amounts are indexed; rows are inserted in
+  /// increasing order starting from 0.
+  using Row            = std::uint32_t;
+  using allocator_type = bsl::allocator< char >; // NOLINT
+
+  /// Forward iterator over rows in chronological order.
+  class RowIterator
+  {
+  public:
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type       = Row;
+    using difference_type  = std::ptrdiff_t;
+
+    // Members are initialized here rather than in their declarations, which
+    // would only be parsed once BalanceIndex is complete, too late for
+    // `RowRange` to see a default-constructible iterator.
+    RowIterator()
+      : mIndex( nullptr )
+      , mNode( kNil )
+    {
+    }
+
+    RowIterator( BalanceIndex const* index, std::uint32_t node )
+      : mIndex( index )
+      , mNode( node )
+    {
+    }
+
+    [[nodiscard]] auto operator*() const -> Row { return mNode; }
+
+    auto operator++() -> RowIterator&
+    {
+      mNode = mIndex->mNodes[mNode].mNext;
+      return *this;
+    }
+
+    auto operator++( int ) -> RowIterator
+    {
+      RowIterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    [[nodiscard]] friend auto operator==( RowIterator const& a, RowIterator const& b ) -> bool
+    {
+      return a.mNode == b.mNode;
+    }
+
+  private:
+    BalanceIndex const* mIndex;
+    std::uint32_t mNode;
+  };
+
+  using RowRange = std::ranges::subrange< RowIterator >;
+
+  DBSC_API explicit BalanceIndex( allocator_type const& allocator = allocator_type() );
+  DBSC_API BalanceIndex( BalanceIndex const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API BalanceIndex( BalanceIndex&& original ) noexcept;
+  DBSC_API BalanceIndex( BalanceIndex&& original, allocator_type const& allocator );
+  DBSC_API auto operator=( BalanceIndex const& rhs ) -> BalanceIndex&;
+  DBSC_API auto operator=( BalanceIndex&& rhs ) -> BalanceIndex&;
+
+  [[nodiscard]] DBSC_API auto size() const noexcept -> std::size_t;
+  [[nodiscard]] DBSC_API auto empty() const noexcept -> bool;
+
+  /// @return the sum of all amounts.
+  [[nodiscard]] DBSC_API auto total() const -> BloombergLP::bdldfp::Decimal64;
+
+  /// @return the sum of the amounts with a timestamp at or before
+  /// @p timeStamp.
+  [[nodiscard]] DBSC_API auto balanceAsOf( TimeStamp timeStamp ) const -> BloombergLP::bdldfp::Decimal64;
+
+  /// @return the number of entries with a timestamp at or before
+  /// @p timeStamp, i.e. the chronological position a new entry at that time
+  /// would take.
+  [[nodiscard]] DBSC_API auto countAsOf( TimeStamp timeStamp ) const -> std::size_t;
+
+  /// @return the balance immediately after @p row, in chronological order.
+  /// @pre `row < size()`.
+  [[nodiscard]] DBSC_API auto runningBalance( Row row ) const -> BloombergLP::bdldfp::Decimal64;
+
+  /// @return every row in chronological order.
+  [[nodiscard]] DBSC_API auto rowsInTimeOrder() const -> std::vector< Row >;
+
+  /// @return every row in chronological order, without copying them. The
+  /// range is valid until the next `insert`.
+  [[nodiscard]] DBSC_API auto rows() const -> RowRange;
+
+  /// @return the rows with a timestamp in [@p begin, @p end), in
+  /// chronological order. The range is valid until the next `insert`.
+  [[nodiscard]] DBSC_API auto rowsBetween( TimeStamp begin, TimeStamp end ) const -> RowRange;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+  /// Add the entry for the next row, `size()`, at @p timeStamp.
+  DBSC_API void insert( TimeStamp timeStamp, BloombergLP::bdldfp::Decimal64 amount );
+
+  /// Ensure @p count entries fit without reallocating.
+  DBSC_API void reserve( std::size_t count );
+
+private:
+  static constexpr std::uint32_t kNil = UINT32_MAX;
+
+  struct Node
+  {
+    TimeStamp mTimeStamp;
+    BloombergLP::bdldfp::Decimal64 mAmount;
+    /// Sum of the amounts in the subtree rooted here.
+    BloombergLP::bdldfp::Decimal64 mSubtreeSum;
+    std::uint32_t mSubtreeSize;
+    std::uint32_t mPriority;
+    std::uint32_t mLeft;
+    std::uint32_t mRight;
+    /// The next node in chronological order.
+    std::uint32_t mNext;
+  };
+
+  /// @return true if node @p a orders before node @p b.
+  [[nodiscard]] auto precedes( std::uint32_t a, std::uint32_t b ) const -> bool;
+  [[nodiscard]] auto subtreeSum( std::uint32_t node ) const -> BloombergLP::bdldfp::Decimal64;
+  [[nodiscard]] auto subtreeSize( std::uint32_t node ) const -> std::uint32_t;
+  /// Recompute the aggregates of @p node from its children.
+  void update( std::uint32_t node );
+  /// Split the subtree at @p root into the nodes ordered before @p pivot and
+  /// the rest.
+  void split( std::uint32_t root, std::uint32_t pivot, std::uint32_t& before, std::uint32_t& after );
+  /// Insert @p node into the subtree at @p root; @return the new subtree root.
+  auto insertInto( std::uint32_t root, std::uint32_t node ) -> std::uint32_t;
+  /// @return the first node with a timestamp at or after @p timeStamp, or
+  /// `kNil`.
+  [[nodiscard]] auto firstAtOrAfter( TimeStamp timeStamp ) const -> std::uint32_t;
+
+  bsl::vector< Node > mNodes;
+  std::uint32_t mRoot { kNil };
+  /// The chronologically first node.
+  std::uint32_t mFirst { kNil };
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
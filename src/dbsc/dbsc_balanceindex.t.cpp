@@ -0,0 +1,148 @@
+// dbsc_balanceindex.t.cpp
+// Test driver for dbsc::BalanceIndex
+#include <dbsc_balanceindex.h>
+
+#include <bdldfp_decimal.h>
+#include <bslma_testallocator.h>
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+
+dbsc::TimeStamp const kEpoch { std::chrono::system_clock::now() };
+
+static void testBackdatedInsertion()
+{
+  dbsc::BalanceIndex index;
+  BSLS_ASSERT( index.empty() );
+  BSLS_ASSERT( index.balanceAsOf( kEpoch ) == "0.00"_d64 );
+
+  auto const day = std::chrono::hours( 24 );
+  index.insert( kEpoch + 10 * day, "100.00"_d64 );
+  index.insert( kEpoch + 1 * day, "-40.00"_d64 );
+  index.insert( kEpoch + 10 * day, "5.00"_d64 );
+
+  BSLS_ASSERT( index.size() == 3 );
+  BSLS_ASSERT( index.total() == "65.00"_d64 );
+  BSLS_ASSERT( index.balanceAsOf( kEpoch ) == "0.00"_d64 );
+  BSLS_ASSERT( index.balanceAsOf( kEpoch + 1 * day ) == "-40.00"_d64 );
+  BSLS_ASSERT( index.balanceAsOf( kEpoch + 9 * day ) == "-40.00"_d64 );
+  BSLS_ASSERT( index.balanceAsOf( kEpoch + 10 * day ) == "65.00"_d64 );
+  BSLS_ASSERT( index.countAsOf( kEpoch + 9 * day ) == 1 );
+
+  // Equal timestamps keep logging order.
+  BSLS_ASSERT( index.runningBalance( 1 ) == "-40.00"_d64 );
+  BSLS_ASSERT( index.runningBalance( 0 ) == "60.00"_d64 );
+  BSLS_ASSERT( index.runningBalance( 2 ) == "65.00"_d64 );
+  BSLS_ASSERT( index.rowsInTimeOrder() == std::vector< dbsc::BalanceIndex::Row >( { 1, 0, 2 } ) );
+
+  // Time ranges exclude their end.
+  auto const rowsBetween = [&index]( dbsc::TimeStamp begin, dbsc::TimeStamp end ) {
+    auto const rows = index.rowsBetween( begin, end );
+    return std::vector< dbsc::BalanceIndex::Row >( rows.begin(), rows.end() );
+  };
+  using Rows = std::vector< dbsc::BalanceIndex::Row >;
+  BSLS_ASSERT( rowsBetween( kEpoch, kEpoch + 20 * day ) == Rows( { 1, 0, 2 } ) );
+  BSLS_ASSERT( rowsBetween( kEpoch + 1 * day, kEpoch + 10 * day ) == Rows( { 1 } ) );
+  BSLS_ASSERT( rowsBetween( kEpoch + 2 * day, kEpoch + 11 * day ) == Rows( { 0, 2 } ) );
+  BSLS_ASSERT( rowsBetween( kEpoch + 2 * day, kEpoch + 9 * day ).empty() );
+  BSLS_ASSERT( rowsBetween( kEpoch + 10 * day, kEpoch ).empty() );
+  BSLS_ASSERT( dbsc::BalanceIndex().rowsBetween( kEpoch, kEpoch + day ).empty() );
+  BSLS_ASSERT( std::ranges::equal( index.rows(), index.rowsInTimeOrder() ) );
+  BSLS_ASSERT( dbsc::BalanceIndex().rows().empty() );
+}
+
+static void testAgainstScan()
+{
+  constexpr int kEntryCount = 5'000;
+  std::mt19937 generator { 7 };
+  std::uniform_int_distribution< int > minutes { 0, 10'000 };
+  std::uniform_int_distribution< int > units { -500, 500 };
+
+  dbsc::BalanceIndex index;
+  std::vector< dbsc::TimeStamp > timeStamps;
+  std::vector< BloombergLP::bdldfp::Decimal64 > amounts;
+  for ( int i = 0; i < kEntryCount; ++i ) {
+    timeStamps.push_back( kEpoch + std::chrono::minutes( minutes( generator ) ) );
+    amounts.push_back( BloombergLP::bdldfp::Decimal64( units( generator ) ) );
+    index.insert( timeStamps.back(), amounts.back() );
+  }
+
+  for ( int probe = 0; probe < 200; ++probe ) {
+    auto const asOf = kEpoch + std::chrono::minutes( minutes( generator ) );
+    BloombergLP::bdldfp::Decimal64 expected {};
+    std::size_t expectedCount = 0;
+    for ( int i = 0; i < kEntryCount; ++i ) {
+      if ( timeStamps[i] <= asOf ) {
+        expected += amounts[i];
+        ++expectedCount;
+      }
+    }
+    BSLS_ASSERT( index.balanceAsOf( asOf ) == expected );
+    BSLS_ASSERT( index.countAsOf( asOf ) == expectedCount );
+
+    auto const until     = asOf + std::chrono::minutes( minutes( generator ) / 10 );
+    std::size_t rowCount = 0;
+    for ( auto const row : index.rowsBetween( asOf, until ) ) {
+      BSLS_ASSERT( timeStamps[row] >= asOf && timeStamps[row] < until );
+      ++rowCount;
+    }
+    auto const inRange = [&]( dbsc::TimeStamp timeStamp ) { return timeStamp >= asOf && timeStamp < until; };
+    BSLS_ASSERT( rowCount == static_cast< std::size_t >( std::ranges::count_if( timeStamps, inRange ) ) );
+  }
+
+  auto const rows = index.rowsInTimeOrder();
+  BSLS_ASSERT( rows.size() == kEntryCount );
+  BSLS_ASSERT( std::ranges::is_sorted( rows, {}, [&]( auto row ) { return std::pair( timeStamps[row], row ); } ) );
+  BloombergLP::bdldfp::Decimal64 running {};
+  for ( auto const row : rows ) {
+    running += amounts[row];
+    BSLS_ASSERT( index.runningBalance( row ) == running );
+  }
+}
+
+static void testAllocator()
+{
+  BloombergLP::bslma::TestAllocator allocator;
+  {
+    dbsc::BalanceIndex index { &allocator };
+    index.insert( kEpoch, "1.00"_d64 );
+    BSLS_ASSERT( allocator.numBlocksInUse() > 0 );
+
+    dbsc::BalanceIndex const copy { index };
+    BSLS_ASSERT( copy.total() == index.total() );
+  }
+  BSLS_ASSERT( allocator.numBlocksInUse() == 0 );
+}
+} // namespace
+
+int main()
+{
+  testBackdatedInsertion();
+  testAgainstScan();
+  testAllocator();
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
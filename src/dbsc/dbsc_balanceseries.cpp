@@ -0,0 +1,240 @@
+// dbsc_balanceseries.cpp
+#include "dbsc_balanceseries.h"
+
+#include <dbsc_account.h>
+#include <dbsc_accountbook.h>
+#include <dbsc_balanceindex.h>
+#include <dbsc_parallelutil.h>
+#include <dbsc_transactionstore.h>
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace dbsc {
+
+BalanceSeries::BalanceSeries( TimeStamp start, Interval interval, allocator_type const& allocator )
+  : mStart( start )
+  , mInterval( interval )
+  , mAccounts( allocator )
+  , mRowCounts( allocator )
+  , mValues( allocator )
+{
+  if ( interval <= Interval::zero() ) {
+    throw std::invalid_argument( "The interval of a balance series must be positive." );
+  }
+}
+
+BalanceSeries::BalanceSeries( BalanceSeries const& original, allocator_type const& allocator )
+  : mStart( original.mStart )
+  , mInterval( original.mInterval )
+  , mPointCount( original.mPointCount )
+  , mStride( original.mStride )
+  , mAccounts( original.mAccounts, allocator )
+  , mRowCounts( original.mRowCounts, allocator )
+  , mValues( original.mValues, allocator )
+{
+}
+
+BalanceSeries::BalanceSeries( BalanceSeries&& original ) noexcept = default;
+
+BalanceSeries::BalanceSeries( BalanceSeries&& original, allocator_type const& allocator )
+  : mStart( original.mStart )
+  , mInterval( original.mInterval )
+  , mPointCount( original.mPointCount )
+  , mStride( original.mStride )
+  , mAccounts( std::move( original.mAccounts ), allocator )
+  , mRowCounts( std::move( original.mRowCounts ), allocator )
+  , mValues( std::move( original.mValues ), allocator )
+{
+  original.mPointCount = 0;
+  original.mStride     = 0;
+  original.mAccounts.clear();
+  original.mRowCounts.clear();
+  original.mValues.clear();
+}
+
+auto BalanceSeries::operator=( BalanceSeries const& rhs ) -> BalanceSeries& = default;
+
+auto BalanceSeries::operator=( BalanceSeries&& rhs ) -> BalanceSeries&
+{
+  mStart      = rhs.mStart;
+  mInterval   = rhs.mInterval;
+  mPointCount = std::exchange( rhs.mPointCount, 0 );
+  mStride     = std::exchange( rhs.mStride, 0 );
+  mAccounts   = std::move( rhs.mAccounts );
+  mRowCounts  = std::move( rhs.mRowCounts );
+  mValues     = std::move( rhs.mValues );
+  rhs.mAccounts.clear();
+  rhs.mRowCounts.clear();
+  rhs.mValues.clear();
+  return *this;
+}
+
+auto BalanceSeries::start() const noexcept -> TimeStamp
+{
+  return mStart;
+}
+
+auto BalanceSeries::interval() const noexcept -> Interval
+{
+  return mInterval;
+}
+
+auto BalanceSeries::pointCount() const noexcept -> std::size_t
+{
+  return mPointCount;
+}
+
+auto BalanceSeries::pointEnd( std::size_t point ) const -> TimeStamp
+{
+  return boundary( point + 1 );
+}
+
+auto BalanceSeries::accountCount() const noexcept -> std::size_t
+{
+  return mAccounts.size();
+}
+
+auto BalanceSeries::accounts() const noexcept -> std::span< AccountHandle const >
+{
+  return { mAccounts.data(), mAccounts.size() };
+}
+
+auto BalanceSeries::series( std::size_t position ) const -> std::span< BloombergLP::bdldfp::Decimal64 const >
+{
+  BSLS_ASSERT( position < mAccounts.size() );
+  return { mValues.data() + position * mStride, mPointCount };
+}
+
+auto BalanceSeries::get_allocator() const noexcept -> allocator_type
+{
+  return mValues.get_allocator();
+}
+
+void BalanceSeries::compute( AccountBook const& book,
+                             std::span< AccountHandle const > accounts,
+                             std::size_t pointCount,
+                             unsigned threadCount )
+{
+  mAccounts.assign( accounts.begin(), accounts.end() );
+  mRowCounts.assign( accounts.size(), 0 );
+  mValues.clear();
+  mPointCount = 0;
+  mStride     = 0;
+  reserve( pointCount );
+
+  ParallelUtil::forEachTask(
+    mAccounts.size(), ParallelUtil::threadCountFor( threadCount, mAccounts.size() ), [&]( std::size_t i, unsigned ) {
+      Account const& account = book.account( mAccounts[i] );
+      mRowCounts[i]          = account.transactions().size();
+      fill( account, i, 0, pointCount, account.balanceAsOf( mStart - Interval( 1 ) ) );
+    } );
+  mPointCount = pointCount;
+}
+
+void BalanceSeries::extend( AccountBook const& book, std::size_t pointCount, unsigned threadCount )
+{
+  update( book );
+  if ( pointCount <= mPointCount ) {
+    return;
+  }
+  reserve( pointCount );
+
+  std::size_t const first = mPointCount;
+  ParallelUtil::forEachTask(
+    mAccounts.size(), ParallelUtil::threadCountFor( threadCount, mAccounts.size() ), [&]( std::size_t i, unsigned ) {
+      Account const& account = book.account( mAccounts[i] );
+      BloombergLP::bdldfp::Decimal64 const opening =
+        first == 0 ? account.balanceAsOf( mStart - Interval( 1 ) ) : mValues[i * mStride + first - 1];
+      fill( account, i, first, pointCount, opening );
+    } );
+  mPointCount = pointCount;
+}
+
+void BalanceSeries::update( AccountBook const& book )
+{
+  // Transactions at or after the end of the last point are left to `extend`,
+  // which finds them through the balance index.
+  TimeStamp const end = boundary( mPointCount );
+  for ( std::size_t i = 0; i < mAccounts.size(); ++i ) {
+    TransactionStore const& store                = book.account( mAccounts[i] ).transactions();
+    BloombergLP::bdldfp::Decimal64* const points = mValues.data() + i * mStride;
+    for ( std::size_t row = mRowCounts[i]; row < store.size(); ++row ) {
+      TimeStamp const timeStamp = store.timestamp( static_cast< TransactionStore::Row >( row ) );
+      if ( timeStamp >= end ) {
+        continue;
+      }
+      BloombergLP::bdldfp::Decimal64 const amount = store.amount( static_cast< TransactionStore::Row >( row ) );
+      std::size_t const first =
+        timeStamp < mStart ? 0 : static_cast< std::size_t >( ( timeStamp - mStart ) / mInterval );
+      for ( std::size_t point = first; point < mPointCount; ++point ) {
+        points[point] += amount;
+      }
+    }
+    mRowCounts[i] = store.size();
+  }
+}
+
+void BalanceSeries::fill( Account const& account,
+                          std::size_t position,
+                          std::size_t first,
+                          std::size_t last,
+                          BloombergLP::bdldfp::Decimal64 opening )
+{
+  TransactionStore const& store                = account.transactions();
+  BalanceIndex::RowRange const rows            = account.balances().rowsBetween( boundary( first ), boundary( last ) );
+  BloombergLP::bdldfp::Decimal64* const points = mValues.data() + position * mStride;
+  BloombergLP::bdldfp::Decimal64 balance       = opening;
+  auto row                                     = rows.begin();
+  for ( std::size_t point = first; point < last; ++point ) {
+    TimeStamp const end = boundary( point + 1 );
+    for ( ; row != rows.end() && store.timestamp( *row ) < end; ++row ) {
+      balance += store.amount( *row );
+    }
+    points[point] = balance;
+  }
+}
+
+void BalanceSeries::reserve( std::size_t pointCount )
+{
+  if ( pointCount <= mStride ) {
+    return;
+  }
+  // Grow geometrically so that extending a day at a time moves the buffer
+  // O(log n) times.
+  std::size_t const stride = std::max( pointCount, 2 * mStride );
+  bsl::vector< BloombergLP::bdldfp::Decimal64 > values( mAccounts.size() * stride, get_allocator() );
+  for ( std::size_t i = 0; i < mAccounts.size(); ++i ) {
+    std::copy_n( mValues.data() + i * mStride, mPointCount, values.data() + i * stride );
+  }
+  mValues.swap( values );
+  mStride = stride;
+}
+
+auto BalanceSeries::boundary( std::size_t point ) const -> TimeStamp
+{
+  return mStart + mInterval * static_cast< std::int64_t >( point );
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,166 @@
+// dbsc_balanceseries.h
+#ifndef INCLUDED_DBSC_BALANCESERIES
+#define INCLUDED_DBSC_BALANCESERIES
+
+//@PURPOSE: Provide balance time series of accounts at a fixed interval.
+//
+//@CLASSES:
+//  dbsc::BalanceSeries: the balances of a set of accounts at the end of each
+//    of a run of equal intervals, computed in parallel.
+//
+//@DESCRIPTION: Charts and forecasts plot balances on a regular grid (daily,
+//  usually). A BalanceSeries covers the intervals starting at `start()`, each
+//  `interval()` long; point `j` of an account is its balance counting every
+//  transaction before `pointEnd( j )`, i.e. `start() + ( j + 1 ) * interval()`.
+//  Transactions before `start()` count toward every point.
+//
+//  `compute` fills the series of each account from its balance index: one
+//  logarithmic query for the opening balance, then one pass over the account's
+//  transactions in the covered time, in chronological order, with no sorting.
+//  Accounts are computed in parallel, each by one thread writing its own
+//  slice of the buffer.
+//
+//  The points of all accounts share one contiguous buffer, account by account,
+//  with room for more points than are used, so `series` is a plain span and
+//  `extend` usually appends without moving anything. `extend` continues each
+//  series from its last point, and `update` folds in the transactions logged
+//  since the series were computed (backdated ones included), so neither
+//  recomputes what is already known. The buffer is obtained from the
+//  allocator supplied at construction.
+//
+//  A series refers to accounts by handle; use it only with the book it was
+//  computed from.
+//
+/// Usage
+/// -----
+/// Example 1: Daily balances for the last 90 days
+///
+/// ```cpp
+/// dbsc::BalanceSeries series( today - std::chrono::days( 90 ), std::chrono::days( 1 ) );
+/// std::vector< dbsc::AccountHandle > const accounts { book.handle( checkingId ), book.handle( savingsId ) };
+/// series.compute( book, accounts, 90 );
+/// // ... tomorrow, after logging more transactions
+/// series.update( book );
+/// series.extend( book, 91 );
+/// std::span< Decimal64 const > const checking = series.series( 0 );
+/// ```
+
+#include <dbsc_accounthandle.h>
+#include <dbsc_sharedapi.h>
+#include <dbsc_transaction.h>
+
+#include <bdldfp_decimal.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+#include <cstddef>
+#include <span>
+
+namespace dbsc {
+
+class Account;
+class AccountBook;
+
+/// Balances of several accounts at the end of consecutive equal intervals.
+class BalanceSeries
+{
+public:
+  using Interval       = TimeStamp::duration;
+  using allocator_type = bsl::allocator< char >; // NOLINT
+
+  /// Prepare series of intervals of length @p interval starting at @p start.
+  /// @throw @c std::invalid_argument unless @p interval is positive.
+  DBSC_API BalanceSeries( TimeStamp start, Interval interval, allocator_type const& allocator = allocator_type() );
+  DBSC_API BalanceSeries( BalanceSeries const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API BalanceSeries( BalanceSeries&& original ) noexcept;
+  DBSC_API BalanceSeries( BalanceSeries&& original, allocator_type const& allocator );
+  DBSC_API auto operator=( BalanceSeries const& rhs ) -> BalanceSeries&;
+  DBSC_API auto operator=( BalanceSeries&& rhs ) -> BalanceSeries&;
+
+  [[nodiscard]] DBSC_API auto start() const noexcept -> TimeStamp;
+  [[nodiscard]] DBSC_API auto interval() const noexcept -> Interval;
+
+  /// The number of points in each series.
+  [[nodiscard]] DBSC_API auto pointCount() const noexcept -> std::size_t;
+
+  /// @return the end of the interval of point @p point; transactions before
+  /// it count toward the point.
+  [[nodiscard]] DBSC_API auto pointEnd( std::size_t point ) const -> TimeStamp;
+
+  [[nodiscard]] DBSC_API auto accountCount() const noexcept -> std::size_t;
+
+  /// The accounts, in the order of their series.
+  [[nodiscard]] DBSC_API auto accounts() const noexcept -> std::span< AccountHandle const >;
+
+  /// @return the `pointCount()` balances of the account at @p position in
+  /// `accounts()`, valid until the next modification of this object.
+  /// @pre `position < accountCount()`.
+  [[nodiscard]] DBSC_API auto series( std::size_t position ) const
+    -> std::span< BloombergLP::bdldfp::Decimal64 const >;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+  /// Replace the series with @p pointCount points for each of @p accounts of
+  /// @p book, computed by @p threadCount threads (0 selects one per hardware
+  /// thread). The book must not be modified meanwhile.
+  DBSC_API void compute( AccountBook const& book,
+                         std::span< AccountHandle const > accounts,
+                         std::size_t pointCount,
+                         unsigned threadCount = 0 );
+
+  /// Lengthen every series to @p pointCount points; no effect if they are
+  /// already that long. Transactions logged since the last `compute` or
+  /// `update` are folded in first.
+  DBSC_API void extend( AccountBook const& book, std::size_t pointCount, unsigned threadCount = 0 );
+
+  /// Fold in the transactions logged to @p book since the last `compute` or
+  /// `update`, in O(1) per transaction and later point.
+  DBSC_API void update( AccountBook const& book );
+
+private:
+  /// Fill points [@p first, @p last) of the series at @p position from
+  /// @p account, continuing from @p opening, the balance before
+  /// `pointEnd( first - 1 )` (or `start()` if @p first is 0).
+  void fill( Account const& account,
+             std::size_t position,
+             std::size_t first,
+             std::size_t last,
+             BloombergLP::bdldfp::Decimal64 opening );
+
+  /// Ensure room for @p pointCount points per series.
+  void reserve( std::size_t pointCount );
+
+  [[nodiscard]] auto boundary( std::size_t point ) const -> TimeStamp;
+
+  TimeStamp mStart;
+  Interval mInterval;
+  std::size_t mPointCount { 0 };
+  /// Distance between the first points of consecutive series.
+  std::size_t mStride { 0 };
+  bsl::vector< AccountHandle > mAccounts;
+  /// Rows of each account counted so far.
+  bsl::vector< std::size_t > mRowCounts;
+  /// `mStride` points per account, of which the first `mPointCount` are used.
+  bsl::vector< BloombergLP::bdldfp::Decimal64 > mValues;
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
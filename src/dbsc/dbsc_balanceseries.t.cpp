@@ -0,0 +1,207 @@
+// dbsc_balanceseries.t.cpp
+// Test driver for dbsc::BalanceSeries
+#include <dbsc_account.h>
+#include <dbsc_accountbook.h>
+#include <dbsc_balanceseries.h>
+#include <dbsc_transaction.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bslma_testallocator.h>
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+using namespace std::chrono;
+using Posting = std::pair< dbsc::TimeStamp, BloombergLP::bdldfp::Decimal64 >;
+
+/// Add an account holding one external transaction per element of
+/// @p postings to @p book, as the serializers would, and @return its handle.
+static auto addAccount( dbsc::AccountBook& book, std::vector< Posting > const& postings ) -> dbsc::AccountHandle
+{
+  dbsc::Account account { "Parsed", "" };
+  for ( auto const& [timeStamp, amount] : postings ) {
+    account.logTransaction(
+      { dbsc::UuidStringUtil::generate(), account.id(), dbsc::UuidString(), amount, timeStamp, "" } );
+  }
+  dbsc::UuidString const accountId = account.id();
+  book.addParsedAccount( std::move( account ) );
+  return book.handle( accountId );
+}
+
+/// Verify every point of @p series against `Account::balanceAsOf`.
+static void checkAgainstBook( dbsc::BalanceSeries const& series, dbsc::AccountBook const& book )
+{
+  for ( std::size_t i = 0; i < series.accountCount(); ++i ) {
+    dbsc::Account const& account = book.account( series.accounts()[i] );
+    BSLS_ASSERT( series.series( i ).size() == series.pointCount() );
+    for ( std::size_t point = 0; point < series.pointCount(); ++point ) {
+      BSLS_ASSERT( series.series( i )[point] == account.balanceAsOf( series.pointEnd( point ) - nanoseconds( 1 ) ) );
+    }
+  }
+}
+
+static void testDaily()
+{
+  sys_days const first { year( 2025 ) / 10 / 1 };
+  dbsc::AccountBook book { std::string { "Owner" } };
+  dbsc::AccountHandle const checking = addAccount( book,
+                                                   { { first - days( 3 ), "50.00"_d64 },
+                                                     { first + hours( 9 ), "10.00"_d64 },
+                                                     { first + days( 2 ), "-5.00"_d64 },
+                                                     { first + days( 3 ) - nanoseconds( 1 ), "1.00"_d64 },
+                                                     { first - days( 1 ), "2.00"_d64 },
+                                                     { first + days( 9 ), "100.00"_d64 } } );
+  dbsc::AccountHandle const empty    = addAccount( book, {} );
+
+  dbsc::BalanceSeries series { first, days( 1 ) };
+  BSLS_ASSERT( series.pointCount() == 0 );
+  std::vector< dbsc::AccountHandle > const accounts { checking, empty };
+  series.compute( book, accounts, 4, 2 );
+  BSLS_ASSERT( series.start() == first );
+  BSLS_ASSERT( series.interval() == days( 1 ) );
+  BSLS_ASSERT( series.pointCount() == 4 );
+  BSLS_ASSERT( series.pointEnd( 0 ) == first + days( 1 ) );
+  BSLS_ASSERT( series.accountCount() == 2 );
+  BSLS_ASSERT( series.accounts()[1] == empty );
+
+  // Earlier transactions open the series; each point closes its day.
+  std::vector< BloombergLP::bdldfp::Decimal64 > const expected { "62.00"_d64,
+                                                                 "62.00"_d64,
+                                                                 "58.00"_d64,
+                                                                 "58.00"_d64 };
+  BSLS_ASSERT( std::ranges::equal( series.series( 0 ), expected ) );
+  for ( BloombergLP::bdldfp::Decimal64 const balance : series.series( 1 ) ) {
+    BSLS_ASSERT( balance == "0.00"_d64 );
+  }
+
+  // Extending continues past the transactions beyond the old end.
+  series.extend( book, 12 );
+  BSLS_ASSERT( series.pointCount() == 12 );
+  BSLS_ASSERT( std::ranges::equal( series.series( 0 ).first( 4 ), expected ) );
+  BSLS_ASSERT( series.series( 0 )[8] == "58.00"_d64 );
+  BSLS_ASSERT( series.series( 0 )[9] == "158.00"_d64 );
+  BSLS_ASSERT( series.series( 0 )[11] == "158.00"_d64 );
+  checkAgainstBook( series, book );
+  series.extend( book, 5 );
+  BSLS_ASSERT( series.pointCount() == 12 );
+
+  // Series may also start from nothing and be extended.
+  dbsc::BalanceSeries hourly { first, hours( 1 ) };
+  hourly.compute( book, accounts, 0 );
+  hourly.extend( book, 24 );
+  BSLS_ASSERT( hourly.series( 0 )[8] == "52.00"_d64 );
+  BSLS_ASSERT( hourly.series( 0 )[9] == "62.00"_d64 );
+  checkAgainstBook( hourly, book );
+
+  bool threw = false;
+  try {
+    dbsc::BalanceSeries const invalid { first, hours( 0 ) };
+  } catch ( std::invalid_argument const& ) {
+    threw = true;
+  }
+  BSLS_ASSERT( threw );
+}
+
+static void testUpdate()
+{
+  dbsc::AccountBook book { std::string { "Owner" } };
+  auto const checking = book.handle( book.createAccount( "Checking", "" ) );
+  auto const savings  = book.handle( book.createAccount( "Savings", "" ) );
+  static_cast< void >( book.makeTransaction( "100.00"_d64, "Deposit", checking, std::nullopt ) );
+
+  // The series covers the present, so new transactions fall inside it.
+  auto const today = floor< days >( system_clock::now() );
+  dbsc::BalanceSeries series { today - days( 5 ), days( 1 ) };
+  std::vector< dbsc::AccountHandle > const accounts { savings, checking };
+  series.compute( book, accounts, 8 );
+  BSLS_ASSERT( series.series( 1 )[4] == "0.00"_d64 );
+  BSLS_ASSERT( series.series( 1 )[7] == "100.00"_d64 );
+
+  static_cast< void >( book.makeTransaction( "-30.00"_d64, "Transfer", checking, savings ) );
+  series.update( book );
+  BSLS_ASSERT( series.series( 0 )[7] == "30.00"_d64 );
+  BSLS_ASSERT( series.series( 1 )[7] == "70.00"_d64 );
+  checkAgainstBook( series, book );
+
+  // Updating twice counts nothing twice.
+  series.update( book );
+  checkAgainstBook( series, book );
+
+  static_cast< void >( book.makeTransaction( "5.00"_d64, "Interest", savings, std::nullopt ) );
+  series.extend( book, 40 );
+  BSLS_ASSERT( series.series( 0 )[39] == "35.00"_d64 );
+  checkAgainstBook( series, book );
+}
+
+static void testAgainstBalanceIndex()
+{
+  std::mt19937 generator { 5 };
+  std::uniform_int_distribution< int > minutesOffset { -60 * 24 * 10, 60 * 24 * 120 };
+  std::uniform_int_distribution< int > units { -500, 500 };
+  sys_days const first { year( 2025 ) / 1 / 1 };
+
+  dbsc::AccountBook book { std::string { "Owner" } };
+  std::vector< dbsc::AccountHandle > accounts;
+  for ( int i = 0; i < 12; ++i ) {
+    std::vector< Posting > postings;
+    for ( int j = 0; j < 50 * i; ++j ) {
+      postings.emplace_back( first + minutes( minutesOffset( generator ) ),
+                             BloombergLP::bdldfp::Decimal64( units( generator ) ) );
+    }
+    accounts.push_back( addAccount( book, postings ) );
+  }
+
+  BloombergLP::bslma::TestAllocator allocator;
+  {
+    dbsc::BalanceSeries series { first, hours( 6 ), &allocator };
+    for ( unsigned threadCount : { 1U, 5U } ) {
+      series.compute( book, accounts, 100, threadCount );
+      checkAgainstBook( series, book );
+    }
+    // Grow one day at a time, as an application would.
+    for ( std::size_t pointCount = 104; pointCount <= 440; pointCount += 4 ) {
+      series.extend( book, pointCount, 3 );
+    }
+    checkAgainstBook( series, book );
+
+    dbsc::BalanceSeries const copy { series };
+    BSLS_ASSERT( copy.pointCount() == series.pointCount() );
+    checkAgainstBook( copy, book );
+  }
+  BSLS_ASSERT( allocator.numBytesInUse() == 0 );
+}
+
+} // namespace
+
+int main()
+{
+  testDaily();
+  testUpdate();
+  testAgainstBalanceIndex();
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,262 @@
+// dbsc_bookset.cpp
+#include "dbsc_bookset.h"
+
+#include <dbsc_account.h>
+#include <dbsc_notesindex.h>
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace dbsc {
+
+namespace {
+/// Call `function( book, threadsPerBook )` for every book in [0,
+/// @p bookCount), dividing @p threadCount threads (0 selects one per hardware
+/// thread) between running books in parallel and running each book in
+/// parallel.
+template< typename Function >
+void forEachBook( std::size_t bookCount, unsigned threadCount, Function&& function )
+{
+  unsigned const total = ParallelUtil::threadCountFor( threadCount, std::numeric_limits< std::size_t >::max() );
+  unsigned const outer = ParallelUtil::threadCountFor( total, bookCount );
+  unsigned const inner = std::max( 1U, total / outer );
+  ParallelUtil::forEachTask( bookCount, outer, [&]( std::size_t book, unsigned ) { function( book, inner ); } );
+}
+} // namespace
+
+BookSet::BookSet( allocator_type const& allocator )
+  : mNotesPool( std::allocate_shared< NotesPool >( allocator ) )
+  , mBooks( allocator )
+  , mAccountIds( allocator )
+  , mOccurrences( allocator )
+{
+}
+
+BookSet::BookSet( BookSet const& original, allocator_type const& allocator )
+  : mNotesPool( original.mNotesPool )
+  , mBooks( original.mBooks, allocator )
+  , mAccountIds( original.mAccountIds, allocator )
+  , mOccurrences( original.mOccurrences, allocator )
+{
+}
+
+BookSet::BookSet( BookSet&& original ) noexcept = default;
+
+BookSet::BookSet( BookSet&& original, allocator_type const& allocator )
+  : mNotesPool( original.mNotesPool )
+  , mBooks( std::move( original.mBooks ), allocator )
+  , mAccountIds( std::move( original.mAccountIds ), allocator )
+  , mOccurrences( std::move( original.mOccurrences ), allocator )
+{
+  original.mBooks.clear();
+  original.mAccountIds.clear();
+  original.mOccurrences.clear();
+}
+
+auto BookSet::operator=( BookSet const& rhs ) -> BookSet& = default;
+
+auto BookSet::operator=( BookSet&& rhs ) -> BookSet& = default;
+
+auto BookSet::add( AccountBook book ) -> std::size_t
+{
+  BSLS_ASSERT( &book.notesPool() == mNotesPool.get() );
+  BSLS_ASSERT( mBooks.size() < Occurrence::kNil );
+  mBooks.push_back( std::move( book ) );
+  auto const index = static_cast< std::uint32_t >( mBooks.size() - 1 );
+  try {
+    indexAccounts( index );
+  } catch ( ... ) {
+    mBooks.pop_back();
+    throw;
+  }
+  return index;
+}
+
+auto BookSet::bookCount() const noexcept -> std::size_t
+{
+  return mBooks.size();
+}
+
+auto BookSet::book( std::size_t index ) const -> AccountBook const&
+{
+  BSLS_ASSERT( index < mBooks.size() );
+  return mBooks[index];
+}
+
+auto BookSet::notesPool() const -> NotesPool const&
+{
+  return *mNotesPool;
+}
+
+auto BookSet::sharedNotesPool() const -> std::shared_ptr< NotesPool >
+{
+  return mNotesPool;
+}
+
+auto BookSet::accountCount() const -> std::size_t
+{
+  return mAccountIds.size();
+}
+
+auto BookSet::locate( UuidString const& accountId ) const -> std::vector< BookAccount >
+{
+  std::vector< BookAccount > result;
+  std::optional< UuidIndex::Position > const first = mAccountIds.find( accountId );
+  for ( std::uint32_t position = first ? *first : Occurrence::kNil; position != Occurrence::kNil;
+        position               = mOccurrences[position].mNext ) {
+    result.push_back( mOccurrences[position].mAccount );
+  }
+  return result;
+}
+
+auto BookSet::account( BookAccount location ) const -> Account const&
+{
+  return book( location.mBook ).account( location.mAccount );
+}
+
+auto BookSet::balanceAsOf( TimeStamp timeStamp ) const -> BloombergLP::bdldfp::Decimal64
+{
+  BloombergLP::bdldfp::Decimal64 result {};
+  for ( AccountBook const& book : mBooks ) {
+    for ( auto const& [id, account] : book ) {
+      result += account.balanceAsOf( timeStamp );
+    }
+  }
+  return result;
+}
+
+auto BookSet::totals( RollupPeriod period, TimeStamp timeStamp ) const -> PeriodTotals
+{
+  PeriodTotals result;
+  for ( AccountBook const& book : mBooks ) {
+    for ( auto const& [id, account] : book ) {
+      PeriodTotals const totals = account.rollup( period ).totals( timeStamp );
+      result.mCount += totals.mCount;
+      result.mInflow += totals.mInflow;
+      result.mOutflow += totals.mOutflow;
+    }
+  }
+  return result;
+}
+
+auto BookSet::amountStats() const -> AmountStats
+{
+  AmountStats result( get_allocator() );
+  for ( AccountBook const& book : mBooks ) {
+    for ( auto const& [id, account] : book ) {
+      result.merge( account.amountStats() );
+    }
+  }
+  return result;
+}
+
+auto BookSet::largestBetween( AmountDirection direction, std::size_t count, TimeStamp begin, TimeStamp end ) const
+  -> std::vector< RankedAmount >
+{
+  std::vector< std::vector< RankedAmount > > perBook;
+  perBook.reserve( mBooks.size() );
+  std::size_t found = 0;
+  for ( AccountBook const& book : mBooks ) {
+    perBook.push_back( book.largestBetween( direction, count, begin, end ) );
+    found += perBook.back().size();
+  }
+  TopAmounts largest( direction, std::min( count, found ), get_allocator() );
+  for ( std::vector< RankedAmount > const& amounts : perBook ) {
+    for ( RankedAmount const& amount : amounts ) {
+      largest.add( amount );
+    }
+  }
+  return largest.entries();
+}
+
+auto BookSet::collect( TransactionFilter const& filter, unsigned threadCount ) const -> std::vector< BookSetMatch >
+{
+  std::vector< std::vector< QueryMatch > > perBook( mBooks.size() );
+  forEachBook( mBooks.size(), threadCount, [&]( std::size_t book, unsigned bookThreads ) {
+    perBook[book] = TransactionQuery( mBooks[book], filter ).collect( bookThreads );
+  } );
+
+  std::size_t total = 0;
+  for ( std::vector< QueryMatch > const& matches : perBook ) {
+    total += matches.size();
+  }
+  std::vector< BookSetMatch > result;
+  result.reserve( total );
+  for ( std::size_t book = 0; book < perBook.size(); ++book ) {
+    for ( QueryMatch const& match : perBook[book] ) {
+      result.push_back( { static_cast< std::uint32_t >( book ), match.mAccount, match.mRow } );
+    }
+  }
+  return result;
+}
+
+auto BookSet::count( TransactionFilter const& filter, unsigned threadCount ) const -> std::size_t
+{
+  std::vector< std::size_t > perBook( mBooks.size() );
+  forEachBook( mBooks.size(), threadCount, [&]( std::size_t book, unsigned bookThreads ) {
+    perBook[book] = TransactionQuery( mBooks[book], filter ).count( bookThreads );
+  } );
+  std::size_t result = 0;
+  for ( std::size_t const matches : perBook ) {
+    result += matches;
+  }
+  return result;
+}
+
+auto BookSet::findPhrase( std::string_view phrase ) const -> std::vector< BookSetMatch >
+{
+  std::vector< BookSetMatch > result;
+  for ( std::size_t book = 0; book < mBooks.size(); ++book ) {
+    for ( NotesIndex::Posting const& posting : mBooks[book].notesIndex().findPhrase( phrase ) ) {
+      result.push_back( { static_cast< std::uint32_t >( book ), posting.mAccount, posting.mRow } );
+    }
+  }
+  return result;
+}
+
+auto BookSet::get_allocator() const noexcept -> allocator_type
+{
+  return mBooks.get_allocator();
+}
+
+void BookSet::indexAccounts( std::uint32_t index )
+{
+  AccountBook const& book = mBooks[index];
+  mOccurrences.reserve( mOccurrences.size() + static_cast< std::size_t >( book.accountCount() ) );
+  mAccountIds.reserve( mAccountIds.size() + static_cast< std::size_t >( book.accountCount() ) );
+  for ( auto const& [id, account] : book ) {
+    auto const position = static_cast< std::uint32_t >( mOccurrences.size() );
+    mOccurrences.push_back( { { index, book.handle( id ) } } );
+    if ( std::optional< UuidIndex::Position > const first = mAccountIds.find( id ) ) {
+      std::uint32_t last = *first;
+      while ( mOccurrences[last].mNext != Occurrence::kNil ) {
+        last = mOccurrences[last].mNext;
+      }
+      mOccurrences[last].mNext = position;
+    } else {
+      mAccountIds.insert( id, position );
+    }
+  }
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,247 @@
+// dbsc_bookset.h
+#ifndef INCLUDED_DBSC_BOOKSET
+#define INCLUDED_DBSC_BOOKSET
+
+//@PURPOSE: Provide a set of account books queried as one.
+//
+//@CLASSES:
+//  dbsc::BookSet: several AccountBooks, loaded concurrently and sharing one
+//    notes pool, with the aggregates and queries of a book over their union.
+//  dbsc::BookAccount: identifies an account of one book of a set.
+//  dbsc::BookSetMatch: identifies a transaction of one book of a set.
+//
+//@DESCRIPTION: Households keep one book per person, and people keep one book
+//  per year. A BookSet answers questions about all of them without merging
+//  them into one AccountBook, which would copy every transaction and break
+//  the books' own ids and handles. Books are numbered in the order they were
+//  added; matches and accounts carry the number of their book.
+//
+//  `load` reads the book files concurrently, one task per file (see
+//  dbsc_parallelutil), with every book interning its notes in the set's one
+//  `NotesPool`, so notes repeated across books (recurring payees, yearly
+//  books carrying the same transfers) are stored once. The set also keeps one
+//  index from account id to the books holding the account, so `locate` does
+//  not search each book in turn. The same account id may appear in several
+//  books, e.g. a checking account carried from one yearly book to the next.
+//
+//  Aggregates (`balanceAsOf`, `totals`, `amountStats`, `largestBetween`) sum
+//  or merge those of every account of every book; an account held by several
+//  books counts in each of them. Queries (`collect`, `count`, `findPhrase`)
+//  run on each book and report matches in book order. With at least as many
+//  books as threads the books are queried in parallel; otherwise each book's
+//  query is itself parallel (see dbsc_transactionquery).
+//
+//  The books must not be modified while the set is queried. Memory is
+//  obtained from the allocator supplied at construction; as `load` builds the
+//  books on several threads, that allocator must be thread-safe.
+//
+/// Usage
+/// -----
+/// Example 1: A household's spending on groceries across every book
+///
+/// ```cpp
+/// std::vector< std::filesystem::path > const files { "alice.toml", "bob.toml", "joint.toml" };
+/// dbsc::BookSet const household = dbsc::BookSet::load< dbsc::TomlSerializer >( files );
+/// TransactionFilter const filter = TransactionFilter::amountBelow( 0.00_d64 )
+///                               && TransactionFilter::notesContain( "Groceries" );
+/// for ( dbsc::BookSetMatch const& match : household.collect( filter ) ) {
+///     dbsc::AccountBook const& book = household.book( match.mBook );
+///     std::println( "{}: {}", book.owner(), book.account( match.mAccount ).name() );
+/// }
+/// ```
+
+#include <dbsc_accountbook.h>
+#include <dbsc_accounthandle.h>
+#include <dbsc_amountstats.h>
+#include <dbsc_dbscserializer.h>
+#include <dbsc_notespool.h>
+#include <dbsc_parallelutil.h>
+#include <dbsc_periodrollup.h>
+#include <dbsc_sharedapi.h>
+#include <dbsc_topamounts.h>
+#include <dbsc_transaction.h>
+#include <dbsc_transactionquery.h>
+#include <dbsc_transactionstore.h>
+#include <dbsc_uuidindex.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bsl_deque.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace dbsc {
+
+/// An account of one book of a BookSet.
+struct BookAccount
+{
+  std::uint32_t mBook;
+  AccountHandle mAccount;
+
+  [[nodiscard]] friend auto operator<=>( BookAccount const&, BookAccount const& ) = default;
+};
+
+/// A transaction of one book of a BookSet.
+struct BookSetMatch
+{
+  std::uint32_t mBook;
+  AccountHandle mAccount;
+  TransactionStore::Row mRow;
+
+  [[nodiscard]] friend auto operator<=>( BookSetMatch const&, BookSetMatch const& ) = default;
+};
+
+/// Account books sharing one notes pool, queried as one.
+class BookSet
+{
+public:
+  using allocator_type = bsl::allocator< char >; // NOLINT
+
+  /// An empty set with a new notes pool.
+  DBSC_API explicit BookSet( allocator_type const& allocator = allocator_type() );
+  /// The copy shares the notes pool of @p original, so the allocator of
+  /// @p original must outlive it.
+  DBSC_API BookSet( BookSet const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API BookSet( BookSet&& original ) noexcept;
+  DBSC_API BookSet( BookSet&& original, allocator_type const& allocator );
+  DBSC_API auto operator=( BookSet const& rhs ) -> BookSet&;
+  DBSC_API auto operator=( BookSet&& rhs ) -> BookSet&;
+
+  /// @return the books at @p filePaths, read by @p threadCount threads (0
+  /// selects one per hardware thread) with `readAccountBook< Serializer >`,
+  /// numbered in the order of @p filePaths. If a file cannot be read, the
+  /// exception of the first failing thread is rethrown.
+  template< typename Serializer >
+    requires DbscSerializer< Serializer >
+  [[nodiscard]] static auto load( std::span< std::filesystem::path const > filePaths,
+                                  unsigned threadCount            = 0,
+                                  allocator_type const& allocator = allocator_type() ) -> BookSet;
+
+  /// Add @p book to the set and @return its number.
+  /// @pre @p book interns its notes in `sharedNotesPool()`.
+  DBSC_API auto add( AccountBook book ) -> std::size_t;
+
+  [[nodiscard]] DBSC_API auto bookCount() const noexcept -> std::size_t;
+
+  /// @pre `index < bookCount()`
+  [[nodiscard]] DBSC_API auto book( std::size_t index ) const -> AccountBook const&;
+
+  /// The pool holding the notes of every book.
+  [[nodiscard]] DBSC_API auto notesPool() const -> NotesPool const&;
+
+  /// The pool to build books with before adding them to the set.
+  [[nodiscard]] DBSC_API auto sharedNotesPool() const -> std::shared_ptr< NotesPool >;
+
+  /// The number of distinct account ids among the books.
+  [[nodiscard]] DBSC_API auto accountCount() const -> std::size_t;
+
+  /// @return the books holding the account @p accountId, in book order, or
+  /// nothing if none does.
+  [[nodiscard]] DBSC_API auto locate( UuidString const& accountId ) const -> std::vector< BookAccount >;
+
+  [[nodiscard]] DBSC_API auto account( BookAccount location ) const -> Account const&;
+
+  /// @return the sum of the balances of every account of every book as of
+  /// @p timeStamp (see `Account::balanceAsOf`).
+  [[nodiscard]] DBSC_API auto balanceAsOf( TimeStamp timeStamp ) const -> BloombergLP::bdldfp::Decimal64;
+
+  /// @return the sum of the totals of every account of every book for the
+  /// @p period containing @p timeStamp (see `Account::rollup`).
+  [[nodiscard]] DBSC_API auto totals( RollupPeriod period, TimeStamp timeStamp ) const -> PeriodTotals;
+
+  /// @return the merge of the amount statistics of every book.
+  [[nodiscard]] DBSC_API auto amountStats() const -> AmountStats;
+
+  /// @return the @p count largest amounts of @p direction among the
+  /// transactions of every book with a timestamp in [@p begin, @p end),
+  /// largest first (see `AccountBook::largestBetween`).
+  [[nodiscard]] DBSC_API auto largestBetween( AmountDirection direction,
+                                              std::size_t count,
+                                              TimeStamp begin,
+                                              TimeStamp end ) const -> std::vector< RankedAmount >;
+
+  /// @return the transactions of every book matching @p filter, in book
+  /// order, found by @p threadCount threads (0 selects one per hardware
+  /// thread).
+  [[nodiscard]] DBSC_API auto collect( TransactionFilter const& filter, unsigned threadCount = 0 ) const
+    -> std::vector< BookSetMatch >;
+
+  /// @return the number of transactions of every book matching @p filter.
+  [[nodiscard]] DBSC_API auto count( TransactionFilter const& filter, unsigned threadCount = 0 ) const
+    -> std::size_t;
+
+  /// @return the transactions of every book whose notes contain @p phrase
+  /// (see `NotesIndex::findPhrase`), in book order.
+  [[nodiscard]] DBSC_API auto findPhrase( std::string_view phrase ) const -> std::vector< BookSetMatch >;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+private:
+  /// One book holding an account, and the next one holding it.
+  struct Occurrence
+  {
+    static constexpr std::uint32_t kNil = UINT32_MAX;
+
+    BookAccount mAccount;
+    std::uint32_t mNext { kNil };
+  };
+
+  /// Add the accounts of the book numbered @p index to the account index.
+  void indexAccounts( std::uint32_t index );
+
+  std::shared_ptr< NotesPool > mNotesPool;
+  bsl::deque< AccountBook > mBooks;
+  /// Each account id's first occurrence; the others are chained from it.
+  UuidIndex mAccountIds;
+  bsl::vector< Occurrence > mOccurrences;
+};
+
+template< typename Serializer >
+  requires DbscSerializer< Serializer >
+auto BookSet::load( std::span< std::filesystem::path const > filePaths,
+                    unsigned threadCount,
+                    allocator_type const& allocator ) -> BookSet
+{
+  BookSet result( allocator );
+  std::vector< std::optional< AccountBook > > books( filePaths.size() );
+  ParallelUtil::forEachTask(
+    filePaths.size(), ParallelUtil::threadCountFor( threadCount, filePaths.size() ), [&]( std::size_t task, unsigned ) {
+      books[task].emplace( readAccountBook< Serializer >( filePaths[task], result.mNotesPool, allocator ) );
+    } );
+  for ( std::optional< AccountBook >& book : books ) {
+    result.add( std::move( *book ) );
+  }
+  return result;
+}
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
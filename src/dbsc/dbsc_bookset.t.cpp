@@ -0,0 +1,224 @@
+// dbsc_bookset.t.cpp
+// Test driver for dbsc::BookSet
+#include <dbsc_account.h>
+#include <dbsc_accountbook.h>
+#include <dbsc_bookset.h>
+#include <dbsc_dbscserializer.h>
+#include <dbsc_notespool.h>
+#include <dbsc_periodrollup.h>
+#include <dbsc_transaction.h>
+#include <dbsc_transactionquery.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bslma_testallocator.h>
+#include <bsls_assert.h>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+using dbsc::TransactionFilter;
+
+/// Reads no file: the book at "book<n>" has one account with a deposit of
+/// 100 * ( n + 1 ) and a withdrawal of 10.00; any other path fails.
+struct FakeSerializer
+{
+  using InputType  = std::string;
+  using OutputType = InputType;
+
+  static auto readAccountBook( std::filesystem::path const& filePath, dbsc::AccountBook::allocator_type allocator = {} )
+    -> dbsc::AccountBook
+  {
+    return readAccountBook( filePath, std::allocate_shared< dbsc::NotesPool >( allocator ), allocator );
+  }
+
+  static auto readAccountBook( std::filesystem::path const& filePath,
+                               std::shared_ptr< dbsc::NotesPool > notesPool,
+                               dbsc::AccountBook::allocator_type allocator = {} ) -> dbsc::AccountBook
+  {
+    std::string const name = filePath.stem().string();
+    if ( not name.starts_with( "book" ) ) {
+      throw dbsc::DbscSerializationException( "no such book: " + name );
+    }
+    BloombergLP::bdldfp::Decimal64 const pay( 100 * ( std::stoi( name.substr( 4 ) ) + 1 ) );
+    dbsc::AccountBook book { name, std::move( notesPool ), allocator };
+    dbsc::UuidString const checking = book.createAccount( "Checking", "" );
+    static_cast< void >( book.makeTransaction( pay, "Paycheck", checking, std::nullopt ) );
+    static_cast< void >( book.makeTransaction( "-10.00"_d64, "Costco gas", checking, std::nullopt ) );
+    return book;
+  }
+
+  static auto readAccountInternal( InputType&, dbsc::UuidString const& ) -> dbsc::Account
+  {
+    throw dbsc::DbscSerializationException();
+  }
+
+  static auto readTransactionInternal( InputType&, dbsc::UuidString const& ) -> dbsc::Transaction
+  {
+    throw dbsc::DbscSerializationException();
+  }
+
+  static void writeAccountBook( dbsc::AccountBook const&, std::filesystem::path const& ) {}
+  static void writeAccountInternal( OutputType&, dbsc::Account const& ) {}
+  static void writeTransactionInternal( OutputType&, dbsc::Transaction const& ) {}
+};
+static_assert( dbsc::DbscSerializer< FakeSerializer > );
+
+static auto bookPaths( int count ) -> std::vector< std::filesystem::path >
+{
+  std::vector< std::filesystem::path > paths;
+  for ( int i = 0; i < count; ++i ) {
+    paths.emplace_back( "book" + std::to_string( i ) + ".toml" );
+  }
+  return paths;
+}
+
+static void testLoad()
+{
+  std::vector< std::filesystem::path > const paths = bookPaths( 6 );
+  dbsc::BookSet const set = dbsc::BookSet::load< FakeSerializer >( paths, 3 );
+  BSLS_ASSERT( set.bookCount() == 6 );
+  for ( std::size_t i = 0; i < set.bookCount(); ++i ) {
+    BSLS_ASSERT( set.book( i ).owner() == "book" + std::to_string( i ) );
+    BSLS_ASSERT( &set.book( i ).notesPool() == &set.notesPool() );
+  }
+  BSLS_ASSERT( set.notesPool().stats().mInternCount == 12 );
+  BSLS_ASSERT( set.notesPool().stats().mUniqueCount == 2 );
+  BSLS_ASSERT( set.accountCount() == 6 );
+
+  std::vector< std::filesystem::path > broken = bookPaths( 4 );
+  broken.emplace_back( "ledger.toml" );
+  bool thrown = false;
+  try {
+    static_cast< void >( dbsc::BookSet::load< FakeSerializer >( broken, 2 ) );
+  } catch ( dbsc::DbscSerializationException const& ) {
+    thrown = true;
+  }
+  BSLS_ASSERT( thrown );
+}
+
+static void testLocate()
+{
+  dbsc::BookSet set;
+  dbsc::AccountBook first { "first", set.sharedNotesPool() };
+  dbsc::UuidString const savings = first.createAccount( "Savings", "" );
+  dbsc::UuidString const checking = first.createAccount( "Checking", "" );
+  dbsc::AccountBook second { "second", set.sharedNotesPool() };
+  dbsc::UuidString const cash = second.createAccount( "Cash", "" );
+
+  // The next year's book carries the accounts forward.
+  dbsc::AccountBook const third { first };
+  BSLS_ASSERT( set.add( first ) == 0 );
+  BSLS_ASSERT( set.add( second ) == 1 );
+  BSLS_ASSERT( set.add( third ) == 2 );
+  BSLS_ASSERT( set.accountCount() == 3 );
+
+  std::vector< dbsc::BookAccount > const found = set.locate( checking );
+  BSLS_ASSERT( found.size() == 2 );
+  BSLS_ASSERT( found[0].mBook == 0 );
+  BSLS_ASSERT( found[1].mBook == 2 );
+  BSLS_ASSERT( set.account( found[1] ).name() == "Checking" );
+  BSLS_ASSERT( set.locate( cash ) == ( std::vector< dbsc::BookAccount > { { 1, second.handle( cash ) } } ) );
+  BSLS_ASSERT( set.locate( savings ).size() == 2 );
+  BSLS_ASSERT( set.locate( dbsc::UuidStringUtil::generate() ).empty() );
+}
+
+static void testAggregates()
+{
+  dbsc::BookSet const set = dbsc::BookSet::load< FakeSerializer >( bookPaths( 4 ) );
+  BSLS_ASSERT( set.balanceAsOf( dbsc::TimeStamp::max() ) == "960.00"_d64 );
+  BSLS_ASSERT( set.balanceAsOf( dbsc::TimeStamp::min() ) == "0"_d64 );
+
+  auto const [checkingId, checking] = *set.book( 0 ).begin();
+  dbsc::TimeStamp const postedAt    = checking.transactions().timestamp( 0 );
+  dbsc::PeriodTotals const totals   = set.totals( dbsc::RollupPeriod::kMonth, postedAt );
+  BSLS_ASSERT( totals.mCount == 8 );
+  BSLS_ASSERT( totals.mInflow == "1000"_d64 );
+  BSLS_ASSERT( totals.mOutflow == "40.00"_d64 );
+
+  dbsc::AmountStats const stats = set.amountStats();
+  BSLS_ASSERT( stats.sketch( dbsc::AmountDirection::kInflow ).count() == 4 );
+  BSLS_ASSERT( stats.sketch( dbsc::AmountDirection::kOutflow ).count() == 4 );
+
+  dbsc::TimeStamp const first = dbsc::TimeStamp::min();
+  dbsc::TimeStamp const last  = dbsc::TimeStamp::max();
+  std::vector< dbsc::RankedAmount > const largest
+    = set.largestBetween( dbsc::AmountDirection::kInflow, 2, first, last );
+  BSLS_ASSERT( largest.size() == 2 );
+  BSLS_ASSERT( largest[0].mAmount == "400"_d64 );
+  BSLS_ASSERT( largest[1].mAmount == "300"_d64 );
+  BSLS_ASSERT( set.largestBetween( dbsc::AmountDirection::kOutflow, 100, first, last ).size() == 4 );
+}
+
+static void testQueries()
+{
+  dbsc::BookSet const set = dbsc::BookSet::load< FakeSerializer >( bookPaths( 5 ) );
+  TransactionFilter const filter = TransactionFilter::amountAtLeast( "250"_d64 );
+  for ( unsigned threadCount : { 1U, 2U, 16U } ) {
+    std::vector< dbsc::BookSetMatch > const matches = set.collect( filter, threadCount );
+    BSLS_ASSERT( matches.size() == 3 );
+    for ( std::size_t i = 0; i < matches.size(); ++i ) {
+      BSLS_ASSERT( matches[i].mBook == i + 2 );
+      BSLS_ASSERT( matches[i].mRow == 0 );
+    }
+    BSLS_ASSERT( set.count( filter, threadCount ) == 3 );
+    BSLS_ASSERT( set.count( TransactionFilter(), threadCount ) == 10 );
+  }
+
+  std::vector< dbsc::BookSetMatch > const gas = set.findPhrase( "costco gas" );
+  BSLS_ASSERT( gas.size() == 5 );
+  BSLS_ASSERT( gas.back().mBook == 4 );
+  BSLS_ASSERT( set.book( gas.back().mBook ).account( gas.back().mAccount ).transactions().notes( gas.back().mRow )
+               == "Costco gas" );
+}
+
+static void testAllocator()
+{
+  BloombergLP::bslma::TestAllocator allocator;
+  {
+    dbsc::BookSet const set = dbsc::BookSet::load< FakeSerializer >( bookPaths( 3 ), 3, &allocator );
+    BSLS_ASSERT( set.get_allocator() == &allocator );
+    BSLS_ASSERT( set.book( 2 ).get_allocator() == &allocator );
+
+    dbsc::BookSet const copy { set, &allocator };
+    BSLS_ASSERT( copy.bookCount() == 3 );
+    auto const [accountId, account] = *set.book( 1 ).begin();
+    BSLS_ASSERT( copy.locate( accountId ).size() == 1 );
+  }
+  BSLS_ASSERT( allocator.numBlocksInUse() == 0 );
+}
+} // namespace
+
+auto main() -> int
+{
+  testLoad();
+  testLocate();
+  testAggregates();
+  testQueries();
+  testAllocator();
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,87 @@
+// dbsc_bookviewutil.cpp
+#include "dbsc_bookviewutil.h"
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+
+namespace dbsc {
+
+namespace {
+/// Orders cursors so the heap's front holds the earliest next row, ties going
+/// to the account earlier in the book.
+struct Later
+{
+  template< typename Cursor >
+  auto operator()( Cursor const& a, Cursor const& b ) const -> bool
+  {
+    if ( a.mTimeStamp != b.mTimeStamp ) {
+      return a.mTimeStamp > b.mTimeStamp;
+    }
+    return a.mPosition > b.mPosition;
+  }
+};
+} // namespace
+
+TimeOrderedTransactions::TimeOrderedTransactions( AccountBook const& book,
+                                                  bool activeOnly,
+                                                  allocator_type const& allocator )
+  : mBook( &book )
+  , mActiveOnly( activeOnly )
+  , mHeap( allocator )
+{
+}
+
+auto TimeOrderedTransactions::begin() -> Iterator
+{
+  mHeap.clear();
+  mHeap.reserve( static_cast< std::size_t >( mBook->accountCount() ) );
+  std::uint32_t position = 0;
+  for ( auto const& [id, account] : *mBook ) {
+    BalanceIndex::RowRange const rows = account.balances().rows();
+    if ( ( not mActiveOnly || account.isActive() ) && not rows.empty() ) {
+      mHeap.push_back( { account.transactions().timestamp( *rows.begin() ), position, &account, rows } );
+    }
+    ++position;
+  }
+  std::ranges::make_heap( mHeap, Later() );
+  return Iterator( this );
+}
+
+auto TimeOrderedTransactions::get_allocator() const noexcept -> allocator_type
+{
+  return mHeap.get_allocator();
+}
+
+void TimeOrderedTransactions::advance()
+{
+  BSLS_ASSERT( not mHeap.empty() );
+  std::ranges::pop_heap( mHeap, Later() );
+  Cursor& next = mHeap.back();
+  next.mRows.advance( 1 );
+  if ( next.mRows.empty() ) {
+    mHeap.pop_back();
+    return;
+  }
+  next.mTimeStamp = next.mAccount->transactions().timestamp( *next.mRows.begin() );
+  std::ranges::push_heap( mHeap, Later() );
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,281 @@
+// dbsc_bookviewutil.h
+#ifndef INCLUDED_DBSC_BOOKVIEWUTIL
+#define INCLUDED_DBSC_BOOKVIEWUTIL
+
+//@PURPOSE: Provide lazy ranges over the accounts and transactions of a book.
+//
+//@CLASSES:
+//  dbsc::TransactionRef: refers to one transaction of an account by row.
+//  dbsc::TimeOrderedTransactions: the transactions of several accounts merged
+//    in chronological order.
+//  dbsc::BookViewUtil: functions returning views over a book.
+//
+//@DESCRIPTION: Code walking a book otherwise nests a loop over accounts and a
+//  loop over rows, or copies rows into a vector to sort them. The functions
+//  of BookViewUtil return views instead, which compose with `std::views` and
+//  produce each element on demand:
+//
+//  - `accounts`, `activeAccounts`: the (active) accounts, in book order;
+//  - `transactionsOf`: the transactions of an account, in logging order;
+//  - `transactionsInTimeOrderOf`: the same, in chronological order (see
+//    dbsc_balanceindex);
+//  - `transactions`, `activeTransactions`: the transactions of every (active)
+//    account, account by account;
+//  - `transactionsInTimeOrder`, `activeTransactionsInTimeOrder`: the same,
+//    merged across accounts in chronological order.
+//
+//  Elements are TransactionRef values, an account and a row, read through the
+//  account's columnar store (see dbsc_transactionstore) without building a
+//  dbsc::Transaction.
+//
+//  None of the views allocates per element. The chronological merge keeps a
+//  heap of one cursor per account, each walking its account's balance index,
+//  so each step costs O(log k) for k accounts; the heap is allocated, from
+//  the allocator supplied, when iteration begins. Equal timestamps are
+//  ordered by account in book order, then in logging order. That view is an
+//  input range: its iterators share the heap, and calling `begin()` again
+//  restarts it. The views over several accounts' transactions are joined, so
+//  they are input ranges too; those over accounts, or over the transactions
+//  of one account, are forward ranges.
+//
+//  Views refer to the book, which must outlive them and must not be modified
+//  while they are in use.
+//
+/// Usage
+/// -----
+/// Example 1: The first five large withdrawals of the active accounts
+///
+/// ```cpp
+/// auto large = dbsc::BookViewUtil::activeTransactionsInTimeOrder( book )
+///            | std::views::filter( []( dbsc::TransactionRef ref ) { return ref.amount() < -500.00_d64; } )
+///            | std::views::take( 5 );
+/// for ( dbsc::TransactionRef const ref : large ) {
+///     std::println( "{} {} {}", ref.account().name(), ref.timestamp(), ref.amount() );
+/// }
+/// ```
+
+#include <dbsc_account.h>
+#include <dbsc_accountbook.h>
+#include <dbsc_balanceindex.h>
+#include <dbsc_sharedapi.h>
+#include <dbsc_transaction.h>
+#include <dbsc_transactionstore.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+
+namespace dbsc {
+
+/// A transaction of an account, identified by its row.
+class TransactionRef
+{
+public:
+  TransactionRef() = default;
+
+  TransactionRef( Account const& account, TransactionStore::Row row ) noexcept
+    : mAccount( &account )
+    , mRow( row )
+  {
+  }
+
+  [[nodiscard]] auto account() const noexcept -> Account const& { return *mAccount; }
+  [[nodiscard]] auto row() const noexcept -> TransactionStore::Row { return mRow; }
+
+  [[nodiscard]] auto id() const -> UuidString const& { return mAccount->transactions().id( mRow ); }
+  [[nodiscard]] auto amount() const -> BloombergLP::bdldfp::Decimal64
+  {
+    return mAccount->transactions().amount( mRow );
+  }
+  [[nodiscard]] auto timestamp() const -> TimeStamp { return mAccount->transactions().timestamp( mRow ); }
+  [[nodiscard]] auto notes() const -> std::string_view { return mAccount->transactions().notes( mRow ); }
+  [[nodiscard]] auto counterpartyId() const -> UuidString const&
+  {
+    return mAccount->transactions().counterpartyId( mRow );
+  }
+
+  /// @return the transaction as a standalone value.
+  [[nodiscard]] auto materialize() const -> Transaction
+  {
+    return mAccount->transactions().materialize( mRow, mAccount->id() );
+  }
+
+  [[nodiscard]] friend auto operator==( TransactionRef const&, TransactionRef const& ) -> bool = default;
+
+private:
+  Account const* mAccount { nullptr };
+  TransactionStore::Row mRow { 0 };
+};
+
+/// The transactions of the (active) accounts of a book in chronological
+/// order, merged lazily.
+class TimeOrderedTransactions : public std::ranges::view_interface< TimeOrderedTransactions >
+{
+public:
+  using allocator_type = bsl::allocator< char >; // NOLINT
+
+  class Iterator
+  {
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type       = TransactionRef;
+    using difference_type  = std::ptrdiff_t;
+
+    Iterator() = default;
+
+    [[nodiscard]] auto operator*() const -> TransactionRef { return mView->current(); }
+
+    auto operator++() -> Iterator&
+    {
+      mView->advance();
+      return *this;
+    }
+
+    void operator++( int ) { ++*this; }
+
+    [[nodiscard]] friend auto operator==( Iterator const& iterator, std::default_sentinel_t ) -> bool
+    {
+      return iterator.atEnd();
+    }
+
+  private:
+    friend class TimeOrderedTransactions;
+    explicit Iterator( TimeOrderedTransactions* view )
+      : mView( view )
+    {
+    }
+
+    [[nodiscard]] auto atEnd() const -> bool { return mView->mHeap.empty(); }
+
+    TimeOrderedTransactions* mView { nullptr };
+  };
+
+  /// The transactions of every account of @p book, or of its active ones if
+  /// @p activeOnly.
+  DBSC_API TimeOrderedTransactions( AccountBook const& book,
+                                    bool activeOnly,
+                                    allocator_type const& allocator = allocator_type() );
+
+  /// Start, or restart, the iteration.
+  [[nodiscard]] DBSC_API auto begin() -> Iterator;
+  [[nodiscard]] auto end() const noexcept -> std::default_sentinel_t { return std::default_sentinel; }
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+private:
+  /// The rows of one account not yet produced.
+  struct Cursor
+  {
+    /// The timestamp of the next row.
+    TimeStamp mTimeStamp;
+    /// The position of the account in the book.
+    std::uint32_t mPosition;
+    Account const* mAccount;
+    BalanceIndex::RowRange mRows;
+  };
+
+  [[nodiscard]] auto current() const -> TransactionRef
+  {
+    Cursor const& next = mHeap.front();
+    return { *next.mAccount, *next.mRows.begin() };
+  }
+
+  /// Move past the current transaction.
+  DBSC_API void advance();
+
+  AccountBook const* mBook;
+  bool mActiveOnly;
+  /// Cursors of the accounts with rows left, the next one in front.
+  bsl::vector< Cursor > mHeap;
+};
+
+struct BookViewUtil
+{
+  /// @return the accounts of @p book, in book order.
+  [[nodiscard]] static auto accounts( AccountBook const& book )
+  {
+    return book | std::views::transform( []( auto const& entry ) -> Account const& { return entry.second; } );
+  }
+
+  /// @return the active accounts of @p book, in book order.
+  [[nodiscard]] static auto activeAccounts( AccountBook const& book )
+  {
+    return accounts( book ) | std::views::filter( []( Account const& account ) { return account.isActive(); } );
+  }
+
+  /// @return the transactions of @p account, in logging order.
+  [[nodiscard]] static auto transactionsOf( Account const& account )
+  {
+    auto const rowCount = static_cast< TransactionStore::Row >( account.transactions().size() );
+    auto const refer    = [owner = &account]( TransactionStore::Row row ) { return TransactionRef( *owner, row ); };
+    return std::views::iota( TransactionStore::Row { 0 }, rowCount ) | std::views::transform( refer );
+  }
+
+  /// @return the transactions of @p account, in chronological order.
+  [[nodiscard]] static auto transactionsInTimeOrderOf( Account const& account )
+  {
+    auto const refer = [owner = &account]( TransactionStore::Row row ) { return TransactionRef( *owner, row ); };
+    return account.balances().rows() | std::views::transform( refer );
+  }
+
+  /// @return the transactions of every account of @p book, account by
+  /// account in book order, each in logging order.
+  [[nodiscard]] static auto transactions( AccountBook const& book )
+  {
+    auto const rowsOf = []( Account const& account ) { return transactionsOf( account ); };
+    return accounts( book ) | std::views::transform( rowsOf ) | std::views::join;
+  }
+
+  /// @return the transactions of the active accounts of @p book, as above.
+  [[nodiscard]] static auto activeTransactions( AccountBook const& book )
+  {
+    auto const rowsOf = []( Account const& account ) { return transactionsOf( account ); };
+    return activeAccounts( book ) | std::views::transform( rowsOf ) | std::views::join;
+  }
+
+  /// @return the transactions of every account of @p book, in chronological
+  /// order.
+  [[nodiscard]] static auto transactionsInTimeOrder( AccountBook const& book,
+                                                     TimeOrderedTransactions::allocator_type const& allocator = {} )
+    -> TimeOrderedTransactions
+  {
+    return { book, false, allocator };
+  }
+
+  /// @return the transactions of the active accounts of @p book, in
+  /// chronological order.
+  [[nodiscard]] static auto activeTransactionsInTimeOrder(
+    AccountBook const& book,
+    TimeOrderedTransactions::allocator_type const& allocator = {} ) -> TimeOrderedTransactions
+  {
+    return { book, true, allocator };
+  }
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
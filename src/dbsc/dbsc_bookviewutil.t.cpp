@@ -0,0 +1,236 @@
+// dbsc_bookviewutil.t.cpp
+// Test driver for dbsc::BookViewUtil
+#include <dbsc_account.h>
+#include <dbsc_accountbook.h>
+#include <dbsc_bookviewutil.h>
+#include <dbsc_transaction.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+using namespace std::chrono;
+using dbsc::BookViewUtil;
+using dbsc::TransactionRef;
+
+using Refs = std::vector< TransactionRef >;
+
+/// @return a book of accounts of several sizes, with transactions logged out
+/// of chronological order and some sharing a timestamp, whose third account
+/// is inactive.
+static auto makeBook() -> dbsc::AccountBook
+{
+  sys_days const start { year( 2025 ) / 1 / 1 };
+  std::mt19937 generator { 5 };
+  std::uniform_int_distribution< int > daysOffset { 0, 40 };
+  std::uniform_int_distribution< int > units { -20'000, 20'000 };
+  dbsc::AccountBook book { std::string { "Owner" } };
+  for ( std::size_t rowCount : { 30, 0, 200, 1, 75 } ) {
+    dbsc::Account account { "Parsed", "" };
+    for ( std::size_t row = 0; row < rowCount; ++row ) {
+      account.logTransaction( { dbsc::UuidStringUtil::generate(),
+                                account.id(),
+                                {},
+                                BloombergLP::bdldfp::Decimal64( units( generator ) ) / 100,
+                                start + days( daysOffset( generator ) ),
+                                row % 2 == 0 ? "Groceries" : "Rent" } );
+    }
+    book.addParsedAccount( std::move( account ) );
+  }
+  auto position = book.begin();
+  std::ranges::advance( position, 2 );
+  book.deactivate( ( *position ).first );
+  return book;
+}
+
+/// @return the transactions of @p book, found with nested loops.
+static auto scanBook( dbsc::AccountBook const& book, bool activeOnly ) -> Refs
+{
+  Refs refs;
+  for ( auto const& [accountId, account] : book ) {
+    if ( activeOnly && not account.isActive() ) {
+      continue;
+    }
+    for ( std::size_t row = 0; row < account.transactions().size(); ++row ) {
+      refs.emplace_back( account, static_cast< dbsc::TransactionStore::Row >( row ) );
+    }
+  }
+  return refs;
+}
+
+/// @return @p refs in chronological order, ties keeping their order.
+static auto inTimeOrder( Refs refs ) -> Refs
+{
+  std::ranges::stable_sort( refs, std::less(), &TransactionRef::timestamp );
+  return refs;
+}
+
+template< typename Range >
+static auto collect( Range&& range ) -> Refs
+{
+  Refs refs;
+  for ( TransactionRef const ref : range ) {
+    refs.push_back( ref );
+  }
+  return refs;
+}
+
+static void testTransactionRef()
+{
+  dbsc::Account account { "Checking", "" };
+  dbsc::UuidString const counterparty = dbsc::UuidStringUtil::generate();
+  dbsc::TimeStamp const timeStamp     = sys_days( year( 2025 ) / 3 / 1 );
+  account.logTransaction( { dbsc::UuidStringUtil::generate(), account.id(), {}, "5.00"_d64, timeStamp, "Refund" } );
+  account.logTransaction(
+    { dbsc::UuidStringUtil::generate(), account.id(), counterparty, "-12.50"_d64, timeStamp, "Lunch" } );
+
+  TransactionRef const ref { account, 1 };
+  BSLS_ASSERT( &ref.account() == &account );
+  BSLS_ASSERT( ref.row() == 1 );
+  BSLS_ASSERT( ref.id() == account.transactions().id( 1 ) );
+  BSLS_ASSERT( ref.amount() == "-12.50"_d64 );
+  BSLS_ASSERT( ref.timestamp() == timeStamp );
+  BSLS_ASSERT( ref.notes() == "Lunch" );
+  BSLS_ASSERT( ref.counterpartyId() == counterparty );
+  BSLS_ASSERT( ref.materialize() == account.transactions().materialize( 1, account.id() ) );
+  BSLS_ASSERT( ref == TransactionRef( account, 1 ) );
+  BSLS_ASSERT( ref != TransactionRef( account, 0 ) );
+}
+
+static void testAccountViews()
+{
+  dbsc::AccountBook const book = makeBook();
+  static_assert( std::ranges::forward_range< decltype( BookViewUtil::accounts( book ) ) > );
+
+  BSLS_ASSERT( std::ranges::distance( BookViewUtil::accounts( book ) ) == 5 );
+  BSLS_ASSERT( std::ranges::distance( BookViewUtil::activeAccounts( book ) ) == 4 );
+  for ( dbsc::Account const& account : BookViewUtil::accounts( book ) ) {
+    BSLS_ASSERT( &account == &book.account( account.id() ) );
+  }
+  for ( dbsc::Account const& account : BookViewUtil::activeAccounts( book ) ) {
+    BSLS_ASSERT( account.isActive() );
+  }
+
+  auto const accounts           = BookViewUtil::accounts( book );
+  dbsc::Account const& largest = *std::ranges::max_element( accounts, std::less(), []( dbsc::Account const& account ) {
+    return account.transactions().size();
+  } );
+  BSLS_ASSERT( std::ranges::distance( BookViewUtil::transactionsOf( largest ) ) == 200 );
+  BSLS_ASSERT( std::ranges::equal( BookViewUtil::transactionsOf( largest ) | std::views::reverse
+                                     | std::views::transform( &TransactionRef::row ) | std::views::take( 1 ),
+                                   std::vector< dbsc::TransactionStore::Row > { 199 } ) );
+  BSLS_ASSERT( std::ranges::equal( BookViewUtil::transactionsInTimeOrderOf( largest )
+                                     | std::views::transform( &TransactionRef::row ),
+                                   largest.balances().rowsInTimeOrder() ) );
+}
+
+static void testTransactions()
+{
+  dbsc::AccountBook const book = makeBook();
+  static_assert( std::ranges::input_range< decltype( BookViewUtil::transactions( book ) ) > );
+  static_assert( std::ranges::input_range< decltype( BookViewUtil::activeTransactions( book ) ) > );
+
+  BSLS_ASSERT( collect( BookViewUtil::transactions( book ) ) == scanBook( book, false ) );
+  BSLS_ASSERT( collect( BookViewUtil::activeTransactions( book ) ) == scanBook( book, true ) );
+
+  // Views compose, and stop early.
+  auto rent = BookViewUtil::transactions( book )
+            | std::views::filter( []( TransactionRef ref ) { return ref.notes() == "Rent"; } )
+            | std::views::take( 3 );
+  Refs expected = scanBook( book, false );
+  std::erase_if( expected, []( TransactionRef ref ) { return ref.notes() != "Rent"; } );
+  expected.resize( 3 );
+  BSLS_ASSERT( collect( rent ) == expected );
+}
+
+static void testTimeOrder()
+{
+  dbsc::AccountBook const book = makeBook();
+  static_assert( std::ranges::view< dbsc::TimeOrderedTransactions > );
+  static_assert( std::ranges::input_range< dbsc::TimeOrderedTransactions > );
+
+  Refs const expected = inTimeOrder( scanBook( book, false ) );
+  dbsc::TimeOrderedTransactions merged = BookViewUtil::transactionsInTimeOrder( book );
+  BSLS_ASSERT( collect( merged ) == expected );
+  // A second pass restarts the merge.
+  BSLS_ASSERT( collect( merged ) == expected );
+  BSLS_ASSERT( collect( BookViewUtil::activeTransactionsInTimeOrder( book ) )
+               == inTimeOrder( scanBook( book, true ) ) );
+
+  auto withdrawals = BookViewUtil::activeTransactionsInTimeOrder( book )
+                   | std::views::filter( []( TransactionRef ref ) { return ref.amount() < "0"_d64; } )
+                   | std::views::take( 10 );
+  Refs const firstWithdrawals = collect( withdrawals );
+  BSLS_ASSERT( firstWithdrawals.size() == 10 );
+  BSLS_ASSERT( std::ranges::is_sorted( firstWithdrawals, std::less(), &TransactionRef::timestamp ) );
+
+  dbsc::AccountBook const empty { std::string { "Nobody" } };
+  BSLS_ASSERT( collect( BookViewUtil::transactionsInTimeOrder( empty ) ).empty() );
+}
+
+static void testAllocation()
+{
+  dbsc::AccountBook const book = makeBook();
+  BloombergLP::bslma::TestAllocator allocator;
+  BloombergLP::bslma::TestAllocator defaultAllocator;
+  BloombergLP::bslma::DefaultAllocatorGuard const guard { &defaultAllocator };
+  {
+    dbsc::TimeOrderedTransactions merged = BookViewUtil::transactionsInTimeOrder( book, &allocator );
+    BSLS_ASSERT( merged.get_allocator() == &allocator );
+    auto position     = merged.begin();
+    auto const blocks = allocator.numBlocksTotal();
+    std::size_t count = 0;
+    for ( ; position != merged.end(); ++position ) {
+      ++count;
+    }
+    BSLS_ASSERT( count == 306 );
+    BSLS_ASSERT( allocator.numBlocksTotal() == blocks );
+    BSLS_ASSERT( blocks == 1 );
+
+    for ( TransactionRef const ref : BookViewUtil::activeTransactions( book ) ) {
+      BSLS_ASSERT( not ref.notes().empty() );
+    }
+  }
+  BSLS_ASSERT( allocator.numBlocksInUse() == 0 );
+  BSLS_ASSERT( defaultAllocator.numBlocksTotal() == 0 );
+}
+} // namespace
+
+auto main() -> int
+{
+  testTransactionRef();
+  testAccountViews();
+  testTransactions();
+  testTimeOrder();
+  testAllocation();
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
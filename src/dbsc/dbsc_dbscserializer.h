@@ -17,10 +17,13 @@
 // serialization and deserialization operations for DBSC classes.
 
 #include <dbsc_accountbook.h>
+#include <dbsc_notespool.h>
 #include <dbsc_registerexception.h>
 
 #include <concepts>
 #include <filesystem>
+#include <memory>
+#include <utility>
 
 namespace dbsc {
 class Transaction;
@@ -41,9 +44,15 @@ DBSC_REGISTER_EXCEPTION( DbscSerializationException, "An error occurred during (
 template< typename Serializer >
 concept DbscReader = requires( typename Serializer::InputType& inSource,
                                std::filesystem::path const& filePath,
-                               UuidString const& idString ) {
+                               UuidString const& idString,
+                               std::shared_ptr< NotesPool > notesPool,
+                               AccountBook::allocator_type allocator ) {
   /// Parse the accountBook from file.
   { Serializer::readAccountBook( filePath ) } -> std::same_as< AccountBook >;
+  /// As above, building the book with @p allocator.
+  { Serializer::readAccountBook( filePath, allocator ) } -> std::same_as< AccountBook >;
+  /// As above, interning the book's notes in @p notesPool.
+  { Serializer::readAccountBook( filePath, notesPool, allocator ) } -> std::same_as< AccountBook >;
   // These functions are internal since each implementing type could have
   // different InputTypes. Consumers should never have to know what the
   // implementation source was (TOML, JSON, etc.)
@@ -77,11 +86,25 @@ auto writeAccountBook( dbsc::AccountBook const& accountRecord, std::filesystem::
   Serializer::writeAccountBook( accountRecord, filePath );
 }
 
+/// Parse the account book at @p filePath, building it with @p allocator (the
+/// default allocator if none is supplied).
 template< typename Serializer >
   requires dbsc::DbscSerializer< Serializer >
-auto readAccountBook( std::filesystem::path const& filePath ) -> dbsc::AccountBook
+auto readAccountBook( std::filesystem::path const& filePath, AccountBook::allocator_type allocator = {} )
+  -> dbsc::AccountBook
 {
-  return Serializer::readAccountBook( filePath );
+  return Serializer::readAccountBook( filePath, allocator );
+}
+
+/// As above, interning the notes of the book in @p notesPool, which may be
+/// shared with other books.
+template< typename Serializer >
+  requires dbsc::DbscSerializer< Serializer >
+auto readAccountBook( std::filesystem::path const& filePath,
+                      std::shared_ptr< NotesPool > notesPool,
+                      AccountBook::allocator_type allocator = {} ) -> dbsc::AccountBook
+{
+  return Serializer::readAccountBook( filePath, std::move( notesPool ), allocator );
 }
 
 } // namespace dbsc
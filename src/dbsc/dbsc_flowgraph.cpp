@@ -0,0 +1,250 @@
+// dbsc_flowgraph.cpp
+#include "dbsc_flowgraph.h"
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace dbsc {
+
+namespace {
+  void addAmount( PeriodTotals& totals, BloombergLP::bdldfp::Decimal64 amount )
+  {
+    ++totals.mCount;
+    if ( amount > BloombergLP::bdldfp::Decimal64() ) {
+      totals.mInflow += amount;
+    } else if ( amount < BloombergLP::bdldfp::Decimal64() ) {
+      totals.mOutflow -= amount;
+    }
+  }
+
+  [[nodiscard]] auto difference( PeriodTotals const& later, PeriodTotals const& earlier ) -> PeriodTotals
+  {
+    return { later.mCount - earlier.mCount, later.mInflow - earlier.mInflow, later.mOutflow - earlier.mOutflow };
+  }
+} // namespace
+
+FlowGraph::FlowGraph( allocator_type const& allocator )
+  : mParties( allocator )
+  , mEdges( allocator )
+  , mTimelines( allocator )
+  , mEdgeIndex( allocator )
+  , mIndexedRows( allocator )
+{
+}
+
+FlowGraph::FlowGraph( FlowGraph const& original, allocator_type const& allocator )
+  : mParties( original.mParties, allocator )
+  , mEdges( original.mEdges, allocator )
+  , mTimelines( original.mTimelines, allocator )
+  , mEdgeIndex( original.mEdgeIndex, allocator )
+  , mIndexedRows( original.mIndexedRows, allocator )
+{
+}
+
+FlowGraph::FlowGraph( FlowGraph&& original ) noexcept
+  : mParties( std::move( original.mParties ) )
+  , mEdges( std::move( original.mEdges ) )
+  , mTimelines( std::move( original.mTimelines ) )
+  , mEdgeIndex( std::move( original.mEdgeIndex ) )
+  , mIndexedRows( std::move( original.mIndexedRows ) )
+{
+}
+
+FlowGraph::FlowGraph( FlowGraph&& original, allocator_type const& allocator )
+  : mParties( std::move( original.mParties ), allocator )
+  , mEdges( std::move( original.mEdges ), allocator )
+  , mTimelines( std::move( original.mTimelines ), allocator )
+  , mEdgeIndex( std::move( original.mEdgeIndex ), allocator )
+  , mIndexedRows( std::move( original.mIndexedRows ), allocator )
+{
+  original.clear();
+}
+
+auto FlowGraph::operator=( FlowGraph const& rhs ) -> FlowGraph& = default;
+
+auto FlowGraph::operator=( FlowGraph&& rhs ) -> FlowGraph&
+{
+  mParties     = std::move( rhs.mParties );
+  mEdges       = std::move( rhs.mEdges );
+  mTimelines   = std::move( rhs.mTimelines );
+  mEdgeIndex   = std::move( rhs.mEdgeIndex );
+  mIndexedRows = std::move( rhs.mIndexedRows );
+  rhs.clear();
+  return *this;
+}
+
+auto FlowGraph::edges( AccountHandle account ) const -> std::span< Edge const >
+{
+  if ( account.index() >= mEdges.size() ) {
+    return {};
+  }
+  bsl::vector< Edge > const& edges = mEdges[account.index()];
+  return { edges.data(), edges.size() };
+}
+
+auto FlowGraph::edge( AccountHandle account, UuidString const& otherParty ) const -> std::optional< Edge >
+{
+  auto const position = find( account, otherParty );
+  return position ? std::optional( mEdges[account.index()][*position] ) : std::nullopt;
+}
+
+auto FlowGraph::totalsBetween( AccountHandle account, UuidString const& otherParty, TimeStamp begin, TimeStamp end )
+  const -> PeriodTotals
+{
+  auto const position = find( account, otherParty );
+  if ( not position || end <= begin ) {
+    return {};
+  }
+  bsl::vector< Point > const& timeline = mTimelines[account.index()][*position];
+  return difference( totalsBefore( timeline, end ), totalsBefore( timeline, begin ) );
+}
+
+auto FlowGraph::netFlow( AccountHandle account, UuidString const& otherParty, TimeStamp begin, TimeStamp end ) const
+  -> BloombergLP::bdldfp::Decimal64
+{
+  return totalsBetween( account, otherParty, begin, end ).net();
+}
+
+auto FlowGraph::topSources( AccountHandle account, std::size_t count ) const -> std::vector< Edge >
+{
+  std::vector< Edge const* > sources;
+  for ( Edge const& edge : edges( account ) ) {
+    if ( edge.mTotals.mInflow > BloombergLP::bdldfp::Decimal64() ) {
+      sources.push_back( &edge );
+    }
+  }
+  auto const ranksBefore = []( Edge const* a, Edge const* b ) {
+    return a->mTotals.mInflow > b->mTotals.mInflow
+        || ( a->mTotals.mInflow == b->mTotals.mInflow && a->mOtherParty < b->mOtherParty );
+  };
+  auto const last = sources.begin() + static_cast< std::ptrdiff_t >( std::min( count, sources.size() ) );
+  std::partial_sort( sources.begin(), last, sources.end(), ranksBefore );
+
+  std::vector< Edge > top;
+  top.reserve( static_cast< std::size_t >( last - sources.begin() ) );
+  std::transform( sources.begin(), last, std::back_inserter( top ), []( Edge const* edge ) { return *edge; } );
+  return top;
+}
+
+auto FlowGraph::edgeCount() const noexcept -> std::size_t
+{
+  return mEdgeIndex.size();
+}
+
+auto FlowGraph::get_allocator() const noexcept -> allocator_type
+{
+  return mEdges.get_allocator();
+}
+
+void FlowGraph::update( AccountHandle account, TransactionStore const& store )
+{
+  std::size_t const owner = account.index();
+  if ( owner >= mIndexedRows.size() ) {
+    // The row counts grow last: their size marks the accounts with lists.
+    mEdges.resize( owner + 1 );
+    mTimelines.resize( owner + 1 );
+    mIndexedRows.resize( owner + 1, 0 );
+  }
+  bsl::vector< Edge >& edges                    = mEdges[owner];
+  bsl::vector< bsl::vector< Point > >& timelines = mTimelines[owner];
+
+  // Each row is counted once added in full, so should an allocation fail, the
+  // next call resumes with that row.
+  for ( TransactionStore::Row& row = mIndexedRows[owner]; row < store.size(); ++row ) {
+    UuidString const& otherParty = store.counterpartyId( row );
+    auto party                   = mParties.find( otherParty );
+    if ( not party ) {
+      party = static_cast< UuidIndex::Position >( mParties.size() );
+      mParties.insert( otherParty, *party );
+    }
+    EdgeKey const key                           = ( EdgeKey( owner ) << 32U ) | *party;
+    TimeStamp const timeStamp                   = store.timestamp( row );
+    BloombergLP::bdldfp::Decimal64 const amount = store.amount( row );
+
+    auto entry = mEdgeIndex.find( key );
+    if ( entry == mEdgeIndex.end() ) {
+      auto const position = static_cast< std::uint32_t >( edges.size() );
+      try {
+        edges.push_back( { otherParty, {}, timeStamp } );
+        timelines.emplace_back();
+        entry = mEdgeIndex.emplace( key, position ).first;
+      } catch ( ... ) {
+        edges.resize( position );
+        timelines.resize( position );
+        throw;
+      }
+    }
+    // Grow the timeline before touching the totals.
+    record( timelines[entry->second], timeStamp, amount );
+    Edge& edge = edges[entry->second];
+    addAmount( edge.mTotals, amount );
+    edge.mLastActivity = std::max( edge.mLastActivity, timeStamp );
+  }
+}
+
+void FlowGraph::clear()
+{
+  mParties.clear();
+  mEdges.clear();
+  mTimelines.clear();
+  mEdgeIndex.clear();
+  mIndexedRows.clear();
+}
+
+auto FlowGraph::find( AccountHandle account, UuidString const& otherParty ) const -> std::optional< std::uint32_t >
+{
+  auto const party = mParties.find( otherParty );
+  if ( not party ) {
+    return std::nullopt;
+  }
+  auto const entry = mEdgeIndex.find( ( EdgeKey( account.index() ) << 32U ) | *party );
+  return entry == mEdgeIndex.end() ? std::nullopt : std::optional( entry->second );
+}
+
+auto FlowGraph::totalsBefore( bsl::vector< Point > const& timeline, TimeStamp timeStamp ) -> PeriodTotals
+{
+  auto const after = std::ranges::lower_bound( timeline, timeStamp, std::less(), &Point::mTime );
+  return after == timeline.begin() ? PeriodTotals() : std::prev( after )->mTotals;
+}
+
+void FlowGraph::record( bsl::vector< Point >& timeline, TimeStamp timeStamp, BloombergLP::bdldfp::Decimal64 amount )
+{
+  // Transactions usually arrive in time order: extend the latest point, or
+  // append one after it.
+  if ( timeline.empty() || timeline.back().mTime < timeStamp ) {
+    timeline.push_back( { timeStamp, timeline.empty() ? PeriodTotals() : timeline.back().mTotals } );
+    addAmount( timeline.back().mTotals, amount );
+    return;
+  }
+  auto point = std::ranges::lower_bound( timeline, timeStamp, std::less(), &Point::mTime );
+  if ( point->mTime != timeStamp ) {
+    point = timeline.insert(
+      point, { timeStamp, point == timeline.begin() ? PeriodTotals() : std::prev( point )->mTotals } );
+  }
+  for ( ; point != timeline.end(); ++point ) {
+    addAmount( point->mTotals, amount );
+  }
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,177 @@
+// dbsc_flowgraph.h
+#ifndef INCLUDED_DBSC_FLOWGRAPH
+#define INCLUDED_DBSC_FLOWGRAPH
+
+//@PURPOSE: Provide a summary of the money moving between parties of a book.
+//
+//@CLASSES:
+//  dbsc::FlowGraph: per (account, other party) totals, maintained as
+//    transactions are logged and queryable by time range.
+//
+//@DESCRIPTION: Every row of an account names its other party: another
+//  account for a transfer leg, or the nil id for an external party (splits
+//  included). A FlowGraph has one edge per distinct (account, other party)
+//  pair of a book, holding the count, inflow and outflow (see
+//  dbsc::PeriodTotals) of the account's rows with that party and the latest
+//  timestamp among them. Amounts are seen from the account: inflow is money
+//  the other party sent it. The legs of a transfer are both logged, so the
+//  edge from B to A mirrors the edge from A to B.
+//
+//  Lookups are hashed on the pair, so `edge` is O(1). Each edge also keeps
+//  its cumulative totals at each distinct timestamp, in chronological order,
+//  so `totalsBetween` and `netFlow` answer for any time range with two binary
+//  searches, O(log k) for an edge of k timestamps. `topSources` ranks the
+//  edges of one account, O(d log n) for d edges and the top n.
+//
+//  The graph is incremental, like dbsc::NotesIndex: `update` adds the rows an
+//  account's store has gained since the previous call. A row later than the
+//  edge's latest is appended in O(1); a backdated one is inserted and shifts
+//  the later cumulative totals of its edge only.
+//
+//  Memory is obtained from the allocator supplied at construction.
+//
+/// Usage
+/// -----
+/// Example 1: Where the grocery envelope's money came from in October
+///
+/// ```cpp
+/// dbsc::FlowGraph const& flows = book.flows();
+/// Decimal64 const fromSavings  = flows.netFlow( groceries, savingsId, october, november );
+/// for ( dbsc::FlowGraph::Edge const& source : flows.topSources( groceries, 3 ) ) {
+///     std::println( "{}: {}", source.mOtherParty, source.mTotals.mInflow );
+/// }
+/// ```
+
+#include <dbsc_accounthandle.h>
+#include <dbsc_periodrollup.h>
+#include <dbsc_sharedapi.h>
+#include <dbsc_transaction.h>
+#include <dbsc_transactionstore.h>
+#include <dbsc_uuidindex.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bsl_memory.h>
+#include <bsl_unordered_map.h>
+#include <bsl_vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace dbsc {
+
+/// Totals of the transactions between each account and each other party.
+class FlowGraph
+{
+public:
+  /// The transactions of one account with one other party.
+  struct Edge
+  {
+    /// The nil id for external parties.
+    UuidString mOtherParty;
+    /// From the account's side: inflow was received from the other party.
+    PeriodTotals mTotals;
+    /// The latest timestamp among the transactions.
+    TimeStamp mLastActivity;
+  };
+
+  using allocator_type = bsl::allocator< char >; // NOLINT
+
+  DBSC_API explicit FlowGraph( allocator_type const& allocator = allocator_type() );
+  DBSC_API FlowGraph( FlowGraph const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API FlowGraph( FlowGraph&& original ) noexcept;
+  DBSC_API FlowGraph( FlowGraph&& original, allocator_type const& allocator );
+  DBSC_API auto operator=( FlowGraph const& rhs ) -> FlowGraph&;
+  DBSC_API auto operator=( FlowGraph&& rhs ) -> FlowGraph&;
+
+  /// @return the edges of @p account, in order of first transaction.
+  [[nodiscard]] DBSC_API auto edges( AccountHandle account ) const -> std::span< Edge const >;
+
+  /// @return the edge from @p account to @p otherParty, if they transacted.
+  [[nodiscard]] DBSC_API auto edge( AccountHandle account, UuidString const& otherParty ) const
+    -> std::optional< Edge >;
+
+  /// @return the totals of the transactions of @p account with
+  /// @p otherParty timestamped in [@p begin, @p end).
+  [[nodiscard]] DBSC_API auto totalsBetween( AccountHandle account,
+                                             UuidString const& otherParty,
+                                             TimeStamp begin,
+                                             TimeStamp end ) const -> PeriodTotals;
+
+  /// @return the net amount @p account received from @p otherParty in
+  /// [@p begin, @p end); negative if it sent more than it received.
+  [[nodiscard]] DBSC_API auto netFlow( AccountHandle account,
+                                       UuidString const& otherParty,
+                                       TimeStamp begin,
+                                       TimeStamp end ) const -> BloombergLP::bdldfp::Decimal64;
+
+  /// @return at most @p count edges of @p account that received money, by
+  /// decreasing inflow (ties by other party id).
+  [[nodiscard]] DBSC_API auto topSources( AccountHandle account, std::size_t count ) const -> std::vector< Edge >;
+
+  /// The number of edges.
+  [[nodiscard]] DBSC_API auto edgeCount() const noexcept -> std::size_t;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+  /// Add the rows @p store of @p account has gained since the previous call
+  /// for that account.
+  /// @pre Rows already added for @p account are unchanged in @p store.
+  DBSC_API void update( AccountHandle account, TransactionStore const& store );
+
+  /// Forget every edge.
+  DBSC_API void clear();
+
+private:
+  /// The cumulative totals of an edge up to and including one timestamp.
+  struct Point
+  {
+    TimeStamp mTime;
+    PeriodTotals mTotals;
+  };
+
+  /// An account handle in the high half, a party number in the low half.
+  using EdgeKey = std::uint64_t;
+
+  [[nodiscard]] auto find( AccountHandle account, UuidString const& otherParty ) const
+    -> std::optional< std::uint32_t >;
+  /// @return the totals of the points of @p timeline before @p timeStamp.
+  [[nodiscard]] static auto totalsBefore( bsl::vector< Point > const& timeline, TimeStamp timeStamp )
+    -> PeriodTotals;
+  static void record( bsl::vector< Point >& timeline, TimeStamp timeStamp, BloombergLP::bdldfp::Decimal64 amount );
+
+  /// Numbers every party seen, in order of appearance.
+  UuidIndex mParties;
+  /// The edges of each account, by handle.
+  bsl::vector< bsl::vector< Edge > > mEdges;
+  /// The points of each edge, parallel to `mEdges`.
+  bsl::vector< bsl::vector< bsl::vector< Point > > > mTimelines;
+  /// Maps each (account, party) pair to the position of its edge.
+  bsl::unordered_map< EdgeKey, std::uint32_t > mEdgeIndex;
+  /// The number of rows added, per account handle.
+  bsl::vector< TransactionStore::Row > mIndexedRows;
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
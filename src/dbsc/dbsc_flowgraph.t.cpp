@@ -0,0 +1,176 @@
+// dbsc_flowgraph.t.cpp
+// Test driver for dbsc::FlowGraph
+#include <dbsc_account.h>
+#include <dbsc_accountbook.h>
+#include <dbsc_flowgraph.h>
+#include <dbsc_periodrollup.h>
+#include <dbsc_transaction.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bslma_testallocator.h>
+#include <bsls_assert.h>
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+using namespace std::chrono;
+
+static void testEdges()
+{
+  dbsc::AccountBook book { std::string { "Owner" } };
+  dbsc::UuidString const checkingId = book.createAccount( "Checking", "" );
+  dbsc::UuidString const savingsId  = book.createAccount( "Savings", "" );
+  auto const checking               = book.handle( checkingId );
+  auto const savings                = book.handle( savingsId );
+  auto const groceries              = book.handle( book.createAccount( "Groceries", "" ) );
+  static_cast< void >( book.makeTransaction( "1000.00"_d64, "Paycheck", checking, std::nullopt ) );
+  static_cast< void >( book.makeTransaction( "-200.00"_d64, "Save", checking, savings ) );
+  static_cast< void >( book.makeTransaction( "-150.00"_d64, "Groceries", checking, groceries ) );
+  static_cast< void >( book.makeTransaction( "-150.00"_d64, "Groceries", checking, groceries ) );
+  static_cast< void >( book.makeTransaction( "-50.00"_d64, "Groceries", savings, groceries ) );
+  static_cast< void >( book.makeTransaction( "20.00"_d64, "Refund", checking, groceries ) );
+  std::vector< dbsc::SplitAllocation > const allocations { { groceries, "30.00"_d64 }, { savings, "70.00"_d64 } };
+  static_cast< void >( book.makeSplitTransaction( "100.00"_d64, "Bonus", allocations ) );
+
+  dbsc::FlowGraph const& flows = book.flows();
+  // checking: external, savings, groceries; savings: checking, groceries,
+  // external; groceries: checking, savings, external.
+  BSLS_ASSERT( flows.edgeCount() == 9 );
+  BSLS_ASSERT( flows.edges( checking ).size() == 3 );
+  BSLS_ASSERT( dbsc::UuidStringUtil::isNil( flows.edges( checking )[0].mOtherParty ) );
+  BSLS_ASSERT( flows.edges( checking )[1].mOtherParty == savingsId );
+
+  std::optional< dbsc::FlowGraph::Edge > const fromChecking = flows.edge( groceries, checkingId );
+  BSLS_ASSERT( fromChecking.has_value() );
+  BSLS_ASSERT( fromChecking->mTotals.mCount == 3 );
+  BSLS_ASSERT( fromChecking->mTotals.mInflow == "300.00"_d64 );
+  BSLS_ASSERT( fromChecking->mTotals.mOutflow == "20.00"_d64 );
+  BSLS_ASSERT( fromChecking->mLastActivity == book.account( groceries ).transactions().timestamp( 3 ) );
+  BSLS_ASSERT( not flows.edge( groceries, book.account( groceries ).id() ) );
+
+  // The legs of a transfer mirror each other.
+  dbsc::TimeStamp const begin = dbsc::TimeStamp::min();
+  dbsc::TimeStamp const end   = dbsc::TimeStamp::max();
+  BSLS_ASSERT( flows.netFlow( groceries, checkingId, begin, end ) == "280.00"_d64 );
+  BSLS_ASSERT( flows.netFlow( checking, book.account( groceries ).id(), begin, end ) == "-280.00"_d64 );
+  BSLS_ASSERT( flows.totalsBetween( groceries, checkingId, begin, end ) == fromChecking->mTotals );
+  BSLS_ASSERT( flows.netFlow( groceries, checkingId, end, begin ) == "0.00"_d64 );
+  BSLS_ASSERT( flows.netFlow( groceries, dbsc::UuidStringUtil::generate(), begin, end ) == "0.00"_d64 );
+
+  std::vector< dbsc::FlowGraph::Edge > const sources = flows.topSources( groceries, 5 );
+  BSLS_ASSERT( sources.size() == 3 );
+  BSLS_ASSERT( sources[0].mOtherParty == checkingId );
+  BSLS_ASSERT( sources[1].mOtherParty == savingsId );
+  BSLS_ASSERT( dbsc::UuidStringUtil::isNil( sources[2].mOtherParty ) );
+  BSLS_ASSERT( flows.topSources( groceries, 1 ).size() == 1 );
+  BSLS_ASSERT( flows.topSources( groceries, 0 ).empty() );
+  // Checking only ever received from outside.
+  BSLS_ASSERT( flows.topSources( checking, 5 ).size() == 2 );
+}
+
+static void testTimeRanges()
+{
+  std::mt19937 generator { 3 };
+  std::uniform_int_distribution< int > hoursOffset { 0, 24 * 60 };
+  std::uniform_int_distribution< int > units { -1000, 1000 };
+  std::uniform_int_distribution< std::size_t > partyChoice { 0, 3 };
+  sys_days const first { year( 2025 ) / 1 / 1 };
+  std::array< dbsc::UuidString, 4 > const parties { dbsc::UuidString(),
+                                                    dbsc::UuidStringUtil::generate(),
+                                                    dbsc::UuidStringUtil::generate(),
+                                                    dbsc::UuidStringUtil::generate() };
+
+  BloombergLP::bslma::TestAllocator allocator;
+  {
+    dbsc::AccountBook book { std::string { "Owner" }, &allocator };
+    std::vector< dbsc::AccountHandle > handles;
+    for ( int i = 0; i < 3; ++i ) {
+      // Parsed accounts arrive in any order, so most rows are backdated.
+      dbsc::Account account { "Parsed", "", &allocator };
+      for ( int row = 0; row < 400; ++row ) {
+        account.logTransaction( { dbsc::UuidStringUtil::generate(),
+                                  account.id(),
+                                  parties[partyChoice( generator )],
+                                  BloombergLP::bdldfp::Decimal64( units( generator ) ),
+                                  first + hours( hoursOffset( generator ) ),
+                                  "" } );
+      }
+      dbsc::UuidString const accountId = account.id();
+      book.addParsedAccount( std::move( account ) );
+      handles.push_back( book.handle( accountId ) );
+    }
+
+    auto const expectedTotals =
+      [&book]( dbsc::AccountHandle handle, dbsc::UuidString const& party, dbsc::TimeStamp begin, dbsc::TimeStamp end ) {
+        dbsc::TransactionStore const& store = book.account( handle ).transactions();
+        dbsc::PeriodTotals totals;
+        for ( dbsc::TransactionStore::Row row = 0; row < store.size(); ++row ) {
+          dbsc::TimeStamp const timeStamp = store.timestamp( row );
+          if ( store.counterpartyId( row ) == party && timeStamp >= begin && timeStamp < end ) {
+            ++totals.mCount;
+            if ( store.amount( row ) > "0.00"_d64 ) {
+              totals.mInflow += store.amount( row );
+            } else if ( store.amount( row ) < "0.00"_d64 ) {
+              totals.mOutflow -= store.amount( row );
+            }
+          }
+        }
+        return totals;
+      };
+    for ( int query = 0; query < 300; ++query ) {
+      dbsc::AccountHandle const handle = handles[static_cast< std::size_t >( query ) % handles.size()];
+      dbsc::UuidString const& party    = parties[partyChoice( generator )];
+      dbsc::TimeStamp begin            = first + hours( hoursOffset( generator ) );
+      dbsc::TimeStamp end              = first + hours( hoursOffset( generator ) );
+      if ( end < begin ) {
+        std::swap( begin, end );
+      }
+      BSLS_ASSERT( book.flows().totalsBetween( handle, party, begin, end )
+                   == expectedTotals( handle, party, begin, end ) );
+    }
+
+    // A copy answers alike, from its own allocator.
+    BloombergLP::bslma::TestAllocator copyAllocator;
+    {
+      dbsc::FlowGraph const copy { book.flows(), &copyAllocator };
+      BSLS_ASSERT( copy.edgeCount() == book.flows().edgeCount() );
+      BSLS_ASSERT( copy.netFlow( handles[0], parties[1], first, first + days( 30 ) )
+                   == book.flows().netFlow( handles[0], parties[1], first, first + days( 30 ) ) );
+    }
+    BSLS_ASSERT( copyAllocator.numBytesInUse() == 0 );
+  }
+  BSLS_ASSERT( allocator.numBytesInUse() == 0 );
+}
+
+} // namespace
+
+int main()
+{
+  testEdges();
+  testTimeRanges();
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,95 @@
+// dbsc_money.b.cpp
+//
+// Benchmark: summing a column of amounts as Decimal64 and as dbsc::Money
+// units, and the one-time cost of converting between the two.
+// Usage: dbsc_money.b [amountCount] [repetitions]
+#include <dbsc_money.h>
+
+#include <bdldfp_decimal.h>
+#include <bdldfp_decimalutil.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+namespace {
+
+/// @return the mean wall-clock nanoseconds per item of @p operation, which
+/// processes @p count items per call, over @p repetitions calls.
+template< typename Operation >
+auto nanosecondsPerItem( std::size_t count, std::size_t repetitions, Operation operation ) -> double
+{
+  auto const start = std::chrono::steady_clock::now();
+  for ( std::size_t i = 0; i < repetitions; ++i ) {
+    operation();
+  }
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast< double >( std::chrono::duration_cast< std::chrono::nanoseconds >( elapsed ).count() )
+         / static_cast< double >( count * repetitions );
+}
+
+} // namespace
+
+int main( int argc, char* argv[] )
+{
+  std::size_t const amountCount = argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 1'000'000;
+  std::size_t const repetitions = argc > 2 ? std::strtoull( argv[2], nullptr, 10 ) : 20;
+
+  // Cent amounts between -500.00 and 499.99, as a ledger would hold.
+  std::vector< BloombergLP::bdldfp::Decimal64 > amounts;
+  amounts.reserve( amountCount );
+  for ( std::size_t i = 0; i < amountCount; ++i ) {
+    auto const cents = static_cast< long long >( ( i * 7919 ) % 100'000 ) - 50'000;
+    amounts.push_back( BloombergLP::bdldfp::DecimalUtil::makeDecimal64( cents, -2 ) );
+  }
+  std::vector< dbsc::Money::Rep > units( amountCount );
+
+  // Accumulate results so the optimizer cannot drop the work.
+  BloombergLP::bdldfp::Decimal64 decimalSink {};
+  dbsc::Money::Rep unitSink { 0 };
+  auto report = []( char const* label, double nanoseconds ) {
+    std::cout << label << ": " << nanoseconds << " ns/item\n";
+  };
+
+  report( "Money::fromDecimal", nanosecondsPerItem( amountCount, 1, [&]() {
+            for ( std::size_t i = 0; i < amountCount; ++i ) {
+              units[i] = dbsc::Money::fromDecimal( amounts[i] ).value().units();
+            }
+          } ) );
+  report( "Decimal64 accumulation", nanosecondsPerItem( amountCount, repetitions, [&]() {
+            BloombergLP::bdldfp::Decimal64 sum {};
+            for ( auto const amount : amounts ) {
+              sum += amount;
+            }
+            decimalSink += sum;
+          } ) );
+  report( "MoneyUtil::sum", nanosecondsPerItem( amountCount, repetitions, [&]() {
+            unitSink += dbsc::MoneyUtil::sum( units ).value();
+          } ) );
+  report( "Money::toDecimal", nanosecondsPerItem( amountCount, 1, [&]() {
+            for ( auto const value : units ) {
+              decimalSink += dbsc::Money::fromUnits( value ).toDecimal();
+            }
+          } ) );
+
+  std::cout << "(checksum " << decimalSink << ", " << unitSink << ")\n";
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,115 @@
+// dbsc_money.cpp
+#include "dbsc_money.h"
+
+#include <bdldfp_decimalutil.h>
+#include <bsls_types.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace dbsc {
+
+namespace {
+  using Uint64 = BloombergLP::bsls::Types::Uint64;
+
+  /// Elements per block of `sum`; small enough that neither partial sum of a
+  /// block can overflow.
+  constexpr std::size_t kSumBlockSize = std::size_t { 1 } << 30;
+} // namespace
+
+auto MoneyUtil::unitsFromDecimal( BloombergLP::bdldfp::Decimal64 value, int scale ) -> std::optional< Rep >
+{
+  int sign = 0;
+  Uint64 magnitude {};
+  int exponent = 0;
+  switch ( BloombergLP::bdldfp::DecimalUtil::decompose( &sign, &magnitude, &exponent, value ) ) {
+  case FP_ZERO:
+    return 0;
+  case FP_INFINITE:
+  case FP_NAN:
+    return std::nullopt;
+  default:
+    break;
+  }
+
+  // The significand has at most 16 digits, so both loops are short.
+  for ( int shift = exponent + scale; shift < 0; ++shift ) {
+    if ( magnitude % 10 != 0 ) {
+      return std::nullopt;
+    }
+    magnitude /= 10;
+  }
+  for ( int shift = exponent + scale; shift > 0; --shift ) {
+    if ( magnitude > UINT64_MAX / 10 ) {
+      return std::nullopt;
+    }
+    magnitude *= 10;
+  }
+
+  if ( sign < 0 ) {
+    if ( magnitude > Uint64 { INT64_MAX } + 1 ) {
+      return std::nullopt;
+    }
+    return magnitude == 0 ? Rep { 0 } : -static_cast< Rep >( magnitude - 1 ) - 1;
+  }
+  if ( magnitude > Uint64 { INT64_MAX } ) {
+    return std::nullopt;
+  }
+  return static_cast< Rep >( magnitude );
+}
+
+auto MoneyUtil::unitsToDecimal( Rep units, int scale ) -> BloombergLP::bdldfp::Decimal64
+{
+  return BloombergLP::bdldfp::DecimalUtil::makeDecimal64( static_cast< long long >( units ), -scale );
+}
+
+auto MoneyUtil::sum( std::span< Rep const > units ) -> std::optional< Rep >
+{
+  // Each value is split into a signed high half and an unsigned low half,
+  // which are summed separately. Neither partial sum can overflow within a
+  // block, and the loops have no branches, so they vectorize; overflow of the
+  // total is detected once per block.
+  Rep high = 0;
+  Uint64 low = 0;
+  for ( std::size_t begin = 0; begin < units.size(); begin += kSumBlockSize ) {
+    auto const block = units.subspan( begin, std::min( kSumBlockSize, units.size() - begin ) );
+    Rep blockHigh    = 0;
+    Uint64 blockLow  = 0;
+    for ( Rep const value : block ) {
+      blockHigh += value >> 32;
+      blockLow += static_cast< Uint64 >( value ) & 0xffff'ffffU;
+    }
+    // Carry the low sums into the high sum, keeping 32 bits below.
+    low += blockLow;
+    auto const combinedHigh = checkedAdd( high, blockHigh );
+    if ( not combinedHigh ) {
+      return std::nullopt;
+    }
+    high = *combinedHigh + static_cast< Rep >( low >> 32 );
+    low &= 0xffff'ffffU;
+  }
+  if ( high > ( INT64_MAX >> 32 ) || high < ( INT64_MIN >> 32 ) ) {
+    return std::nullopt;
+  }
+  return static_cast< Rep >( static_cast< Uint64 >( high ) << 32 | low );
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,171 @@
+// dbsc_money.h
+#ifndef INCLUDED_DBSC_MONEY
+#define INCLUDED_DBSC_MONEY
+
+//@PURPOSE: Provide an exact fixed-point currency type for internal arithmetic.
+//
+//@CLASSES:
+//  dbsc::BasicMoney: a signed 64-bit count of minor units at a compile-time
+//    decimal scale.
+//  dbsc::Money: the BasicMoney used for transaction amounts.
+//  dbsc::MoneyUtil: conversions and an overflow-checked sum kernel.
+//
+//@DESCRIPTION: `Decimal64` is the currency type of every public interface,
+//  but it is implemented in software, so each addition decodes and re-encodes
+//  both operands. BasicMoney stores an amount as an integer number of minor
+//  units (`10^-Scale` of a currency unit), so sums and comparisons are plain
+//  integer operations.
+//
+//  Conversions are lossless or they fail. `fromDecimal` yields nothing for an
+//  amount with more than `Scale` decimal places or outside the range of the
+//  representation, and `toDecimal` is exact for amounts of at most 16
+//  significant digits (the precision of `Decimal64`). Callers keep the
+//  `Decimal64` for amounts that do not convert.
+//
+//  Arithmetic operators require the result to be representable; `checkedAdd`
+//  reports overflow instead. `MoneyUtil::sum` adds a column of minor units
+//  exactly, in loops the compiler vectorizes, and also reports overflow
+//  rather than wrapping.
+//
+//  `dbsc::Money` has four decimal places, a hundredth of a cent, which covers
+//  every amount the application accepts and still spans about 9.2 * 10^14
+//  currency units.
+//
+/// Usage
+/// -----
+/// Example 1: Summing a column exactly
+///
+/// ```cpp
+/// std::vector< dbsc::Money::Rep > units;
+/// for ( Decimal64 amount : amounts ) {
+///     units.push_back( dbsc::Money::fromDecimal( amount ).value().units() );
+/// }
+/// std::optional< dbsc::Money::Rep > const total = dbsc::MoneyUtil::sum( units );
+/// ```
+
+#include <dbsc_sharedapi.h>
+
+#include <bdldfp_decimal.h>
+#include <bsls_assert.h>
+
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace dbsc {
+
+/// Non-template operations on minor units; see BasicMoney.
+struct MoneyUtil
+{
+  using Rep = std::int64_t;
+
+  /// @return @p value as a count of `10^-scale` units, or nothing if that is
+  /// not an integer in the range of `Rep`. Zero, of any exponent, converts.
+  [[nodiscard]] DBSC_API static auto unitsFromDecimal( BloombergLP::bdldfp::Decimal64 value, int scale )
+    -> std::optional< Rep >;
+  /// @return @p units `10^-scale` units as a Decimal64.
+  [[nodiscard]] DBSC_API static auto unitsToDecimal( Rep units, int scale ) -> BloombergLP::bdldfp::Decimal64;
+
+  /// @return the exact sum of @p units, or nothing if it overflows `Rep`.
+  [[nodiscard]] DBSC_API static auto sum( std::span< Rep const > units ) -> std::optional< Rep >;
+
+  /// @return `a + b`, or nothing if it overflows `Rep`.
+  [[nodiscard]] static constexpr auto checkedAdd( Rep a, Rep b ) noexcept -> std::optional< Rep >
+  {
+    if ( ( b > 0 && a > INT64_MAX - b ) || ( b < 0 && a < INT64_MIN - b ) ) {
+      return std::nullopt;
+    }
+    return a + b;
+  }
+};
+
+/// A currency amount held as a whole number of `10^-Scale` units.
+template< int Scale >
+class BasicMoney
+{
+  static_assert( Scale >= 0 && Scale <= 18 );
+
+public:
+  using Rep                   = MoneyUtil::Rep;
+  static constexpr int kScale = Scale;
+
+  constexpr BasicMoney() noexcept = default;
+
+  [[nodiscard]] static constexpr auto fromUnits( Rep units ) noexcept -> BasicMoney
+  {
+    BasicMoney money;
+    money.mUnits = units;
+    return money;
+  }
+
+  /// @return @p value exactly, or nothing if it has more than `Scale`
+  /// decimal places or is out of range.
+  [[nodiscard]] static auto fromDecimal( BloombergLP::bdldfp::Decimal64 value ) -> std::optional< BasicMoney >
+  {
+    auto const units = MoneyUtil::unitsFromDecimal( value, Scale );
+    return units ? std::optional( fromUnits( *units ) ) : std::nullopt;
+  }
+
+  [[nodiscard]] constexpr auto units() const noexcept -> Rep { return mUnits; }
+  [[nodiscard]] auto toDecimal() const -> BloombergLP::bdldfp::Decimal64
+  {
+    return MoneyUtil::unitsToDecimal( mUnits, Scale );
+  }
+
+  /// @return `a + b`, or nothing if it is out of range.
+  [[nodiscard]] static constexpr auto checkedAdd( BasicMoney a, BasicMoney b ) noexcept
+    -> std::optional< BasicMoney >
+  {
+    auto const units = MoneyUtil::checkedAdd( a.mUnits, b.mUnits );
+    return units ? std::optional( fromUnits( *units ) ) : std::nullopt;
+  }
+
+  /// @pre The result is representable.
+  constexpr auto operator+=( BasicMoney other ) -> BasicMoney&
+  {
+    BSLS_ASSERT( MoneyUtil::checkedAdd( mUnits, other.mUnits ).has_value() );
+    mUnits += other.mUnits;
+    return *this;
+  }
+  constexpr auto operator-=( BasicMoney other ) -> BasicMoney&
+  {
+    BSLS_ASSERT( other.mUnits != INT64_MIN );
+    return *this += fromUnits( -other.mUnits );
+  }
+  [[nodiscard]] constexpr auto operator-() const -> BasicMoney
+  {
+    BSLS_ASSERT( mUnits != INT64_MIN );
+    return fromUnits( -mUnits );
+  }
+  [[nodiscard]] friend constexpr auto operator+( BasicMoney a, BasicMoney b ) -> BasicMoney { return a += b; }
+  [[nodiscard]] friend constexpr auto operator-( BasicMoney a, BasicMoney b ) -> BasicMoney { return a -= b; }
+
+  [[nodiscard]] friend constexpr auto operator<=>( BasicMoney, BasicMoney ) noexcept = default;
+
+private:
+  Rep mUnits { 0 };
+};
+
+using Money = BasicMoney< 4 >;
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,88 @@
+// dbsc_money.t.cpp
+// Test driver for dbsc::Money
+#include <dbsc_money.h>
+
+#include <bdldfp_decimal.h>
+#include <bsls_assert.h>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+
+static void testConversions()
+{
+  BSLS_ASSERT( dbsc::Money::fromDecimal( "12.34"_d64 )->units() == 123'400 );
+  BSLS_ASSERT( dbsc::Money::fromDecimal( "-0.0001"_d64 )->units() == -1 );
+  BSLS_ASSERT( dbsc::Money::fromDecimal( "0.00"_d64 )->units() == 0 );
+  BSLS_ASSERT( dbsc::Money::fromUnits( 123'400 ).toDecimal() == "12.34"_d64 );
+  BSLS_ASSERT( dbsc::Money::fromUnits( -5 ).toDecimal() == "-0.0005"_d64 );
+
+  // Conversion is lossless or fails.
+  BSLS_ASSERT( not dbsc::Money::fromDecimal( "0.00001"_d64 ).has_value() );
+  BSLS_ASSERT( not dbsc::Money::fromDecimal( "1e16"_d64 ).has_value() );
+  BSLS_ASSERT( dbsc::BasicMoney< 0 >::fromDecimal( "1e16"_d64 )->units() == 10'000'000'000'000'000 );
+  BSLS_ASSERT( not dbsc::BasicMoney< 2 >::fromDecimal( "0.125"_d64 ).has_value() );
+  BSLS_ASSERT( dbsc::BasicMoney< 2 >::fromDecimal( "0.120"_d64 )->units() == 12 );
+}
+
+static void testArithmetic()
+{
+  auto const a = dbsc::Money::fromUnits( 250 );
+  auto const b = dbsc::Money::fromUnits( -100 );
+  BSLS_ASSERT( ( a + b ).units() == 150 );
+  BSLS_ASSERT( ( a - b ).units() == 350 );
+  BSLS_ASSERT( -a == dbsc::Money::fromUnits( -250 ) );
+  BSLS_ASSERT( b < a );
+  BSLS_ASSERT( dbsc::Money::checkedAdd( a, b ) == dbsc::Money::fromUnits( 150 ) );
+  BSLS_ASSERT( not dbsc::Money::checkedAdd( dbsc::Money::fromUnits( INT64_MAX ), a ).has_value() );
+  BSLS_ASSERT( not dbsc::MoneyUtil::checkedAdd( INT64_MIN, -1 ).has_value() );
+}
+
+static void testSum()
+{
+  BSLS_ASSERT( dbsc::MoneyUtil::sum( {} ) == 0 );
+
+  std::vector< dbsc::Money::Rep > units( 10'001 );
+  std::iota( units.begin(), units.end(), -5'000 );
+  units.back() = 123'456'789'012;
+  BSLS_ASSERT( dbsc::MoneyUtil::sum( units ) == 123'456'789'012 - 5'000 );
+
+  // Intermediate overflow is harmless when the total is in range.
+  std::vector< dbsc::Money::Rep > const cancelling { INT64_MAX, INT64_MAX, INT64_MIN, INT64_MIN, 7 };
+  BSLS_ASSERT( dbsc::MoneyUtil::sum( cancelling ) == -2 + 7 );
+  std::vector< dbsc::Money::Rep > const extremes { INT64_MIN, INT64_MAX, INT64_MAX };
+  BSLS_ASSERT( dbsc::MoneyUtil::sum( extremes ) == INT64_MAX - 1 );
+
+  std::vector< dbsc::Money::Rep > const overflowing { INT64_MAX, 1 };
+  BSLS_ASSERT( not dbsc::MoneyUtil::sum( overflowing ).has_value() );
+  std::vector< dbsc::Money::Rep > const underflowing { INT64_MIN, -1 };
+  BSLS_ASSERT( not dbsc::MoneyUtil::sum( underflowing ).has_value() );
+}
+} // namespace
+
+int main()
+{
+  testConversions();
+  testArithmetic();
+  testSum();
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,267 @@
+// dbsc_notesindex.cpp
+#include "dbsc_notesindex.h"
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <iterator>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace dbsc {
+
+namespace {
+  [[nodiscard]] constexpr auto isWordByte( char character ) -> bool
+  {
+    auto const byte = static_cast< unsigned char >( character );
+    return ( byte >= '0' && byte <= '9' ) || ( byte >= 'a' && byte <= 'z' ) || ( byte >= 'A' && byte <= 'Z' )
+        || byte >= 0x80;
+  }
+
+  [[nodiscard]] constexpr auto toLower( char character ) -> char
+  {
+    return character >= 'A' && character <= 'Z' ? static_cast< char >( character - 'A' + 'a' ) : character;
+  }
+
+  /// Call @p visitor with each word of @p text, lowercased, in order. The
+  /// word is held in @p scratch during the call.
+  template< typename Visitor >
+  void forEachWord( std::string_view text, std::string& scratch, Visitor&& visitor )
+  {
+    auto position = text.begin();
+    while ( true ) {
+      position = std::find_if( position, text.end(), isWordByte );
+      if ( position == text.end() ) {
+        return;
+      }
+      auto const wordEnd = std::find_if_not( position, text.end(), isWordByte );
+      scratch.assign( position, wordEnd );
+      std::ranges::transform( scratch, scratch.begin(), toLower );
+      visitor( std::string_view( scratch ) );
+      position = wordEnd;
+    }
+  }
+
+  [[nodiscard]] auto wordsOf( std::string_view text ) -> std::vector< std::string >
+  {
+    std::vector< std::string > words;
+    std::string scratch;
+    forEachWord( text, scratch, [&words]( std::string_view word ) { words.emplace_back( word ); } );
+    return words;
+  }
+} // namespace
+
+NotesIndex::NotesIndex( allocator_type const& allocator )
+  : mNoteTexts( allocator )
+  , mPostings( allocator )
+  , mNoteIds( allocator )
+  , mWords( allocator )
+  , mIndexedRows( allocator )
+{
+}
+
+NotesIndex::NotesIndex( NotesIndex const& original, allocator_type const& allocator )
+  : mNoteTexts( original.mNoteTexts, allocator )
+  , mPostings( original.mPostings, allocator )
+  , mNoteIds( original.mNoteIds, allocator )
+  , mWords( original.mWords, allocator )
+  , mIndexedRows( original.mIndexedRows, allocator )
+  , mPostingCount( original.mPostingCount )
+{
+}
+
+NotesIndex::NotesIndex( NotesIndex&& original ) noexcept
+  : mNoteTexts( std::move( original.mNoteTexts ) )
+  , mPostings( std::move( original.mPostings ) )
+  , mNoteIds( std::move( original.mNoteIds ) )
+  , mWords( std::move( original.mWords ) )
+  , mIndexedRows( std::move( original.mIndexedRows ) )
+  , mPostingCount( std::exchange( original.mPostingCount, 0 ) )
+{
+}
+
+NotesIndex::NotesIndex( NotesIndex&& original, allocator_type const& allocator )
+  : mNoteTexts( std::move( original.mNoteTexts ), allocator )
+  , mPostings( std::move( original.mPostings ), allocator )
+  , mNoteIds( std::move( original.mNoteIds ), allocator )
+  , mWords( std::move( original.mWords ), allocator )
+  , mIndexedRows( std::move( original.mIndexedRows ), allocator )
+  , mPostingCount( original.mPostingCount )
+{
+  original.clear();
+}
+
+auto NotesIndex::operator=( NotesIndex const& rhs ) -> NotesIndex& = default;
+
+auto NotesIndex::operator=( NotesIndex&& rhs ) -> NotesIndex&
+{
+  mNoteTexts    = std::move( rhs.mNoteTexts );
+  mPostings     = std::move( rhs.mPostings );
+  mNoteIds      = std::move( rhs.mNoteIds );
+  mWords        = std::move( rhs.mWords );
+  mIndexedRows  = std::move( rhs.mIndexedRows );
+  mPostingCount = rhs.mPostingCount;
+  rhs.clear();
+  return *this;
+}
+
+auto NotesIndex::findPhrase( std::string_view phrase ) const -> std::vector< Posting >
+{
+  std::vector< std::string > const words = wordsOf( phrase );
+  if ( words.empty() ) {
+    return {};
+  }
+
+  std::vector< bsl::vector< NoteId > const* > noteLists;
+  for ( std::string const& word : words ) {
+    auto const entry = mWords.find( std::string_view( word ) );
+    if ( entry == mWords.end() ) {
+      return {};
+    }
+    noteLists.push_back( &entry->second );
+  }
+  // Start from the rarest word; the candidates only shrink.
+  std::ranges::sort( noteLists, std::less(), []( auto const* notes ) { return notes->size(); } );
+  std::vector< NoteId > candidates( noteLists.front()->begin(), noteLists.front()->end() );
+  for ( auto const* notes : std::span( noteLists ).subspan( 1 ) ) {
+    std::vector< NoteId > kept;
+    std::ranges::set_intersection( candidates, *notes, std::back_inserter( kept ) );
+    candidates = std::move( kept );
+  }
+
+  if ( words.size() > 1 ) {
+    std::erase_if( candidates, [&]( NoteId note ) {
+      std::vector< std::string > const noteWords = wordsOf( mNoteTexts[note] );
+      return std::ranges::search( noteWords, words ).empty();
+    } );
+  }
+  return collect( candidates );
+}
+
+auto NotesIndex::findPrefix( std::string_view prefix ) const -> std::vector< Posting >
+{
+  std::vector< std::string > const words = wordsOf( prefix );
+  if ( words.size() != 1 || words.front().size() != prefix.size() ) {
+    return {};
+  }
+
+  std::string_view const word = words.front();
+  std::vector< NoteId > notes;
+  for ( auto entry = mWords.lower_bound( word );
+        entry != mWords.end() && std::string_view( entry->first ).starts_with( word );
+        ++entry ) {
+    notes.insert( notes.end(), entry->second.begin(), entry->second.end() );
+  }
+  std::ranges::sort( notes );
+  notes.erase( std::ranges::unique( notes ).begin(), notes.end() );
+  return collect( notes );
+}
+
+auto NotesIndex::wordCount() const noexcept -> std::size_t
+{
+  return mWords.size();
+}
+
+auto NotesIndex::noteCount() const noexcept -> std::size_t
+{
+  return mNoteIds.size();
+}
+
+auto NotesIndex::postingCount() const noexcept -> std::size_t
+{
+  return mPostingCount;
+}
+
+auto NotesIndex::get_allocator() const noexcept -> allocator_type
+{
+  return mNoteTexts.get_allocator();
+}
+
+void NotesIndex::update( AccountHandle account, TransactionStore const& store )
+{
+  if ( account.index() >= mIndexedRows.size() ) {
+    mIndexedRows.resize( account.index() + 1, 0 );
+  }
+  TransactionStore::Row& indexedRows = mIndexedRows[account.index()];
+  BSLS_ASSERT( indexedRows <= store.size() );
+
+  std::string scratch;
+  for ( ; indexedRows < store.size(); ++indexedRows ) {
+    std::string_view const text = store.notes( indexedRows );
+    if ( text.empty() ) {
+      continue;
+    }
+    auto noteId = mNoteIds.find( text );
+    if ( noteId == mNoteIds.end() ) {
+      // A new distinct note: record its words once. Ids increase, so each
+      // word's list stays sorted, and a repeated word is its list's last id.
+      auto const newId = static_cast< NoteId >( mNoteTexts.size() );
+      mNoteTexts.push_back( text );
+      try {
+        mPostings.emplace_back();
+      } catch ( ... ) {
+        mNoteTexts.pop_back();
+        throw;
+      }
+      // Should recording the words fail, the note stays unregistered and the
+      // next call records it afresh; the id left behind has no postings.
+      forEachWord( text, scratch, [this, newId]( std::string_view word ) {
+        auto entry = mWords.find( word );
+        if ( entry == mWords.end() ) {
+          entry = mWords.emplace( bsl::string( word ), bsl::vector< NoteId >() ).first;
+        }
+        if ( entry->second.empty() || entry->second.back() != newId ) {
+          entry->second.push_back( newId );
+        }
+      } );
+      noteId = mNoteIds.emplace( text, newId ).first;
+    }
+    mPostings[noteId->second].push_back( { account, indexedRows } );
+    ++mPostingCount;
+  }
+}
+
+void NotesIndex::clear()
+{
+  mNoteTexts.clear();
+  mPostings.clear();
+  mNoteIds.clear();
+  mWords.clear();
+  mIndexedRows.clear();
+  mPostingCount = 0;
+}
+
+auto NotesIndex::collect( std::span< NoteId const > notes ) const -> std::vector< Posting >
+{
+  std::vector< Posting > postings;
+  std::size_t postingCount = 0;
+  for ( NoteId const note : notes ) {
+    postingCount += mPostings[note].size();
+  }
+  postings.reserve( postingCount );
+  for ( NoteId const note : notes ) {
+    postings.insert( postings.end(), mPostings[note].begin(), mPostings[note].end() );
+  }
+  std::ranges::sort( postings );
+  return postings;
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
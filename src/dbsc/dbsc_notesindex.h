@@ -0,0 +1,156 @@
+// dbsc_notesindex.h
+#ifndef INCLUDED_DBSC_NOTESINDEX
+#define INCLUDED_DBSC_NOTESINDEX
+
+//@PURPOSE: Provide an inverted index of the words in transaction notes.
+//
+//@CLASSES:
+//  dbsc::NotesIndex: maps words of notes to the transactions carrying them,
+//    answering phrase and prefix queries.
+//
+//@DESCRIPTION: A word is a maximal run of ASCII letters and digits, or of
+//  bytes outside ASCII (so UTF-8 words stay whole), and matches without
+//  regard to ASCII case: the notes "COSTCO Gas #12" hold the words "costco",
+//  "gas" and "12".
+//
+//  Notes repeat heavily (see dbsc_notespool), so the index has two levels:
+//  each word maps to the distinct notes containing it, and each distinct note
+//  to its postings, the (account, row) positions of the transactions carrying
+//  it. A query resolves its words to a handful of distinct notes and then
+//  collects their postings, so its cost is governed by the vocabulary and the
+//  number of results, not by the number of transactions.
+//
+//  - `findPhrase` returns the transactions whose notes contain the words of
+//    the phrase consecutively and in order; a phrase of one word is a word
+//    query. The note lists of the words are intersected, and the few
+//    remaining notes are checked for adjacency.
+//  - `findPrefix` returns the transactions whose notes contain a word
+//    beginning with the prefix, which suits search-as-you-type. Words are
+//    kept sorted, so the matching ones form one contiguous run.
+//
+//  Results are ordered by account handle, then row.
+//
+//  The index is incremental: `update` indexes the rows an account's store has
+//  gained since the previous call, so an AccountBook keeps its index current
+//  by calling it after every posting. Rows are never removed or reordered.
+//  Distinct notes are recognized by their text, viewed in the stores' notes
+//  pool, which must outlive the index.
+//
+//  Memory is obtained from the allocator supplied at construction.
+//
+/// Usage
+/// -----
+/// Example 1: Searching a book
+///
+/// ```cpp
+/// for ( dbsc::NotesIndex::Posting const& posting : book.notesIndex().findPhrase( "costco gas" ) ) {
+///     dbsc::Account const& account = book.account( posting.mAccount );
+///     std::println( "{}: {}", account.name(), account.transactions().notes( posting.mRow ) );
+/// }
+/// ```
+
+#include <dbsc_accounthandle.h>
+#include <dbsc_sharedapi.h>
+#include <dbsc_transactionstore.h>
+
+#include <bsl_map.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_unordered_map.h>
+#include <bsl_vector.h>
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace dbsc {
+
+/// Maps the words of transaction notes to the transactions carrying them.
+class NotesIndex
+{
+public:
+  /// The position of one transaction in a book.
+  struct Posting
+  {
+    AccountHandle mAccount;
+    TransactionStore::Row mRow;
+
+    [[nodiscard]] friend auto operator<=>( Posting const&, Posting const& ) = default;
+  };
+
+  using allocator_type = bsl::allocator< char >; // NOLINT
+
+  DBSC_API explicit NotesIndex( allocator_type const& allocator = allocator_type() );
+  DBSC_API NotesIndex( NotesIndex const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API NotesIndex( NotesIndex&& original ) noexcept;
+  DBSC_API NotesIndex( NotesIndex&& original, allocator_type const& allocator );
+  DBSC_API auto operator=( NotesIndex const& rhs ) -> NotesIndex&;
+  DBSC_API auto operator=( NotesIndex&& rhs ) -> NotesIndex&;
+
+  /// @return the transactions whose notes contain the words of @p phrase
+  /// consecutively, in order. A phrase without words matches nothing.
+  [[nodiscard]] DBSC_API auto findPhrase( std::string_view phrase ) const -> std::vector< Posting >;
+
+  /// @return the transactions whose notes contain a word beginning with
+  /// @p prefix. A prefix without word characters matches nothing.
+  [[nodiscard]] DBSC_API auto findPrefix( std::string_view prefix ) const -> std::vector< Posting >;
+
+  /// The number of distinct words.
+  [[nodiscard]] DBSC_API auto wordCount() const noexcept -> std::size_t;
+  /// The number of distinct non-empty notes.
+  [[nodiscard]] DBSC_API auto noteCount() const noexcept -> std::size_t;
+  /// The number of indexed transactions with non-empty notes.
+  [[nodiscard]] DBSC_API auto postingCount() const noexcept -> std::size_t;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+  /// Index the rows @p store of @p account has gained since the previous
+  /// call for that account.
+  /// @pre Rows already indexed for @p account are unchanged in @p store.
+  DBSC_API void update( AccountHandle account, TransactionStore const& store );
+
+  /// Forget every posting.
+  DBSC_API void clear();
+
+private:
+  using NoteId = std::uint32_t;
+
+  /// @return the postings of @p notes, in result order.
+  [[nodiscard]] auto collect( std::span< NoteId const > notes ) const -> std::vector< Posting >;
+
+  /// The text of each distinct note, viewed in the notes pool.
+  bsl::vector< std::string_view > mNoteTexts;
+  /// The postings of each distinct note, in indexing order.
+  bsl::vector< bsl::vector< Posting > > mPostings;
+  bsl::unordered_map< std::string_view, NoteId, std::hash< std::string_view > > mNoteIds;
+  /// The notes containing each word, in increasing id order.
+  bsl::map< bsl::string, bsl::vector< NoteId >, std::less<> > mWords;
+  /// The number of rows indexed, per account handle.
+  bsl::vector< TransactionStore::Row > mIndexedRows;
+  std::size_t mPostingCount { 0 };
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
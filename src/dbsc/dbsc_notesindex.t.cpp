@@ -0,0 +1,136 @@
+// dbsc_notesindex.t.cpp
+// Test driver for dbsc::NotesIndex
+#include <dbsc_accountbook.h>
+#include <dbsc_notesindex.h>
+#include <dbsc_transactionstore.h>
+
+#include <bdldfp_decimal.h>
+#include <bslma_testallocator.h>
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+using Postings = std::vector< dbsc::NotesIndex::Posting >;
+
+/// @return the notes of each posting, in result order.
+static auto notesOf( dbsc::AccountBook const& book, Postings const& postings ) -> std::vector< std::string_view >
+{
+  std::vector< std::string_view > notes;
+  for ( dbsc::NotesIndex::Posting const& posting : postings ) {
+    notes.push_back( book.account( posting.mAccount ).transactions().notes( posting.mRow ) );
+  }
+  return notes;
+}
+
+static void testQueries()
+{
+  dbsc::AccountBook book { std::string { "Owner" } };
+  auto const checking = book.handle( book.createAccount( "Checking", "" ) );
+  auto const savings  = book.handle( book.createAccount( "Savings", "" ) );
+  static_cast< void >( book.makeTransaction( "-40.00"_d64, "COSTCO Gas #12", checking, std::nullopt ) );
+  static_cast< void >( book.makeTransaction( "-90.00"_d64, "Costco groceries", checking, std::nullopt ) );
+  static_cast< void >( book.makeTransaction( "-5.00"_d64, "Gas at the corner, not costco", checking, std::nullopt ) );
+  static_cast< void >( book.makeTransaction( "-40.00"_d64, "costco gas #12", savings, std::nullopt ) );
+  static_cast< void >( book.makeTransaction( "-1.00"_d64, "", savings, std::nullopt ) );
+
+  dbsc::NotesIndex const& index = book.notesIndex();
+  BSLS_ASSERT( index.postingCount() == 4 );
+  BSLS_ASSERT( index.noteCount() == 4 );
+
+  // Words match without regard to case; results are in (account, row) order.
+  Postings const costco = index.findPhrase( "Costco" );
+  BSLS_ASSERT( costco.size() == 4 );
+  BSLS_ASSERT( std::ranges::is_sorted( costco ) );
+  BSLS_ASSERT( costco.front().mAccount == checking && costco.front().mRow == 0 );
+  BSLS_ASSERT( costco.back().mAccount == savings );
+
+  // A phrase requires adjacent words in order.
+  BSLS_ASSERT( notesOf( book, index.findPhrase( "costco gas" ) )
+               == std::vector< std::string_view >( { "COSTCO Gas #12", "costco gas #12" } ) );
+  BSLS_ASSERT( index.findPhrase( "gas costco" ).empty() );
+  BSLS_ASSERT( index.findPhrase( "  GAS, #12 " ).size() == 2 );
+  BSLS_ASSERT( index.findPhrase( "walmart" ).empty() );
+  BSLS_ASSERT( index.findPhrase( "#" ).empty() );
+
+  // A prefix matches every word it begins.
+  BSLS_ASSERT( index.findPrefix( "cost" ).size() == 4 );
+  BSLS_ASSERT( notesOf( book, index.findPrefix( "GRO" ) ) == std::vector< std::string_view >( { "Costco groceries" } ) );
+  BSLS_ASSERT( index.findPrefix( "cor" ).size() == 1 );
+  BSLS_ASSERT( index.findPrefix( "" ).empty() );
+  BSLS_ASSERT( index.findPrefix( "costco gas" ).empty() );
+}
+
+static void testSharedRecords()
+{
+  dbsc::AccountBook book { std::string { "Owner" } };
+  auto const checking = book.handle( book.createAccount( "Checking", "" ) );
+  auto const savings  = book.handle( book.createAccount( "Savings", "" ) );
+  auto const rent     = book.handle( book.createAccount( "Rent", "" ) );
+  static_cast< void >( book.makeTransaction( "-25.00"_d64, "Rainy day fund", checking, savings ) );
+  std::vector< dbsc::SplitAllocation > const allocations { { checking, "500.00"_d64 }, { rent, "1200.00"_d64 } };
+  static_cast< void >( book.makeSplitTransaction( "1700.00"_d64, "Paycheck", allocations ) );
+
+  // Every leg is a posting of its own.
+  BSLS_ASSERT( book.notesIndex().findPhrase( "rainy day" ).size() == 2 );
+  BSLS_ASSERT( book.notesIndex().findPhrase( "paycheck" ).size() == 2 );
+
+  // Accounts added from storage are indexed too.
+  dbsc::AccountBook copy { std::string { "Owner" } };
+  for ( auto const& [_, account] : book ) {
+    copy.addParsedAccount( account );
+  }
+  BSLS_ASSERT( copy.notesIndex().postingCount() == book.notesIndex().postingCount() );
+  BSLS_ASSERT( copy.notesIndex().findPrefix( "pay" ).size() == 2 );
+
+  // Migration re-keys ids but keeps rows, so the index still holds.
+  copy.migrateToTimeOrderedTransactionIds();
+  BSLS_ASSERT( notesOf( copy, copy.notesIndex().findPhrase( "fund" ) )
+               == std::vector< std::string_view >( { "Rainy day fund", "Rainy day fund" } ) );
+}
+
+static void testAllocator()
+{
+  BloombergLP::bslma::TestAllocator allocator;
+  {
+    dbsc::AccountBook book { std::string { "Owner" }, &allocator };
+    auto const checking = book.handle( book.createAccount( "Checking", "" ) );
+    static_cast< void >( book.makeTransaction( "1.00"_d64, "Interest", checking, std::nullopt ) );
+    BSLS_ASSERT( book.notesIndex().get_allocator() == dbsc::NotesIndex::allocator_type( &allocator ) );
+
+    dbsc::NotesIndex const copy { book.notesIndex() };
+    BSLS_ASSERT( copy.findPhrase( "interest" ).size() == 1 );
+  }
+  BSLS_ASSERT( allocator.numBlocksInUse() == 0 );
+}
+} // namespace
+
+auto main() -> int
+{
+  testQueries();
+  testSharedRecords();
+  testAllocator();
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,140 @@
+// dbsc_notespool.cpp
+#include "dbsc_notespool.h"
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace dbsc {
+
+namespace {
+  constexpr std::size_t kBlockSize = 16 * 1024;
+  /// Text longer than this gets a block of its own rather than wasting the
+  /// remainder of a shared one.
+  constexpr std::size_t kLargeTextSize = kBlockSize / 4;
+} // namespace
+
+auto NotesPool::Stats::dedupRatio() const -> double
+{
+  return mUniqueCount == 0 ? 1.0 : static_cast< double >( mInternCount ) / static_cast< double >( mUniqueCount );
+}
+
+auto NotesPool::Stats::bytesSaved() const -> std::size_t
+{
+  return mRequestedBytes - mStoredBytes;
+}
+
+NotesPool::NotesPool( allocator_type const& allocator )
+  : mAllocator( allocator )
+  , mBlocks( allocator )
+  , mEntries( allocator )
+{
+}
+
+NotesPool::~NotesPool()
+{
+  for ( Block const& block : mBlocks ) {
+    mAllocator.deallocate( block.mData, block.mSize );
+  }
+}
+
+auto NotesPool::get_allocator() const noexcept -> allocator_type
+{
+  return mAllocator;
+}
+
+auto NotesPool::allocateBlock( std::size_t size ) -> char*
+{
+  // Reserve the bookkeeping first so a failure cannot leak the block.
+  if ( mBlocks.size() == mBlocks.capacity() ) {
+    mBlocks.reserve( std::max< std::size_t >( 8, mBlocks.capacity() * 2 ) );
+  }
+  char* const data = mAllocator.allocate( size );
+  mBlocks.push_back( { data, size } );
+  return data;
+}
+
+auto NotesPool::allocate( std::size_t size ) -> char*
+{
+  if ( size > kLargeTextSize ) {
+    return allocateBlock( size );
+  }
+  if ( mCurrentBlock == nullptr || mCurrentBlockUsed + size > kBlockSize ) {
+    mCurrentBlock     = allocateBlock( kBlockSize );
+    mCurrentBlockUsed = 0;
+  }
+  char* const storage = mCurrentBlock + mCurrentBlockUsed;
+  mCurrentBlockUsed += size;
+  return storage;
+}
+
+auto NotesPool::intern( std::string_view text ) -> std::string_view
+{
+  if ( text.empty() ) {
+    return {};
+  }
+
+  std::scoped_lock const lock { mMutex };
+  ++mStats.mInternCount;
+  mStats.mRequestedBytes += text.size();
+  if ( auto const existing = mEntries.find( text ); existing != mEntries.end() ) {
+    return *existing;
+  }
+
+  char* const storage = allocate( text.size() );
+  std::memcpy( storage, text.data(), text.size() );
+  std::string_view const interned { storage, text.size() };
+  mEntries.insert( interned );
+  ++mStats.mUniqueCount;
+  mStats.mStoredBytes += text.size();
+  return interned;
+}
+
+auto NotesPool::stats() const -> Stats
+{
+  std::scoped_lock const lock { mMutex };
+  return mStats;
+}
+
+Notes::Notes( std::string text )
+  : mOwnedText( std::move( text ) )
+{
+}
+
+Notes::Notes( std::shared_ptr< NotesPool const > pool, std::string_view internedText )
+  : mInternedText( internedText )
+  , mPool( std::move( pool ) )
+{
+  BSLS_ASSERT( mPool != nullptr );
+}
+
+auto Notes::view() const noexcept -> std::string_view
+{
+  return mPool != nullptr ? mInternedText : std::string_view( mOwnedText );
+}
+
+auto Notes::pool() const noexcept -> NotesPool const*
+{
+  return mPool.get();
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
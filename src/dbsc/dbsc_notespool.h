@@ -0,0 +1,154 @@
+// dbsc_notespool.h
+#ifndef INCLUDED_DBSC_NOTESPOOL
+#define INCLUDED_DBSC_NOTESPOOL
+
+//@PURPOSE: Provide an interning arena for transaction notes.
+//
+//@CLASSES:
+//  dbsc::NotesPool: a thread-safe, append-only pool of distinct strings.
+//  dbsc::Notes: an immutable notes string, either owned or interned.
+//
+//@DESCRIPTION: Transaction notes are highly repetitive ("Groceries",
+//  "Paycheck", ...). A NotesPool stores each distinct string once, packed into
+//  large blocks, so identical notes share storage and short notes cost no heap
+//  allocation of their own. Interned text never moves: a view returned by
+//  `intern` is valid for the lifetime of the pool.
+//
+//  An account book owns one pool, shared (through `std::shared_ptr`) with its
+//  accounts. dbsc::Notes holds either its own `std::string` or a view into a
+//  pool together with a reference that keeps the pool alive, so Transactions
+//  materialized from an account carry their notes without copying them.
+//
+//  `stats()` reports how much deduplication the pool achieves.
+//
+//  Blocks and the lookup table are obtained from the allocator supplied at
+//  construction and returned to it when the pool is destroyed.
+//
+/// Usage
+/// -----
+/// Example 1: Interning
+///
+/// ```cpp
+/// auto pool = std::make_shared< dbsc::NotesPool >();
+/// std::string_view first  = pool->intern( "Groceries" );
+/// std::string_view second = pool->intern( std::string( "Groceries" ) );
+/// assert( first.data() == second.data() );
+/// assert( pool->stats().bytesSaved() == 9 );
+/// ```
+
+#include <dbsc_sharedapi.h>
+
+#include <bsl_memory.h>
+#include <bsl_unordered_set.h>
+#include <bsl_vector.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace dbsc {
+
+/// An append-only arena of distinct strings. All member functions are
+/// thread-safe.
+class NotesPool
+{
+public:
+  struct Stats
+  {
+    /// Number of `intern` calls with non-empty text.
+    std::size_t mInternCount { 0 };
+    /// Number of distinct strings stored.
+    std::size_t mUniqueCount { 0 };
+    /// Total length of all interned text, counting repeats.
+    std::size_t mRequestedBytes { 0 };
+    /// Total length of the distinct strings stored.
+    std::size_t mStoredBytes { 0 };
+
+    /// @return the number of interned strings per distinct string (1.0 when
+    /// nothing has been interned).
+    [[nodiscard]] DBSC_API auto dedupRatio() const -> double;
+    /// @return the text bytes not stored thanks to deduplication.
+    [[nodiscard]] DBSC_API auto bytesSaved() const -> std::size_t;
+  };
+
+  using allocator_type = bsl::allocator< char >; // NOLINT
+
+  DBSC_API explicit NotesPool( allocator_type const& allocator = allocator_type() );
+  NotesPool( NotesPool const& )                    = delete;
+  auto operator=( NotesPool const& ) -> NotesPool& = delete;
+  DBSC_API ~NotesPool();
+
+  /// @return a view of the pooled copy of @p text, valid for the lifetime of
+  /// the pool. Empty text yields an empty view and is not stored.
+  DBSC_API auto intern( std::string_view text ) -> std::string_view;
+
+  [[nodiscard]] DBSC_API auto stats() const -> Stats;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+private:
+  struct Block
+  {
+    char* mData;
+    std::size_t mSize;
+  };
+
+  /// Allocate storage for @p size bytes in the current block, or a new one.
+  auto allocate( std::size_t size ) -> char*;
+  /// Obtain a block of @p size bytes from the allocator and record it.
+  auto allocateBlock( std::size_t size ) -> char*;
+
+  mutable std::mutex mMutex;
+  allocator_type mAllocator;
+  bsl::vector< Block > mBlocks;
+  /// The shared block small strings are packed into.
+  char* mCurrentBlock { nullptr };
+  std::size_t mCurrentBlockUsed { 0 };
+  bsl::unordered_set< std::string_view, std::hash< std::string_view > > mEntries;
+  Stats mStats {};
+};
+
+/// Immutable notes text, either owned or interned in a NotesPool that it
+/// keeps alive. Copying interned notes copies a view, not the text.
+class Notes
+{
+public:
+  Notes() = default;
+  [[nodiscard]] DBSC_API explicit Notes( std::string text );
+  /// @pre @p internedText was returned by `pool->intern` (or is empty).
+  [[nodiscard]] DBSC_API Notes( std::shared_ptr< NotesPool const > pool, std::string_view internedText );
+
+  [[nodiscard]] DBSC_API auto view() const noexcept -> std::string_view;
+  /// @return the pool holding the text, or null if the text is owned.
+  [[nodiscard]] DBSC_API auto pool() const noexcept -> NotesPool const*;
+
+  [[nodiscard]] friend auto operator==( Notes const& a, Notes const& b ) -> bool { return a.view() == b.view(); }
+
+private:
+  std::string mOwnedText {};
+  std::string_view mInternedText {};
+  std::shared_ptr< NotesPool const > mPool {};
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
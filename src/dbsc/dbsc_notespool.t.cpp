@@ -0,0 +1,125 @@
+// dbsc_notespool.t.cpp
+// Test driver for dbsc::NotesPool and dbsc::Notes
+#include <dbsc_notespool.h>
+
+#include <bslma_testallocator.h>
+#include <bsls_assert.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace std::string_view_literals;
+
+static void testInterning()
+{
+  dbsc::NotesPool pool;
+  std::string_view const groceries = pool.intern( "Groceries"sv );
+  BSLS_ASSERT( groceries == "Groceries"sv );
+  BSLS_ASSERT( pool.intern( std::string( "Groceries" ) ).data() == groceries.data() );
+  BSLS_ASSERT( pool.intern( "Rent"sv ).data() != groceries.data() );
+  BSLS_ASSERT( pool.intern( ""sv ).empty() );
+
+  auto const stats = pool.stats();
+  BSLS_ASSERT( stats.mInternCount == 3 );
+  BSLS_ASSERT( stats.mUniqueCount == 2 );
+  BSLS_ASSERT( stats.mRequestedBytes == 22 );
+  BSLS_ASSERT( stats.mStoredBytes == 13 );
+  BSLS_ASSERT( stats.bytesSaved() == 9 );
+  BSLS_ASSERT( stats.dedupRatio() == 1.5 );
+  BSLS_ASSERT( dbsc::NotesPool::Stats().dedupRatio() == 1.0 );
+}
+
+static void testStability()
+{
+  // Views survive growth, including text too large for a shared block.
+  dbsc::NotesPool pool;
+  std::vector< std::string > texts;
+  std::vector< std::string_view > views;
+  for ( int i = 0; i < 20'000; ++i ) {
+    texts.push_back( i % 1000 == 0 ? std::string( 10'000, 'x' ) + std::to_string( i ) : "note " + std::to_string( i ) );
+    views.push_back( pool.intern( texts.back() ) );
+  }
+  for ( std::size_t i = 0; i < texts.size(); ++i ) {
+    BSLS_ASSERT( views[i] == texts[i] );
+    BSLS_ASSERT( pool.intern( texts[i] ).data() == views[i].data() );
+  }
+}
+
+static void testConcurrentInterning()
+{
+  dbsc::NotesPool pool;
+  {
+    std::vector< std::jthread > workers;
+    for ( int worker = 0; worker < 4; ++worker ) {
+      workers.emplace_back( [&pool] {
+        for ( int i = 0; i < 1'000; ++i ) {
+          static_cast< void >( pool.intern( "note " + std::to_string( i ) ) );
+        }
+      } );
+    }
+  }
+  BSLS_ASSERT( pool.stats().mUniqueCount == 1'000 );
+  BSLS_ASSERT( pool.stats().mInternCount == 4'000 );
+}
+
+static void testNotes()
+{
+  auto const pool = std::make_shared< dbsc::NotesPool >();
+  dbsc::Notes const owned { std::string( "Paycheck" ) };
+  dbsc::Notes const interned { pool, pool->intern( "Paycheck"sv ) };
+  BSLS_ASSERT( owned == interned );
+  BSLS_ASSERT( owned.pool() == nullptr );
+  BSLS_ASSERT( interned.pool() == pool.get() );
+
+  // Copies of interned notes share the pooled text, which outlives the
+  // caller's reference to the pool.
+  std::weak_ptr< dbsc::NotesPool > const weakPool = pool;
+  dbsc::Notes copy = interned;
+  BSLS_ASSERT( copy.view().data() == interned.view().data() );
+  BSLS_ASSERT( dbsc::Notes().view().empty() );
+  BSLS_ASSERT( not weakPool.expired() );
+}
+
+static void testAllocator()
+{
+  BloombergLP::bslma::TestAllocator allocator;
+  {
+    dbsc::NotesPool pool { &allocator };
+    static_cast< void >( pool.intern( "Groceries"sv ) );
+    static_cast< void >( pool.intern( std::string( 10'000, 'x' ) ) );
+    BSLS_ASSERT( allocator.numBlocksInUse() > 0 );
+    BSLS_ASSERT( pool.get_allocator() == dbsc::NotesPool::allocator_type( &allocator ) );
+  }
+  BSLS_ASSERT( allocator.numBlocksInUse() == 0 );
+}
+} // namespace
+
+int main()
+{
+  testInterning();
+  testStability();
+  testConcurrentInterning();
+  testNotes();
+  testAllocator();
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,106 @@
+// dbsc_parallelutil.h
+#ifndef INCLUDED_DBSC_PARALLELUTIL
+#define INCLUDED_DBSC_PARALLELUTIL
+
+//@PURPOSE: Provide a minimal fork-join loop over independent tasks.
+//
+//@CLASSES:
+//  dbsc::ParallelUtil: runs numbered tasks on a group of short-lived threads.
+//
+//@DESCRIPTION: Whole-book operations (audits, rollup rebuilds, balance series)
+//  split into independent tasks, usually one per account or per block of
+//  rows. `forEachTask` starts the threads, lets each claim the next task from
+//  a shared counter until none remain, and joins them, so uneven tasks still
+//  keep every thread busy. The calling thread is one of the workers.
+//
+//  The task function receives the task number and the number of the thread
+//  running it (in [0, thread count)), so per-thread results can be gathered
+//  without synchronization. If a task throws, the thread stops claiming tasks,
+//  the others finish, and the first exception is rethrown to the caller.
+//
+/// Usage
+/// -----
+/// Example 1: One task per account
+///
+/// ```cpp
+/// unsigned const threadCount = dbsc::ParallelUtil::threadCountFor( 0, accounts.size() );
+/// std::vector< std::size_t > rowsPerThread( threadCount );
+/// dbsc::ParallelUtil::forEachTask( accounts.size(), threadCount, [&]( std::size_t task, unsigned thread ) {
+///     rowsPerThread[thread] += accounts[task]->transactions().size();
+/// } );
+/// ```
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace dbsc {
+
+struct ParallelUtil
+{
+  /// @return @p requested, or one per hardware thread if it is 0, limited to
+  /// @p taskCount and at least 1.
+  [[nodiscard]] static auto threadCountFor( unsigned requested, std::size_t taskCount ) -> unsigned
+  {
+    unsigned const wanted = requested != 0 ? requested : std::max( 1U, std::thread::hardware_concurrency() );
+    return static_cast< unsigned >( std::clamp< std::size_t >( taskCount, 1, wanted ) );
+  }
+
+  /// Call `function( task, thread )` once for every task in [0, @p taskCount)
+  /// using @p threadCount threads, including the calling one.
+  /// @pre `threadCount > 0`.
+  template< typename Function >
+  static void forEachTask( std::size_t taskCount, unsigned threadCount, Function&& function )
+  {
+    std::atomic< std::size_t > nextTask { 0 };
+    std::vector< std::exception_ptr > errors( threadCount );
+    auto work = [&]( unsigned thread ) {
+      try {
+        for ( std::size_t task = nextTask.fetch_add( 1, std::memory_order_relaxed ); task < taskCount;
+              task             = nextTask.fetch_add( 1, std::memory_order_relaxed ) ) {
+          function( task, thread );
+        }
+      } catch ( ... ) {
+        errors[thread] = std::current_exception();
+      }
+    };
+    {
+      std::vector< std::jthread > workers;
+      workers.reserve( threadCount - 1 );
+      for ( unsigned thread = 1; thread < threadCount; ++thread ) {
+        workers.emplace_back( work, thread );
+      }
+      work( 0 );
+    }
+    for ( std::exception_ptr const& error : errors ) {
+      if ( error ) {
+        std::rethrow_exception( error );
+      }
+    }
+  }
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
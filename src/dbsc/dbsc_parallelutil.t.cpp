@@ -0,0 +1,85 @@
+// dbsc_parallelutil.t.cpp
+// Test driver for dbsc::ParallelUtil
+#include <dbsc_parallelutil.h>
+
+#include <bsls_assert.h>
+
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+static void testThreadCountFor()
+{
+  BSLS_ASSERT( dbsc::ParallelUtil::threadCountFor( 4, 100 ) == 4 );
+  BSLS_ASSERT( dbsc::ParallelUtil::threadCountFor( 4, 3 ) == 3 );
+  BSLS_ASSERT( dbsc::ParallelUtil::threadCountFor( 4, 0 ) == 1 );
+  BSLS_ASSERT( dbsc::ParallelUtil::threadCountFor( 0, 1'000'000 ) >= 1 );
+}
+
+static void testForEachTask()
+{
+  for ( unsigned threadCount : { 1U, 3U, 8U } ) {
+    std::vector< std::atomic< int > > runs( 1000 );
+    std::vector< std::size_t > perThread( threadCount );
+    dbsc::ParallelUtil::forEachTask( runs.size(), threadCount, [&]( std::size_t task, unsigned thread ) {
+      BSLS_ASSERT( thread < threadCount );
+      ++runs[task];
+      ++perThread[thread];
+    } );
+    for ( std::atomic< int > const& count : runs ) {
+      BSLS_ASSERT( count == 1 );
+    }
+    BSLS_ASSERT( std::accumulate( perThread.begin(), perThread.end(), std::size_t { 0 } ) == runs.size() );
+  }
+
+  // No tasks: the function is never called.
+  dbsc::ParallelUtil::forEachTask( 0, 2, []( std::size_t, unsigned ) { BSLS_ASSERT( false ); } );
+}
+
+static void testException()
+{
+  std::atomic< std::size_t > completed { 0 };
+  bool threw = false;
+  try {
+    dbsc::ParallelUtil::forEachTask( 100, 4, [&completed]( std::size_t task, unsigned ) {
+      if ( task == 17 ) {
+        throw std::runtime_error( "Task failed." );
+      }
+      ++completed;
+    } );
+  } catch ( std::runtime_error const& ) {
+    threw = true;
+  }
+  BSLS_ASSERT( threw );
+  BSLS_ASSERT( completed < 100 );
+}
+
+} // namespace
+
+int main()
+{
+  testThreadCountFor();
+  testForEachTask();
+  testException();
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
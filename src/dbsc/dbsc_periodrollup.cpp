@@ -0,0 +1,163 @@
+// dbsc_periodrollup.cpp
+#include "dbsc_periodrollup.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <utility>
+
+namespace dbsc {
+
+namespace {
+  /// 1970-01-01 was a Thursday; shifting by three days puts the boundaries of
+  /// the week numbers on Mondays.
+  constexpr int kDaysFromMondayToEpoch = 3;
+} // namespace
+
+PeriodRollup::PeriodRollup( RollupPeriod period, allocator_type const& allocator )
+  : mPeriod( period )
+  , mEntries( allocator )
+{
+}
+
+PeriodRollup::PeriodRollup( PeriodRollup const& original, allocator_type const& allocator )
+  : mPeriod( original.mPeriod )
+  , mEntries( original.mEntries, allocator )
+{
+}
+
+PeriodRollup::PeriodRollup( PeriodRollup&& original ) noexcept = default;
+
+PeriodRollup::PeriodRollup( PeriodRollup&& original, allocator_type const& allocator )
+  : mPeriod( original.mPeriod )
+  , mEntries( std::move( original.mEntries ), allocator )
+{
+  original.mEntries.clear();
+}
+
+auto PeriodRollup::operator=( PeriodRollup const& rhs ) -> PeriodRollup& = default;
+
+auto PeriodRollup::operator=( PeriodRollup&& rhs ) -> PeriodRollup&
+{
+  mPeriod  = rhs.mPeriod;
+  mEntries = std::move( rhs.mEntries );
+  rhs.mEntries.clear();
+  return *this;
+}
+
+auto PeriodRollup::period() const noexcept -> RollupPeriod
+{
+  return mPeriod;
+}
+
+auto PeriodRollup::periodStart( RollupPeriod period, TimeStamp timeStamp ) -> TimeStamp
+{
+  return startOf( period, numberOf( period, timeStamp ) );
+}
+
+auto PeriodRollup::totals( TimeStamp timeStamp ) const -> PeriodTotals
+{
+  PeriodNumber const number = numberOf( mPeriod, timeStamp );
+  auto const entry          = std::ranges::lower_bound( mEntries, number, std::less(), &Entry::mPeriod );
+  return entry != mEntries.end() && entry->mPeriod == number ? entry->mTotals : PeriodTotals();
+}
+
+auto PeriodRollup::buckets() const -> std::vector< Bucket >
+{
+  std::vector< Bucket > buckets;
+  buckets.reserve( mEntries.size() );
+  for ( Entry const& entry : mEntries ) {
+    buckets.push_back( { startOf( mPeriod, entry.mPeriod ), entry.mTotals } );
+  }
+  return buckets;
+}
+
+auto PeriodRollup::size() const noexcept -> std::size_t
+{
+  return mEntries.size();
+}
+
+auto PeriodRollup::get_allocator() const noexcept -> allocator_type
+{
+  return mEntries.get_allocator();
+}
+
+void PeriodRollup::add( TimeStamp timeStamp, BloombergLP::bdldfp::Decimal64 amount )
+{
+  PeriodNumber const number = numberOf( mPeriod, timeStamp );
+  auto entry                = mEntries.end();
+  if ( mEntries.empty() || mEntries.back().mPeriod != number ) {
+    entry = std::ranges::lower_bound( mEntries, number, std::less(), &Entry::mPeriod );
+    if ( entry == mEntries.end() || entry->mPeriod != number ) {
+      entry = mEntries.insert( entry, { number, {} } );
+    }
+  } else {
+    entry = std::prev( mEntries.end() );
+  }
+
+  PeriodTotals& totals = entry->mTotals;
+  ++totals.mCount;
+  if ( amount > BloombergLP::bdldfp::Decimal64() ) {
+    totals.mInflow += amount;
+  } else if ( amount < BloombergLP::bdldfp::Decimal64() ) {
+    totals.mOutflow -= amount;
+  }
+}
+
+void PeriodRollup::reserveOnePeriod()
+{
+  // Keep growth geometric when called ahead of every small batch.
+  if ( mEntries.size() == mEntries.capacity() ) {
+    mEntries.reserve( std::max< std::size_t >( 4, mEntries.capacity() * 2 ) );
+  }
+}
+
+void PeriodRollup::clear()
+{
+  mEntries.clear();
+}
+
+auto PeriodRollup::numberOf( RollupPeriod period, TimeStamp timeStamp ) -> PeriodNumber
+{
+  auto const day = std::chrono::floor< std::chrono::days >( timeStamp );
+  if ( period == RollupPeriod::kWeek ) {
+    auto const weeks = std::chrono::floor< std::chrono::weeks >( day.time_since_epoch()
+                                                                 + std::chrono::days( kDaysFromMondayToEpoch ) );
+    return static_cast< PeriodNumber >( weeks.count() );
+  }
+  std::chrono::year_month_day const date { day };
+  return static_cast< PeriodNumber >( ( static_cast< int >( date.year() ) - 1970 ) * 12
+                                      + static_cast< int >( static_cast< unsigned >( date.month() ) ) - 1 );
+}
+
+auto PeriodRollup::startOf( RollupPeriod period, PeriodNumber number ) -> TimeStamp
+{
+  if ( period == RollupPeriod::kWeek ) {
+    return std::chrono::sys_days( std::chrono::weeks( number ) - std::chrono::days( kDaysFromMondayToEpoch ) );
+  }
+  // Floor division keeps months before 1970 in the right year.
+  PeriodNumber const years = number >= 0 ? number / 12 : ( number - 11 ) / 12;
+  std::chrono::year_month_day const date { std::chrono::year( 1970 + years ),
+                                           std::chrono::month( static_cast< unsigned >( number - years * 12 + 1 ) ),
+                                           std::chrono::day( 1 ) };
+  return std::chrono::sys_days( date );
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
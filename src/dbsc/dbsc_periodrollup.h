@@ -0,0 +1,159 @@
+// dbsc_periodrollup.h
+#ifndef INCLUDED_DBSC_PERIODROLLUP
+#define INCLUDED_DBSC_PERIODROLLUP
+
+//@PURPOSE: Provide per-period inflow and outflow totals of an account.
+//
+//@CLASSES:
+//  dbsc::PeriodRollup: the totals of an account's transactions per calendar
+//    week or month, maintained as transactions are logged.
+//  dbsc::PeriodTotals: the count, inflow and outflow of one period.
+//  dbsc::RollupPeriod: selects weekly or monthly buckets.
+//
+//@DESCRIPTION: Budget reports aggregate each account by month (or week).
+//  A PeriodRollup keeps those aggregates materialized: `add` folds one
+//  amount into the bucket of its timestamp, and `totals` reads a bucket back,
+//  so neither rescans the account.
+//
+//  Periods are calendar months, or weeks starting on Monday, in UTC. Only
+//  periods holding transactions have a bucket. Buckets are kept sorted by
+//  period; adding to the latest one, the usual case, is O(1), and any other
+//  is O(log p) for p periods (a backdated amount in a new period also shifts
+//  the later buckets). An account spans a few hundred periods at most.
+//
+//  Amounts above zero count as inflow, amounts below zero as outflow (held
+//  as a magnitude); every amount counts toward the period's transactions.
+//
+//  Buckets are obtained from the allocator supplied at construction.
+//
+/// Usage
+/// -----
+/// Example 1: Spending in October
+///
+/// ```cpp
+/// dbsc::PeriodRollup const& monthly = account.rollup( dbsc::RollupPeriod::kMonth );
+/// dbsc::PeriodTotals const october  = monthly.totals( std::chrono::sys_days( 2025y / 10 / 1 ) );
+/// std::println( "{} transactions, {} spent", october.mCount, october.mOutflow );
+/// ```
+
+#include <dbsc_sharedapi.h>
+#include <dbsc_transaction.h>
+
+#include <bdldfp_decimal.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dbsc {
+
+/// The length of the buckets of a PeriodRollup.
+enum class RollupPeriod
+{
+  /// Seven days starting on Monday.
+  kWeek,
+  /// A calendar month.
+  kMonth,
+};
+
+/// The aggregates of the transactions in one period.
+struct PeriodTotals
+{
+  std::size_t mCount { 0 };
+  /// Sum of the positive amounts.
+  BloombergLP::bdldfp::Decimal64 mInflow {};
+  /// Magnitude of the sum of the negative amounts.
+  BloombergLP::bdldfp::Decimal64 mOutflow {};
+
+  [[nodiscard]] auto net() const -> BloombergLP::bdldfp::Decimal64 { return mInflow - mOutflow; }
+
+  [[nodiscard]] friend auto operator==( PeriodTotals const&, PeriodTotals const& ) -> bool = default;
+};
+
+/// Totals per week or month, updated one amount at a time.
+class PeriodRollup
+{
+public:
+  /// One period holding transactions.
+  struct Bucket
+  {
+    /// The first instant of the period.
+    TimeStamp mStart;
+    PeriodTotals mTotals;
+  };
+
+  using allocator_type = bsl::allocator< char >; // NOLINT
+
+  DBSC_API explicit PeriodRollup( RollupPeriod period, allocator_type const& allocator = allocator_type() );
+  DBSC_API PeriodRollup( PeriodRollup const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API PeriodRollup( PeriodRollup&& original ) noexcept;
+  DBSC_API PeriodRollup( PeriodRollup&& original, allocator_type const& allocator );
+  DBSC_API auto operator=( PeriodRollup const& rhs ) -> PeriodRollup&;
+  DBSC_API auto operator=( PeriodRollup&& rhs ) -> PeriodRollup&;
+
+  [[nodiscard]] DBSC_API auto period() const noexcept -> RollupPeriod;
+
+  /// @return the first instant of the @p period containing @p timeStamp.
+  [[nodiscard]] DBSC_API static auto periodStart( RollupPeriod period, TimeStamp timeStamp ) -> TimeStamp;
+
+  /// @return the totals of the period containing @p timeStamp; zero if it
+  /// holds no transactions.
+  [[nodiscard]] DBSC_API auto totals( TimeStamp timeStamp ) const -> PeriodTotals;
+
+  /// @return the periods holding transactions, in chronological order.
+  [[nodiscard]] DBSC_API auto buckets() const -> std::vector< Bucket >;
+
+  /// The number of periods holding transactions.
+  [[nodiscard]] DBSC_API auto size() const noexcept -> std::size_t;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+  /// Count @p amount in the period containing @p timeStamp.
+  DBSC_API void add( TimeStamp timeStamp, BloombergLP::bdldfp::Decimal64 amount );
+
+  /// Ensure one more period can be added without allocating.
+  DBSC_API void reserveOnePeriod();
+
+  /// Forget every period.
+  DBSC_API void clear();
+
+private:
+  /// Periods are numbered consecutively from the one containing the epoch.
+  using PeriodNumber = std::int32_t;
+
+  struct Entry
+  {
+    PeriodNumber mPeriod;
+    PeriodTotals mTotals;
+  };
+
+  [[nodiscard]] static auto numberOf( RollupPeriod period, TimeStamp timeStamp ) -> PeriodNumber;
+  [[nodiscard]] static auto startOf( RollupPeriod period, PeriodNumber number ) -> TimeStamp;
+
+  RollupPeriod mPeriod;
+  /// Sorted by period.
+  bsl::vector< Entry > mEntries;
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
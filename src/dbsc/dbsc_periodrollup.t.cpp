@@ -0,0 +1,150 @@
+// dbsc_periodrollup.t.cpp
+// Test driver for dbsc::PeriodRollup
+#include <dbsc_periodrollup.h>
+#include <dbsc_transaction.h>
+
+#include <bdldfp_decimal.h>
+#include <bslma_testallocator.h>
+#include <bsls_assert.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+using namespace std::chrono;
+
+static void testPeriodStart()
+{
+  // 2025-10-15 is a Wednesday.
+  sys_days const wednesday { year( 2025 ) / 10 / 15 };
+  auto const weekOf  = []( dbsc::TimeStamp timeStamp ) {
+    return dbsc::PeriodRollup::periodStart( dbsc::RollupPeriod::kWeek, timeStamp );
+  };
+  auto const monthOf = []( dbsc::TimeStamp timeStamp ) {
+    return dbsc::PeriodRollup::periodStart( dbsc::RollupPeriod::kMonth, timeStamp );
+  };
+  dbsc::TimeStamp const noon = wednesday + hours( 12 );
+  BSLS_ASSERT( weekOf( noon ) == sys_days( year( 2025 ) / 10 / 13 ) );
+  BSLS_ASSERT( monthOf( noon ) == sys_days( year( 2025 ) / 10 / 1 ) );
+
+  // Mondays start their own week.
+  sys_days const monday { year( 2025 ) / 10 / 13 };
+  BSLS_ASSERT( weekOf( monday ) == monday );
+  BSLS_ASSERT( weekOf( monday - seconds( 1 ) ) == monday - days( 7 ) );
+
+  // Dates before the epoch.
+  sys_days const old { year( 1969 ) / 3 / 20 };
+  BSLS_ASSERT( monthOf( old ) == sys_days( year( 1969 ) / 3 / 1 ) );
+  BSLS_ASSERT( weekOf( old ) == sys_days( year( 1969 ) / 3 / 17 ) );
+}
+
+static void testTotals()
+{
+  dbsc::PeriodRollup rollup { dbsc::RollupPeriod::kMonth };
+  BSLS_ASSERT( rollup.period() == dbsc::RollupPeriod::kMonth );
+  sys_days const october { year( 2025 ) / 10 / 1 };
+  sys_days const november { year( 2025 ) / 11 / 1 };
+  rollup.add( october + days( 3 ), "100.00"_d64 );
+  rollup.add( october + days( 30 ) + hours( 23 ), "-40.00"_d64 );
+  rollup.add( november, "-5.00"_d64 );
+  rollup.add( october, "0.00"_d64 );
+  // Backdated, in a new period.
+  rollup.add( sys_days( year( 2025 ) / 9 / 30 ), "7.00"_d64 );
+
+  dbsc::PeriodTotals const totals = rollup.totals( october + days( 10 ) );
+  BSLS_ASSERT( totals.mCount == 3 );
+  BSLS_ASSERT( totals.mInflow == "100.00"_d64 );
+  BSLS_ASSERT( totals.mOutflow == "40.00"_d64 );
+  BSLS_ASSERT( totals.net() == "60.00"_d64 );
+  BSLS_ASSERT( rollup.totals( november ).mOutflow == "5.00"_d64 );
+  BSLS_ASSERT( rollup.totals( sys_days( year( 2024 ) / 10 / 1 ) ) == dbsc::PeriodTotals() );
+
+  std::vector< dbsc::PeriodRollup::Bucket > const buckets = rollup.buckets();
+  BSLS_ASSERT( rollup.size() == 3 );
+  BSLS_ASSERT( buckets.size() == 3 );
+  BSLS_ASSERT( buckets[0].mStart == sys_days( year( 2025 ) / 9 / 1 ) );
+  BSLS_ASSERT( buckets[0].mTotals.mInflow == "7.00"_d64 );
+  BSLS_ASSERT( buckets[1].mStart == october );
+  BSLS_ASSERT( buckets[2].mStart == november );
+
+  rollup.clear();
+  BSLS_ASSERT( rollup.size() == 0 );
+}
+
+static void testAgainstScan()
+{
+  std::mt19937 generator { 11 };
+  std::uniform_int_distribution< int > hoursOffset { 0, 24 * 365 * 3 };
+  std::uniform_int_distribution< int > units { -500, 500 };
+  sys_days const start { year( 2023 ) / 1 / 1 };
+
+  dbsc::PeriodRollup weekly { dbsc::RollupPeriod::kWeek };
+  std::vector< dbsc::TimeStamp > timeStamps;
+  std::vector< BloombergLP::bdldfp::Decimal64 > amounts;
+  for ( int i = 0; i < 2'000; ++i ) {
+    timeStamps.push_back( start + hours( hoursOffset( generator ) ) );
+    amounts.push_back( BloombergLP::bdldfp::Decimal64( units( generator ) ) );
+    weekly.add( timeStamps.back(), amounts.back() );
+  }
+
+  std::size_t count = 0;
+  for ( dbsc::PeriodRollup::Bucket const& bucket : weekly.buckets() ) {
+    dbsc::PeriodTotals expected;
+    for ( std::size_t i = 0; i < timeStamps.size(); ++i ) {
+      if ( timeStamps[i] >= bucket.mStart && timeStamps[i] < bucket.mStart + days( 7 ) ) {
+        ++expected.mCount;
+        if ( amounts[i] > "0"_d64 ) {
+          expected.mInflow += amounts[i];
+        } else {
+          expected.mOutflow -= amounts[i];
+        }
+      }
+    }
+    BSLS_ASSERT( bucket.mTotals == expected );
+    count += bucket.mTotals.mCount;
+  }
+  BSLS_ASSERT( count == timeStamps.size() );
+}
+
+static void testAllocator()
+{
+  BloombergLP::bslma::TestAllocator allocator;
+  {
+    dbsc::PeriodRollup rollup { dbsc::RollupPeriod::kWeek, &allocator };
+    rollup.add( sys_days( year( 2025 ) / 1 / 1 ), "1.00"_d64 );
+    BSLS_ASSERT( allocator.numBlocksInUse() > 0 );
+
+    dbsc::PeriodRollup const copy { rollup };
+    BSLS_ASSERT( copy.buckets().size() == 1 );
+  }
+  BSLS_ASSERT( allocator.numBlocksInUse() == 0 );
+}
+} // namespace
+
+auto main() -> int
+{
+  testPeriodStart();
+  testTotals();
+  testAgainstScan();
+  testAllocator();
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
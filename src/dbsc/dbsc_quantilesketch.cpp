@@ -0,0 +1,369 @@
+// dbsc_quantilesketch.cpp
+#include "dbsc_quantilesketch.h"
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <utility>
+
+namespace dbsc {
+
+namespace {
+/// Any fixed nonzero state will do; it only has to be the same every time.
+constexpr std::uint64_t kSeed = 0x9E37'79B9'7F4A'7C15;
+} // namespace
+
+QuantileSketch::QuantileSketch( allocator_type const& allocator )
+  : QuantileSketch( kDefaultK, allocator )
+{
+}
+
+QuantileSketch::QuantileSketch( unsigned k, allocator_type const& allocator )
+  : mK( k )
+  , mRandom( kSeed )
+  , mItems( allocator )
+  , mLevelBegins( allocator )
+{
+  BSLS_ASSERT( k >= 2 );
+}
+
+QuantileSketch::QuantileSketch( QuantileSketch const& original, allocator_type const& allocator )
+  : mK( original.mK )
+  , mCount( original.mCount )
+  , mMin( original.mMin )
+  , mMax( original.mMax )
+  , mRandom( original.mRandom )
+  , mRetainLimit( original.mRetainLimit )
+  , mItems( original.mItems, allocator )
+  , mLevelBegins( original.mLevelBegins, allocator )
+{
+}
+
+QuantileSketch::QuantileSketch( QuantileSketch&& original ) noexcept
+  : mK( original.mK )
+  , mCount( original.mCount )
+  , mMin( original.mMin )
+  , mMax( original.mMax )
+  , mRandom( original.mRandom )
+  , mRetainLimit( original.mRetainLimit )
+  , mItems( std::move( original.mItems ) )
+  , mLevelBegins( std::move( original.mLevelBegins ) )
+{
+  original.clear();
+}
+
+QuantileSketch::QuantileSketch( QuantileSketch&& original, allocator_type const& allocator )
+  : mK( original.mK )
+  , mCount( original.mCount )
+  , mMin( original.mMin )
+  , mMax( original.mMax )
+  , mRandom( original.mRandom )
+  , mRetainLimit( original.mRetainLimit )
+  , mItems( std::move( original.mItems ), allocator )
+  , mLevelBegins( std::move( original.mLevelBegins ), allocator )
+{
+  original.clear();
+}
+
+auto QuantileSketch::operator=( QuantileSketch const& rhs ) -> QuantileSketch& = default;
+
+auto QuantileSketch::operator=( QuantileSketch&& rhs ) -> QuantileSketch&
+{
+  mK           = rhs.mK;
+  mCount       = rhs.mCount;
+  mMin         = rhs.mMin;
+  mMax         = rhs.mMax;
+  mRandom      = rhs.mRandom;
+  mRetainLimit = rhs.mRetainLimit;
+  mItems       = std::move( rhs.mItems );
+  mLevelBegins = std::move( rhs.mLevelBegins );
+  rhs.clear();
+  return *this;
+}
+
+auto QuantileSketch::k() const noexcept -> unsigned
+{
+  return mK;
+}
+
+auto QuantileSketch::count() const noexcept -> std::uint64_t
+{
+  return mCount;
+}
+
+auto QuantileSketch::isEmpty() const noexcept -> bool
+{
+  return mCount == 0;
+}
+
+auto QuantileSketch::retainedCount() const noexcept -> std::size_t
+{
+  return mItems.size();
+}
+
+auto QuantileSketch::min() const -> Value
+{
+  BSLS_ASSERT( not isEmpty() );
+  return mMin;
+}
+
+auto QuantileSketch::max() const -> Value
+{
+  BSLS_ASSERT( not isEmpty() );
+  return mMax;
+}
+
+auto QuantileSketch::quantile( double fraction ) const -> Value
+{
+  return quantileOf( sortedSample(), fraction );
+}
+
+auto QuantileSketch::quantiles( std::span< double const > fractions ) const -> std::vector< Value >
+{
+  std::vector< Weighted > const sample = sortedSample();
+  std::vector< Value > result;
+  result.reserve( fractions.size() );
+  for ( double const fraction : fractions ) {
+    result.push_back( quantileOf( sample, fraction ) );
+  }
+  return result;
+}
+
+auto QuantileSketch::rank( Value value ) const -> std::uint64_t
+{
+  if ( isEmpty() || value < mMin ) {
+    return 0;
+  }
+  if ( value >= mMax ) {
+    return mCount;
+  }
+  std::uint64_t result = 0;
+  for ( std::size_t level = 0; level < height(); ++level ) {
+    auto const first = mItems.begin() + static_cast< std::ptrdiff_t >( levelBegin( level ) );
+    auto const last  = mItems.begin() + static_cast< std::ptrdiff_t >( levelEnd( level ) );
+    auto const below = std::count_if( first, last, [value]( Value item ) { return item <= value; } );
+    result += static_cast< std::uint64_t >( below ) << level;
+  }
+  return result;
+}
+
+auto QuantileSketch::get_allocator() const noexcept -> allocator_type
+{
+  return mItems.get_allocator();
+}
+
+void QuantileSketch::add( Value value )
+{
+  if ( mLevelBegins.empty() ) {
+    addLevel();
+  }
+  mItems.push_back( value );
+  mMin = mCount == 0 ? value : std::min( mMin, value );
+  mMax = mCount == 0 ? value : std::max( mMax, value );
+  ++mCount;
+  if ( mItems.size() >= mRetainLimit ) {
+    compress();
+  }
+}
+
+void QuantileSketch::merge( QuantileSketch const& other )
+{
+  BSLS_ASSERT( other.mK == mK );
+  if ( other.isEmpty() ) {
+    return;
+  }
+  if ( &other == this ) {
+    QuantileSketch const copy( other );
+    merge( copy );
+    return;
+  }
+  while ( height() < other.height() ) {
+    addLevel();
+  }
+  // Each level of `other` joins the same level here; the levels below it move
+  // up to make room.
+  for ( std::size_t level = 0; level < other.height(); ++level ) {
+    auto const first = other.mItems.begin() + static_cast< std::ptrdiff_t >( other.levelBegin( level ) );
+    auto const last  = other.mItems.begin() + static_cast< std::ptrdiff_t >( other.levelEnd( level ) );
+    mItems.insert( mItems.begin() + static_cast< std::ptrdiff_t >( levelEnd( level ) ), first, last );
+    for ( std::size_t below = 0; below < level; ++below ) {
+      mLevelBegins[below] += static_cast< Offset >( last - first );
+    }
+  }
+  mMin = isEmpty() ? other.mMin : std::min( mMin, other.mMin );
+  mMax = isEmpty() ? other.mMax : std::max( mMax, other.mMax );
+  mCount += other.mCount;
+  compress();
+}
+
+void QuantileSketch::reserve( std::size_t count )
+{
+  // Level h holds values standing for 2^h each and the top level holds at
+  // least two, so the height is bounded by the width of the count, and the
+  // sample by the retain limit of that height.
+  std::size_t const maxHeight = std::bit_width( mCount + count ) + 1;
+  std::size_t const maxSize   = 3 * std::size_t( mK ) + 2 * maxHeight;
+  mItems.reserve( std::min( mItems.size() + count, maxSize ) );
+  mLevelBegins.reserve( maxHeight );
+}
+
+void QuantileSketch::clear()
+{
+  mCount       = 0;
+  mMin         = 0;
+  mMax         = 0;
+  mRandom      = kSeed;
+  mRetainLimit = 0;
+  mItems.clear();
+  mLevelBegins.clear();
+}
+
+auto QuantileSketch::height() const noexcept -> std::size_t
+{
+  return mLevelBegins.size();
+}
+
+auto QuantileSketch::levelBegin( std::size_t level ) const noexcept -> std::size_t
+{
+  return mLevelBegins[level];
+}
+
+auto QuantileSketch::levelEnd( std::size_t level ) const noexcept -> std::size_t
+{
+  return level == 0 ? mItems.size() : mLevelBegins[level - 1];
+}
+
+auto QuantileSketch::capacityOf( std::size_t level ) const -> std::size_t
+{
+  auto const depth    = static_cast< double >( height() - 1 - level );
+  auto const capacity = std::ceil( mK * std::pow( 2.0 / 3.0, depth ) );
+  return std::max( std::size_t( 2 ), static_cast< std::size_t >( capacity ) );
+}
+
+auto QuantileSketch::sortedSample() const -> std::vector< Weighted >
+{
+  std::vector< Weighted > sample;
+  sample.reserve( mItems.size() );
+  for ( std::size_t level = 0; level < height(); ++level ) {
+    for ( std::size_t i = levelBegin( level ); i < levelEnd( level ); ++i ) {
+      sample.push_back( { mItems[i], std::uint64_t( 1 ) << level } );
+    }
+  }
+  std::ranges::sort( sample, {}, &Weighted::mValue );
+  return sample;
+}
+
+auto QuantileSketch::quantileOf( std::vector< Weighted > const& sample, double fraction ) const -> Value
+{
+  BSLS_ASSERT( not isEmpty() );
+  BSLS_ASSERT( fraction >= 0.0 && fraction <= 1.0 );
+  if ( fraction <= 0.0 ) {
+    return mMin;
+  }
+  if ( fraction >= 1.0 ) {
+    return mMax;
+  }
+  // Compaction preserves the total weight, so the weights sum to the count.
+  auto const target        = std::max( std::uint64_t( 1 ), std::uint64_t( std::ceil( fraction * mCount ) ) );
+  std::uint64_t cumulative = 0;
+  for ( Weighted const& item : sample ) {
+    cumulative += item.mWeight;
+    if ( cumulative >= target ) {
+      return item.mValue;
+    }
+  }
+  return mMax;
+}
+
+void QuantileSketch::addLevel()
+{
+  // The new top level is empty, so it begins where the old one does.
+  mLevelBegins.push_back( 0 );
+  mRetainLimit = 0;
+  for ( std::size_t level = 0; level < height(); ++level ) {
+    mRetainLimit += capacityOf( level );
+  }
+}
+
+void QuantileSketch::compress()
+{
+  while ( mItems.size() >= mRetainLimit ) {
+    // The sample has reached the sum of the capacities, so some level has
+    // reached its own.
+    std::size_t level = 0;
+    while ( levelEnd( level ) - levelBegin( level ) < capacityOf( level ) ) {
+      ++level;
+    }
+    if ( level + 1 == height() ) {
+      addLevel();
+      continue;
+    }
+    compact( level );
+  }
+}
+
+void QuantileSketch::compact( std::size_t level )
+{
+  BSLS_ASSERT( level + 1 < height() );
+  std::size_t const begin = levelBegin( level );
+  std::size_t const end   = levelEnd( level );
+  auto const first        = mItems.begin();
+  std::sort( first + static_cast< std::ptrdiff_t >( begin ), first + static_cast< std::ptrdiff_t >( end ) );
+
+  // Promote every other value, starting from the first or the second at
+  // random, into the next level, which ends where this one begins. An odd
+  // value out stays behind.
+  std::size_t const size   = end - begin;
+  bool const isOdd         = size % 2 != 0;
+  std::size_t const pairs  = size / 2;
+  Value const oddOut       = mItems[begin];
+  std::size_t const offset = ( isOdd ? 1 : 0 ) + ( nextCoin() ? 1 : 0 );
+  for ( std::size_t i = 0; i < pairs; ++i ) {
+    mItems[begin + i] = mItems[begin + offset + 2 * i];
+  }
+  std::size_t newEnd = begin + pairs;
+  if ( isOdd ) {
+    mItems[newEnd++] = oddOut;
+  }
+  mLevelBegins[level] = static_cast< Offset >( begin + pairs );
+
+  // Close the gap before the lower levels.
+  std::size_t const removed = end - newEnd;
+  std::move( mItems.begin() + static_cast< std::ptrdiff_t >( end ),
+             mItems.end(),
+             mItems.begin() + static_cast< std::ptrdiff_t >( newEnd ) );
+  mItems.resize( mItems.size() - removed );
+  for ( std::size_t below = 0; below < level; ++below ) {
+    mLevelBegins[below] -= static_cast< Offset >( removed );
+  }
+}
+
+auto QuantileSketch::nextCoin() noexcept -> bool
+{
+  // xorshift64
+  mRandom ^= mRandom << 13;
+  mRandom ^= mRandom >> 7;
+  mRandom ^= mRandom << 17;
+  return ( mRandom >> 63 ) != 0;
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
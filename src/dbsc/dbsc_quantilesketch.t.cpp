@@ -0,0 +1,177 @@
+// dbsc_quantilesketch.t.cpp
+// Test driver for dbsc::QuantileSketch
+#include <dbsc_quantilesketch.h>
+
+#include <bslma_testallocator.h>
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// The rank error of @p value as a quantile of the sorted @p values, as a
+/// fraction of their count.
+static auto rankError( std::vector< std::int64_t > const& sorted, std::int64_t value, double fraction ) -> double
+{
+  auto const rank = std::upper_bound( sorted.begin(), sorted.end(), value ) - sorted.begin();
+  return std::abs( static_cast< double >( rank ) / static_cast< double >( sorted.size() ) - fraction );
+}
+
+static void testExact()
+{
+  dbsc::QuantileSketch sketch;
+  BSLS_ASSERT( sketch.isEmpty() );
+  BSLS_ASSERT( sketch.k() == dbsc::QuantileSketch::kDefaultK );
+  BSLS_ASSERT( sketch.rank( 5 ) == 0 );
+
+  // Below the first compaction, every value is retained.
+  for ( std::int64_t value = 100; value >= 1; --value ) {
+    sketch.add( value );
+  }
+  BSLS_ASSERT( sketch.count() == 100 );
+  BSLS_ASSERT( sketch.retainedCount() == 100 );
+  BSLS_ASSERT( sketch.min() == 1 );
+  BSLS_ASSERT( sketch.max() == 100 );
+  BSLS_ASSERT( sketch.quantile( 0.0 ) == 1 );
+  BSLS_ASSERT( sketch.quantile( 0.5 ) == 50 );
+  BSLS_ASSERT( sketch.quantile( 0.9 ) == 90 );
+  BSLS_ASSERT( sketch.quantile( 1.0 ) == 100 );
+  BSLS_ASSERT( sketch.rank( 0 ) == 0 );
+  BSLS_ASSERT( sketch.rank( 25 ) == 25 );
+  BSLS_ASSERT( sketch.rank( 1'000 ) == 100 );
+
+  std::array< double, 3 > const fractions { 0.25, 0.5, 0.75 };
+  BSLS_ASSERT( sketch.quantiles( fractions ) == ( std::vector< std::int64_t > { 25, 50, 75 } ) );
+
+  sketch.clear();
+  BSLS_ASSERT( sketch.isEmpty() );
+  BSLS_ASSERT( sketch.retainedCount() == 0 );
+  sketch.add( -7 );
+  BSLS_ASSERT( sketch.quantile( 0.5 ) == -7 );
+}
+
+static void testAccuracy()
+{
+  std::vector< std::int64_t > values( 200'000 );
+  std::iota( values.begin(), values.end(), -50'000 );
+  std::mt19937 generator { 23 };
+  std::ranges::shuffle( values, generator );
+
+  dbsc::QuantileSketch sketch;
+  for ( std::int64_t const value : values ) {
+    sketch.add( value );
+  }
+  BSLS_ASSERT( sketch.count() == values.size() );
+  BSLS_ASSERT( sketch.retainedCount() < 3 * sketch.k() + 64 );
+  BSLS_ASSERT( sketch.min() == -50'000 );
+  BSLS_ASSERT( sketch.max() == 149'999 );
+
+  std::ranges::sort( values );
+  for ( double const fraction : { 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99 } ) {
+    BSLS_ASSERT( rankError( values, sketch.quantile( fraction ), fraction ) < 0.02 );
+  }
+  auto const median = static_cast< double >( sketch.rank( 50'000 ) ) / static_cast< double >( values.size() );
+  BSLS_ASSERT( std::abs( median - 0.5 ) < 0.02 );
+
+  // The same values in the same order yield the same sample.
+  std::ranges::shuffle( values, generator );
+  dbsc::QuantileSketch first;
+  dbsc::QuantileSketch second;
+  for ( std::int64_t const value : values ) {
+    first.add( value );
+    second.add( value );
+  }
+  BSLS_ASSERT( first.quantile( 0.3 ) == second.quantile( 0.3 ) );
+}
+
+static void testMerge()
+{
+  std::mt19937 generator { 5 };
+  std::uniform_int_distribution< std::int64_t > small { 0, 999 };
+  std::uniform_int_distribution< std::int64_t > large { 1'000, 1'000'000 };
+
+  // Unevenly sized parts with different distributions.
+  std::vector< std::int64_t > values;
+  std::vector< dbsc::QuantileSketch > parts( 4 );
+  for ( std::size_t part = 0; part < parts.size(); ++part ) {
+    for ( std::size_t i = 0; i < 10'000 * ( part + 1 ); ++i ) {
+      values.push_back( part % 2 == 0 ? small( generator ) : large( generator ) );
+      parts[part].add( values.back() );
+    }
+  }
+  dbsc::QuantileSketch merged;
+  for ( dbsc::QuantileSketch const& part : parts ) {
+    merged.merge( part );
+  }
+  merged.merge( dbsc::QuantileSketch() );
+  BSLS_ASSERT( merged.count() == values.size() );
+  BSLS_ASSERT( merged.retainedCount() < 3 * merged.k() + 64 );
+
+  std::ranges::sort( values );
+  BSLS_ASSERT( merged.min() == values.front() );
+  BSLS_ASSERT( merged.max() == values.back() );
+  for ( double const fraction : { 0.1, 0.3, 0.5, 0.7, 0.9 } ) {
+    BSLS_ASSERT( rankError( values, merged.quantile( fraction ), fraction ) < 0.02 );
+  }
+
+  // Merging a sketch into itself doubles every weight.
+  dbsc::QuantileSketch doubled { parts[0] };
+  doubled.merge( doubled );
+  BSLS_ASSERT( doubled.count() == 2 * parts[0].count() );
+  BSLS_ASSERT( doubled.min() == parts[0].min() );
+}
+
+static void testAllocator()
+{
+  BloombergLP::bslma::TestAllocator allocator;
+  {
+    dbsc::QuantileSketch sketch { &allocator };
+    sketch.reserve( 10'000 );
+    auto const blocks = allocator.numBlocksTotal();
+    for ( std::int64_t value = 0; value < 10'000; ++value ) {
+      sketch.add( value * 7 % 10'000 );
+    }
+    BSLS_ASSERT( allocator.numBlocksTotal() == blocks );
+
+    dbsc::QuantileSketch const copy { sketch, &allocator };
+    BSLS_ASSERT( copy.quantile( 0.5 ) == sketch.quantile( 0.5 ) );
+
+    dbsc::QuantileSketch moved { std::move( sketch ) };
+    BSLS_ASSERT( moved.count() == 10'000 );
+    BSLS_ASSERT( moved.quantile( 0.5 ) == copy.quantile( 0.5 ) );
+  }
+  BSLS_ASSERT( allocator.numBlocksInUse() == 0 );
+}
+} // namespace
+
+auto main() -> int
+{
+  testExact();
+  testAccuracy();
+  testMerge();
+  testAllocator();
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,147 @@
+// dbsc_split.cpp
+#include "dbsc_split.h"
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+namespace dbsc {
+
+Split::Split( UuidString const& splitId,
+              BloombergLP::bdldfp::Decimal64 amount,
+              TimeStamp timeStamp,
+              Notes notes,
+              std::span< SplitLeg const > legs,
+              allocator_type const& allocator )
+  : mId( splitId )
+  , mAmount( amount )
+  , mTimeStamp( timeStamp )
+  , mNotes( std::move( notes ) )
+  , mLegs( legs.begin(), legs.end(), allocator )
+{
+  if ( mLegs.empty() ) {
+    throw std::invalid_argument( std::format( "Split {} has no legs.", splitId ) );
+  }
+  BloombergLP::bdldfp::Decimal64 total {};
+  for ( auto leg = mLegs.begin(); leg != mLegs.end(); ++leg ) {
+    if ( UuidStringUtil::isNil( leg->mAccountId ) ) {
+      throw std::invalid_argument( std::format( "Split {} has a leg without an account.", splitId ) );
+    }
+    if ( std::any_of( mLegs.begin(), leg, [leg]( SplitLeg const& other ) {
+           return other.mAccountId == leg->mAccountId;
+         } ) ) {
+      throw std::invalid_argument( std::format( "Split {} names account {} twice.", splitId, leg->mAccountId ) );
+    }
+    total += leg->mAmount;
+  }
+  if ( total != amount ) {
+    throw std::invalid_argument( std::format( "The legs of split {} do not sum to its amount.", splitId ) );
+  }
+}
+
+Split::Split( Split const& original, allocator_type const& allocator )
+  : mId( original.mId )
+  , mAmount( original.mAmount )
+  , mTimeStamp( original.mTimeStamp )
+  , mNotes( original.mNotes )
+  , mLegs( original.mLegs, allocator )
+{
+}
+
+Split::Split( Split&& original ) noexcept = default;
+
+Split::Split( Split&& original, allocator_type const& allocator )
+  : mId( original.mId )
+  , mAmount( original.mAmount )
+  , mTimeStamp( original.mTimeStamp )
+  , mNotes( std::move( original.mNotes ) )
+  , mLegs( std::move( original.mLegs ), allocator )
+{
+}
+
+auto Split::id() const -> UuidString const&
+{
+  return mId;
+}
+
+auto Split::amount() const -> BloombergLP::bdldfp::Decimal64
+{
+  return mAmount;
+}
+
+auto Split::timestamp() const -> TimeStamp
+{
+  return mTimeStamp;
+}
+
+auto Split::notes() const -> std::string_view
+{
+  return mNotes.view();
+}
+
+auto Split::sharedNotes() const -> Notes const&
+{
+  return mNotes;
+}
+
+auto Split::legs() const noexcept -> std::span< SplitLeg const >
+{
+  return { mLegs.data(), mLegs.size() };
+}
+
+auto Split::involves( UuidString const& accountId ) const -> bool
+{
+  return find( accountId ) != nullptr;
+}
+
+auto Split::amountFor( UuidString const& accountId ) const -> BloombergLP::bdldfp::Decimal64
+{
+  SplitLeg const* const leg = find( accountId );
+  BSLS_ASSERT( leg != nullptr );
+  return leg->mAmount;
+}
+
+auto Split::leg( UuidString const& accountId ) const -> Transaction
+{
+  SplitLeg const* const leg = find( accountId );
+  if ( leg == nullptr ) {
+    throw std::invalid_argument( std::format( "Account {} is not a party to split {}.", accountId, mId ) );
+  }
+  return { mId, accountId, UuidString(), leg->mAmount, mTimeStamp, mNotes };
+}
+
+auto Split::get_allocator() const noexcept -> allocator_type
+{
+  return mLegs.get_allocator();
+}
+
+auto Split::find( UuidString const& accountId ) const -> SplitLeg const*
+{
+  // Splits have tens of legs at most; a linear scan beats any index.
+  auto const leg = std::find_if( mLegs.begin(), mLegs.end(), [&accountId]( SplitLeg const& candidate ) {
+    return candidate.mAccountId == accountId;
+  } );
+  return leg == mLegs.end() ? nullptr : &*leg;
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
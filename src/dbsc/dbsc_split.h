@@ -0,0 +1,135 @@
+// dbsc_split.h
+#ifndef INCLUDED_DBSC_SPLIT
+#define INCLUDED_DBSC_SPLIT
+
+//@PURPOSE: Provide a single record for an amount divided among accounts.
+//
+//@CLASSES:
+//  dbsc::Split: an immutable multi-leg transaction from which each account's
+//    Transaction is derived.
+//  dbsc::SplitLeg: one account's share of a Split.
+//
+//@DESCRIPTION: A split moves one external amount (e.g. a paycheck) into, or
+//  out of, several accounts at once. It has one id, one timestamp and one
+//  notes string, and N legs, each naming a distinct account and its share.
+//  The shares must sum to the external amount, so a split is always
+//  balanced.
+//
+//  Like dbsc::Transfer, a split is stored once and shared (through a
+//  `std::shared_ptr< Split const >`) by every account it involves. Each
+//  account derives its own Transaction from the record: the split's id,
+//  timestamp and notes, the account's share, and the nil (external) id as
+//  the other party.
+//
+//  Legs are kept in the order given, in memory obtained from the allocator
+//  supplied at construction.
+//
+/// Usage
+/// -----
+/// Example 1: Distributing a paycheck
+///
+/// ```cpp
+/// std::vector< dbsc::SplitLeg > const legs { { rentId, 1200.00_d64 }, { savingsId, 300.00_d64 } };
+/// dbsc::Split const paycheck { id, 1500.00_d64, now, dbsc::Notes( "Paycheck" ), legs };
+/// dbsc::Transaction const rentLeg = paycheck.leg( rentId ); // +1200.00, external
+/// ```
+
+#include <dbsc_notespool.h>
+#include <dbsc_sharedapi.h>
+#include <dbsc_transaction.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+#include <span>
+#include <string_view>
+
+namespace dbsc {
+
+/// One account's share of a Split.
+struct SplitLeg
+{
+  UuidString mAccountId;
+  BloombergLP::bdldfp::Decimal64 mAmount;
+
+  [[nodiscard]] friend auto operator==( SplitLeg const& a, SplitLeg const& b ) -> bool = default;
+};
+
+/// An external amount divided among several distinct accounts.
+class Split
+{
+public:
+  using allocator_type = bsl::allocator< char >; // NOLINT
+
+  /// @throw @c std::invalid_argument if @p legs is empty, names the nil id or
+  /// an account more than once, or does not sum to @p amount.
+  [[nodiscard]] DBSC_API Split( UuidString const& splitId,
+                                BloombergLP::bdldfp::Decimal64 amount,
+                                TimeStamp timeStamp,
+                                Notes notes,
+                                std::span< SplitLeg const > legs,
+                                allocator_type const& allocator = allocator_type() );
+  DBSC_API Split( Split const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API Split( Split&& original ) noexcept;
+  DBSC_API Split( Split&& original, allocator_type const& allocator );
+
+  [[nodiscard]] DBSC_API auto id() const -> UuidString const&;
+  /// The external amount, equal to the sum of the legs.
+  [[nodiscard]] DBSC_API auto amount() const -> BloombergLP::bdldfp::Decimal64;
+  [[nodiscard]] DBSC_API auto timestamp() const -> TimeStamp;
+  [[nodiscard]] DBSC_API auto notes() const -> std::string_view;
+  /// The notes, for sharing with derived Transactions.
+  [[nodiscard]] DBSC_API auto sharedNotes() const -> Notes const&;
+  [[nodiscard]] DBSC_API auto legs() const noexcept -> std::span< SplitLeg const >;
+
+  /// Query if @p accountId has a leg.
+  [[nodiscard]] DBSC_API auto involves( UuidString const& accountId ) const -> bool;
+
+  /// @return the share of @p accountId.
+  /// @pre `involves( accountId )`
+  [[nodiscard]] DBSC_API auto amountFor( UuidString const& accountId ) const -> BloombergLP::bdldfp::Decimal64;
+
+  /// Materialize the Transaction owned by @p accountId.
+  /// @throw @c std::invalid_argument if @p accountId has no leg.
+  [[nodiscard]] DBSC_API auto leg( UuidString const& accountId ) const -> Transaction;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+  [[nodiscard]] friend auto operator==( Split const& a, Split const& b ) -> bool
+  {
+    return a.mId == b.mId && a.mAmount == b.mAmount && a.mTimeStamp == b.mTimeStamp && a.mNotes == b.mNotes
+        && a.mLegs == b.mLegs;
+  }
+
+private:
+  [[nodiscard]] auto find( UuidString const& accountId ) const -> SplitLeg const*;
+
+  UuidString mId;
+  BloombergLP::bdldfp::Decimal64 mAmount;
+  TimeStamp mTimeStamp;
+  Notes mNotes;
+  bsl::vector< SplitLeg > mLegs;
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,87 @@
+// dbsc_split.t.cpp
+// Test driver for dbsc::Split
+#include <dbsc_notespool.h>
+#include <dbsc_split.h>
+#include <dbsc_transaction.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bsls_assert.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+
+static void testLegs()
+{
+  auto const splitId   = dbsc::UuidStringUtil::generate();
+  auto const rentId    = dbsc::UuidStringUtil::generate();
+  auto const savingsId = dbsc::UuidStringUtil::generate();
+  dbsc::TimeStamp const timeStamp { std::chrono::system_clock::now() };
+  std::vector< dbsc::SplitLeg > const legs { { rentId, "1200.00"_d64 }, { savingsId, "300.00"_d64 } };
+  dbsc::Split const paycheck { splitId, "1500.00"_d64, timeStamp, dbsc::Notes( "paycheck" ), legs };
+
+  BSLS_ASSERT( paycheck.legs().size() == 2 );
+  BSLS_ASSERT( paycheck.legs()[1] == legs[1] );
+  BSLS_ASSERT( paycheck.involves( rentId ) );
+  BSLS_ASSERT( not paycheck.involves( splitId ) );
+  BSLS_ASSERT( paycheck.amountFor( savingsId ) == "300.00"_d64 );
+  BSLS_ASSERT( paycheck.notes() == "paycheck" );
+
+  // Each leg is an external transaction carrying the split's id.
+  BSLS_ASSERT( paycheck.leg( rentId )
+               == dbsc::Transaction( splitId, rentId, {}, "1200.00"_d64, timeStamp, "paycheck" ) );
+
+  dbsc::Split const copy { paycheck };
+  BSLS_ASSERT( copy == paycheck );
+
+  try {
+    static_cast< void >( paycheck.leg( dbsc::UuidStringUtil::generate() ) );
+    BSLS_ASSERT( false );
+  } catch ( std::invalid_argument const& ) {
+  }
+}
+
+static void testInvalidLegs()
+{
+  auto const accountId = dbsc::UuidStringUtil::generate();
+  dbsc::TimeStamp const timeStamp { std::chrono::system_clock::now() };
+  auto const expectInvalid = [&]( BloombergLP::bdldfp::Decimal64 amount, std::vector< dbsc::SplitLeg > const& legs ) {
+    try {
+      dbsc::Split const split { dbsc::UuidStringUtil::generate(), amount, timeStamp, {}, legs };
+      BSLS_ASSERT( false );
+    } catch ( std::invalid_argument const& ) {
+    }
+  };
+  expectInvalid( "0.00"_d64, {} );
+  expectInvalid( "1.00"_d64, { { {}, "1.00"_d64 } } );
+  expectInvalid( "2.00"_d64, { { accountId, "1.00"_d64 }, { accountId, "1.00"_d64 } } );
+  expectInvalid( "2.00"_d64, { { accountId, "1.00"_d64 }, { dbsc::UuidStringUtil::generate(), "0.50"_d64 } } );
+}
+} // namespace
+
+int main()
+{
+  testLegs();
+  testInvalidLegs();
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -3,7 +3,10 @@
 
 #include <dbsc_account.h>
 #include <dbsc_accountbook.h>
+#include <dbsc_split.h>
 #include <dbsc_transaction.h>
+#include <dbsc_transfer.h>
+#include <dbsc_uuidindex.h>
 #include <dbsc_uuidstring.h>
 
 #include <bdldfp_decimal.h>
@@ -12,6 +15,8 @@
 #include <format>
 #include <fstream>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace dbsc {
 
@@ -19,6 +24,9 @@ namespace {
   using namespace std::string_view_literals;
   std::filesystem::path const kTomlExtension { ".toml" };
   constexpr auto kAccountBookOwnerKey { "owner"sv };
+  constexpr auto kAccountBookTransactionIdPolicyKey { "transactionIdPolicy"sv };
+  constexpr auto kTransactionIdPolicyRandom { "random"sv };
+  constexpr auto kTransactionIdPolicyTimeOrdered { "timeOrdered"sv };
   constexpr auto kAccountNameKey { "name"sv };
   constexpr auto kAccountDescriptionKey { "description"sv };
   constexpr auto kAccountTransactionsKey { "transactions"sv };
@@ -28,12 +36,34 @@ namespace {
   constexpr auto kTransactionTimeStampKey { "timeStamp"sv };
   constexpr auto kTransactionAmountKey { "amount"sv };
   constexpr auto kTransactionNotesKey { "notes"sv };
+  constexpr auto kAccountBookTransfersKey { "transfers"sv };
+  constexpr auto kTransferReferenceKey { "transferId"sv };
+  constexpr auto kTransferSourceIdKey { "sourceId"sv };
+  constexpr auto kTransferDestinationIdKey { "destinationId"sv };
+  constexpr auto kAccountBookSplitsKey { "splits"sv };
+  constexpr auto kSplitReferenceKey { "splitId"sv };
+  constexpr auto kSplitLegsKey { "legs"sv };
+  constexpr auto kSplitLegAccountIdKey { "accountId"sv };
 
   using TomlDateTimeType = std::string;
   using TomlCurrencyType = std::string;
+
+  /// @return @p text interned in @p notesPool.
+  auto pooledNotes( std::shared_ptr< NotesPool > const& notesPool, std::string_view text ) -> Notes
+  {
+    return Notes( notesPool, notesPool->intern( text ) );
+  }
 } // namespace
 
-auto TomlSerializer::readAccountBook( std::filesystem::path const& filePath ) -> AccountBook
+auto TomlSerializer::readAccountBook( std::filesystem::path const& filePath, AccountBook::allocator_type allocator )
+  -> AccountBook
+{
+  return readAccountBook( filePath, std::allocate_shared< NotesPool >( allocator ), allocator );
+}
+
+auto TomlSerializer::readAccountBook( std::filesystem::path const& filePath,
+                                      std::shared_ptr< NotesPool > notesPool,
+                                      AccountBook::allocator_type allocator ) -> AccountBook
 {
 
   // Assume a valid TOML file.
@@ -51,7 +81,91 @@ auto TomlSerializer::readAccountBook( std::filesystem::path const& filePath ) ->
     /// Remove the account owner key so it can be ignored during iteration.
     parsedTomlTable.erase( kAccountBookOwnerKey );
   }
-  AccountBook accountBook { accountBookOwner.value() };
+  AccountBook accountBook { accountBookOwner.value(), notesPool, allocator };
+
+  // Books written before id policies existed lack this key and use random ids.
+  if ( auto const policyName = parsedTomlTable[kAccountBookTransactionIdPolicyKey].value< std::string_view >() ) {
+    if ( *policyName == kTransactionIdPolicyTimeOrdered ) {
+      accountBook.setTransactionIdPolicy( TransactionIdPolicy::kTimeOrdered );
+    } else if ( *policyName != kTransactionIdPolicyRandom ) {
+      throw DbscSerializationException(
+        std::format( "Unknown value '{}' for key '{}'", *policyName, kAccountBookTransactionIdPolicyKey ) );
+    }
+    parsedTomlTable.erase( kAccountBookTransactionIdPolicyKey );
+  }
+
+  TransferRecords transfers;
+  if ( auto* const transferArray = parsedTomlTable[kAccountBookTransfersKey].as_array() ) {
+    for ( auto& transferTableNode : *transferArray ) {
+      auto* const transferTable = transferTableNode.as_table();
+      if ( transferTable == nullptr ) {
+        throw DbscSerializationException( std::format( "Expected tables in '{}'", kAccountBookTransfersKey ) );
+      }
+      std::shared_ptr< Transfer const > transfer
+        = std::allocate_shared< Transfer >( allocator, readTransferInternal( *transferTable, notesPool ) );
+      UuidString const transferId = transfer->id();
+      transfers.emplace( transferId, std::move( transfer ) );
+    }
+    parsedTomlTable.erase( kAccountBookTransfersKey );
+  }
+
+  SplitRecords splits;
+  if ( auto* const splitArray = parsedTomlTable[kAccountBookSplitsKey].as_array() ) {
+    for ( auto& splitTableNode : *splitArray ) {
+      auto* const splitTable = splitTableNode.as_table();
+      if ( splitTable == nullptr ) {
+        throw DbscSerializationException( std::format( "Expected tables in '{}'", kAccountBookSplitsKey ) );
+      }
+      std::shared_ptr< Split const > split
+        = std::allocate_shared< Split >( allocator, readSplitInternal( *splitTable, notesPool ) );
+      UuidString const splitId = split->id();
+      splits.emplace( splitId, std::move( split ) );
+    }
+    parsedTomlTable.erase( kAccountBookSplitsKey );
+  }
+
+  // Older files store both legs of a transfer in full. Pair them up so they
+  // are loaded as one shared record.
+  {
+    std::unordered_map< UuidString, Transaction > unpairedLegs;
+    for ( auto& [key, tomlValue] : parsedTomlTable ) {
+      auto* const accountTable = tomlValue.as_table();
+      auto* const transactionArray =
+        accountTable != nullptr ? ( *accountTable )[kAccountTransactionsKey].as_array() : nullptr;
+      if ( transactionArray == nullptr ) {
+        continue;
+      }
+      auto const accountId = UuidStringUtil::fromString( key.str() );
+      for ( auto& transactionTableNode : *transactionArray ) {
+        auto* const transactionTable = transactionTableNode.as_table();
+        if ( transactionTable == nullptr || transactionTable->contains( kTransferReferenceKey )
+             || transactionTable->contains( kSplitReferenceKey ) ) {
+          continue;
+        }
+        Transaction leg = readTransactionInternal( *transactionTable, accountId );
+        if ( UuidStringUtil::isNil( leg.otherPartyId() ) || transfers.contains( leg.transactionId() ) ) {
+          continue;
+        }
+        auto const firstLeg = unpairedLegs.find( leg.transactionId() );
+        if ( firstLeg == unpairedLegs.end() ) {
+          UuidString const transactionId = leg.transactionId();
+          unpairedLegs.emplace( transactionId, std::move( leg ) );
+        } else if ( Transaction::isPair( firstLeg->second, leg ) ) {
+          // The leg keeps a private copy of the notes; the record interns them.
+          Transfer const paired = Transfer::fromLeg( firstLeg->second );
+          transfers.emplace( leg.transactionId(),
+                             std::allocate_shared< Transfer >( allocator,
+                                                               paired.id(),
+                                                               paired.sourceId(),
+                                                               paired.destinationId(),
+                                                               paired.sourceAmount(),
+                                                               paired.timestamp(),
+                                                               pooledNotes( notesPool, paired.notes() ) ) );
+          unpairedLegs.erase( firstLeg );
+        }
+      }
+    }
+  }
 
   for ( auto& [key, tomlValue] : parsedTomlTable ) {
     if ( tomlValue.is_table() ) {
@@ -59,7 +173,7 @@ auto TomlSerializer::readAccountBook( std::filesystem::path const& filePath ) ->
 
       auto* accountTable = tomlValue.as_table();
       BSLS_ASSERT( accountTable );
-      accountBook.addParsedAccount( readAccountInternal( *accountTable, accountId ) );
+      accountBook.addParsedAccount( readAccountInternal( *accountTable, accountId, transfers, splits, allocator ) );
     }
   }
 
@@ -67,10 +181,19 @@ auto TomlSerializer::readAccountBook( std::filesystem::path const& filePath ) ->
 }
 
 auto TomlSerializer::readAccountInternal( InputType& accountTomlTable, UuidString const& accountId ) -> Account
+{
+  return readAccountInternal( accountTomlTable, accountId, {} );
+}
+
+auto TomlSerializer::readAccountInternal( InputType& accountTomlTable,
+                                          UuidString const& accountId,
+                                          TransferRecords const& transfers,
+                                          SplitRecords const& splits,
+                                          Account::allocator_type allocator ) -> Account
 {
   auto const accountName        = accountTomlTable[kAccountNameKey].value< std::string >().value();
   auto const accountDescription = accountTomlTable[kAccountDescriptionKey].value< std::string >().value();
-  Account account { accountId, accountName, accountDescription };
+  Account account { accountId, accountName, accountDescription, allocator };
   account.activate(); // Ensure we can add the previous transactions.
 
   auto* const transactionArrayOfTables = accountTomlTable[kAccountTransactionsKey].as_array();
@@ -78,7 +201,33 @@ auto TomlSerializer::readAccountInternal( InputType& accountTomlTable, UuidStrin
   for ( auto& transactionTableNode : *transactionArrayOfTables ) {
     BSLS_ASSERT( transactionTableNode.is_table() );
     auto* transactionTable = transactionTableNode.as_table();
-    account.logTransaction( TomlSerializer::readTransactionInternal( *transactionTable, accountId ) );
+    if ( auto const transferId = ( *transactionTable )[kTransferReferenceKey].value< std::string_view >() ) {
+      auto const transfer = transfers.find( UuidStringUtil::fromString( *transferId ) );
+      if ( transfer == transfers.end() || not transfer->second->involves( accountId ) ) {
+        throw DbscSerializationException(
+          std::format( "Account {} references unknown transfer {}.", accountId, *transferId ) );
+      }
+      account.logTransfer( transfer->second );
+      continue;
+    }
+    if ( auto const splitId = ( *transactionTable )[kSplitReferenceKey].value< std::string_view >() ) {
+      auto const split = splits.find( UuidStringUtil::fromString( *splitId ) );
+      if ( split == splits.end() || not split->second->involves( accountId ) ) {
+        throw DbscSerializationException(
+          std::format( "Account {} references unknown split {}.", accountId, *splitId ) );
+      }
+      account.logSplit( split->second );
+      continue;
+    }
+
+    Transaction transaction = TomlSerializer::readTransactionInternal( *transactionTable, accountId );
+    if ( auto const transfer = transfers.find( transaction.transactionId() );
+         transfer != transfers.end() && transfer->second->involves( accountId )
+         && transfer->second->leg( accountId ) == transaction ) {
+      account.logTransfer( transfer->second );
+    } else {
+      account.logTransaction( transaction );
+    }
   }
 
   auto const accountIsActive = accountTomlTable[kAccountActiveStatusKey].value< bool >().value();
@@ -108,16 +257,93 @@ auto TomlSerializer::readTransactionInternal( InputType& transactionTable, UuidS
   return Transaction( transactionId, owningPartyId, otherPartyId, transactionAmount, timeStamp, transactionNotes );
 }
 
+auto TomlSerializer::readTransferInternal( InputType& transferTable, std::shared_ptr< NotesPool > const& notesPool )
+  -> Transfer
+{
+  auto readId = [&transferTable]( std::string_view key ) {
+    return UuidStringUtil::fromString( transferTable[key].value< std::string_view >().value() );
+  };
+  auto const amountString = transferTable[kTransactionAmountKey].value< TomlCurrencyType >().value();
+  auto const timeString   = transferTable[kTransactionTimeStampKey].value< TomlDateTimeType >().value();
+
+  return Transfer( readId( kTransactionIdKey ),
+                   readId( kTransferSourceIdKey ),
+                   readId( kTransferDestinationIdKey ),
+                   TransactionUtil::currencyFromString( amountString ),
+                   TransactionUtil::timestampFromString( timeString ),
+                   pooledNotes( notesPool, transferTable[kTransactionNotesKey].value< std::string_view >().value() ) );
+}
+
+auto TomlSerializer::readSplitInternal( InputType& splitTable, std::shared_ptr< NotesPool > const& notesPool ) -> Split
+{
+  auto const amountString = splitTable[kTransactionAmountKey].value< TomlCurrencyType >().value();
+  auto const timeString   = splitTable[kTransactionTimeStampKey].value< TomlDateTimeType >().value();
+
+  auto* const legArray = splitTable[kSplitLegsKey].as_array();
+  if ( legArray == nullptr ) {
+    throw DbscSerializationException( std::format( "Incorrect type for key '{}'", kSplitLegsKey ) );
+  }
+  std::vector< SplitLeg > legs;
+  legs.reserve( legArray->size() );
+  for ( auto& legNode : *legArray ) {
+    auto* const legTable = legNode.as_table();
+    if ( legTable == nullptr ) {
+      throw DbscSerializationException( std::format( "Expected tables in '{}'", kSplitLegsKey ) );
+    }
+    auto const accountId = ( *legTable )[kSplitLegAccountIdKey].value< std::string_view >().value();
+    auto const legAmount = ( *legTable )[kTransactionAmountKey].value< TomlCurrencyType >().value();
+    legs.push_back( { UuidStringUtil::fromString( accountId ), TransactionUtil::currencyFromString( legAmount ) } );
+  }
+
+  return Split( UuidStringUtil::fromString( splitTable[kTransactionIdKey].value< std::string_view >().value() ),
+                TransactionUtil::currencyFromString( amountString ),
+                TransactionUtil::timestampFromString( timeString ),
+                pooledNotes( notesPool, splitTable[kTransactionNotesKey].value< std::string_view >().value() ),
+                legs );
+}
+
 void TomlSerializer::writeAccountBook( AccountBook const& accountBook, std::filesystem::path const& filePath )
 {
   toml::table topLevelTable;
   toml::value< std::string > accountOwner { accountBook.owner() };
   topLevelTable.insert( kAccountBookOwnerKey, accountOwner );
+  toml::value< std::string > const transactionIdPolicy { std::string(
+    accountBook.transactionIdPolicy() == TransactionIdPolicy::kTimeOrdered ? kTransactionIdPolicyTimeOrdered
+                                                                           : kTransactionIdPolicyRandom ) };
+  topLevelTable.insert( kAccountBookTransactionIdPolicyKey, transactionIdPolicy );
+
+  // Each shared transfer or split record is written once, on its first
+  // appearance.
+  toml::array transferArray {};
+  toml::array splitArray {};
+  UuidIndex writtenRecords;
+  for ( auto const& [accountId, account] : accountBook ) {
+    TransactionStore const& store = account.transactions();
+    for ( TransactionStore::Row row = 0; row < store.size(); ++row ) {
+      auto const& transfer = store.transfer( row );
+      auto const& split    = store.split( row );
+      if ( transfer != nullptr && writtenRecords.insert( transfer->id(), 0 ) ) {
+        toml::table transferTable;
+        TomlSerializer::writeTransferInternal( transferTable, *transfer );
+        transferArray.push_back( std::move( transferTable ) );
+      } else if ( split != nullptr && writtenRecords.insert( split->id(), 0 ) ) {
+        toml::table splitTable;
+        TomlSerializer::writeSplitInternal( splitTable, *split );
+        splitArray.push_back( std::move( splitTable ) );
+      }
+    }
+  }
+  if ( not transferArray.empty() ) {
+    topLevelTable.insert( kAccountBookTransfersKey, std::move( transferArray ) );
+  }
+  if ( not splitArray.empty() ) {
+    topLevelTable.insert( kAccountBookSplitsKey, std::move( splitArray ) );
+  }
 
   for ( auto const& [accountId, account] : accountBook ) {
     toml::table accountTable;
     TomlSerializer::writeAccountInternal( accountTable, account );
-    topLevelTable.insert( accountId.view(), std::move( accountTable ) );
+    topLevelTable.insert( accountId.toStdString(), std::move( accountTable ) );
   }
 
   std::ofstream ofs { filePath };
@@ -137,9 +363,16 @@ void TomlSerializer::writeAccountInternal( OutputType& accountTable, Account con
   accountTable.insert( kAccountActiveStatusKey, accountIsActive );
 
   toml::array transactionArray {};
-  for ( auto const& [_, transaction] : account ) {
+  TransactionStore const& store = account.transactions();
+  for ( TransactionStore::Row row = 0; row < store.size(); ++row ) {
     toml::table transactionTable;
-    TomlSerializer::writeTransactionInternal( transactionTable, transaction );
+    if ( auto const& transfer = store.transfer( row ) ) {
+      transactionTable.insert( kTransferReferenceKey, transfer->id().toStdString() );
+    } else if ( auto const& split = store.split( row ) ) {
+      transactionTable.insert( kSplitReferenceKey, split->id().toStdString() );
+    } else {
+      TomlSerializer::writeTransactionInternal( transactionTable, store.materialize( row, account.id() ) );
+    }
     transactionArray.push_back( std::move( transactionTable ) );
   }
   BSLS_ASSERT( transactionArray.empty() || transactionArray.is_array_of_tables() );
@@ -148,11 +381,11 @@ void TomlSerializer::writeAccountInternal( OutputType& accountTable, Account con
 
 void TomlSerializer::writeTransactionInternal( OutputType& transactionTable, Transaction const& transaction )
 {
-  toml::value< std::string > const transactionId { transaction.transactionId().view() };
-  toml::value< std::string > const otherPartyId { transaction.otherPartyId().view() };
+  toml::value< std::string > const transactionId { transaction.transactionId().toStdString() };
+  toml::value< std::string > const otherPartyId { transaction.otherPartyId().toStdString() };
   toml::value< TomlCurrencyType > const transactionAmount { TransactionUtil::currencyToString( transaction.amount() ) };
   toml::value< TomlDateTimeType > const dateTime { TransactionUtil::timestampToString( transaction.timestamp() ) };
-  toml::value< std::string > const notes { transaction.notes() };
+  toml::value< std::string > const notes { std::string( transaction.notes() ) };
 
   transactionTable.insert( kTransactionIdKey, std::move( transactionId ) );
   transactionTable.insert( kTransactionOtherPartyIdKey, std::move( otherPartyId ) );
@@ -161,6 +394,30 @@ void TomlSerializer::writeTransactionInternal( OutputType& transactionTable, Tra
   transactionTable.insert( kTransactionNotesKey, std::move( notes ) );
 }
 
+void TomlSerializer::writeTransferInternal( OutputType& transferTable, Transfer const& transfer )
+{
+  transferTable.insert( kTransactionIdKey, transfer.id().toStdString() );
+  transferTable.insert( kTransferSourceIdKey, transfer.sourceId().toStdString() );
+  transferTable.insert( kTransferDestinationIdKey, transfer.destinationId().toStdString() );
+  transferTable.insert( kTransactionAmountKey, TransactionUtil::currencyToString( transfer.sourceAmount() ) );
+  transferTable.insert( kTransactionTimeStampKey, TransactionUtil::timestampToString( transfer.timestamp() ) );
+  transferTable.insert( kTransactionNotesKey, std::string( transfer.notes() ) );
+}
+
+void TomlSerializer::writeSplitInternal( OutputType& splitTable, Split const& split )
+{
+  toml::array legArray {};
+  for ( SplitLeg const& leg : split.legs() ) {
+    legArray.push_back( toml::table { { kSplitLegAccountIdKey, leg.mAccountId.toStdString() },
+                                      { kTransactionAmountKey, TransactionUtil::currencyToString( leg.mAmount ) } } );
+  }
+  splitTable.insert( kTransactionIdKey, split.id().toStdString() );
+  splitTable.insert( kTransactionAmountKey, TransactionUtil::currencyToString( split.amount() ) );
+  splitTable.insert( kTransactionTimeStampKey, TransactionUtil::timestampToString( split.timestamp() ) );
+  splitTable.insert( kTransactionNotesKey, std::string( split.notes() ) );
+  splitTable.insert( kSplitLegsKey, std::move( legArray ) );
+}
+
 } // namespace dbsc
 
 // -----------------------------------------------------------------------------
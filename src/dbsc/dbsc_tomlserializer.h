@@ -9,18 +9,39 @@
 //
 //@DESCRIPTION: This component defines a specific implementation for
 //  dbsc::DbsSerializer.
+//
+//  Internal transfers are written once, in a top-level `transfers` array of
+//  tables; each account lists its leg as `{ transferId = "..." }` at its
+//  position in the transaction list. Files written before transfers were
+//  shared list both legs in full; such pairs are recognized on read and
+//  loaded as shared transfers.
+//
+//  Splits (see dbsc_split) are likewise written once, in a top-level `splits`
+//  array of tables with their legs as an inline `legs` array of
+//  `{ accountId, amount }` tables; each account involved lists its leg as
+//  `{ splitId = "..." }`.
+//
+//  `readAccountBook` optionally takes the allocator the book is built in (see
+//  dbsc_accountbook), and the notes pool, so that books read concurrently can
+//  share one (see dbsc_bookset). Reading does not modify shared state other
+//  than the pool, which is thread-safe.
 
 #include <dbsc_dbscserializer.h>
+#include <dbsc_notespool.h>
 #include <dbsc_sharedapi.h>
 
 #include <toml++/toml.hpp>
 
 #include <filesystem>
+#include <memory>
+#include <unordered_map>
 
 namespace dbsc {
 class Transaction;
 class Account;
 class AccountBook;
+class Split;
+class Transfer;
 class UuidString;
 
 /// This class adheres to the dbsc::DbscSerializer concept.
@@ -29,14 +50,39 @@ class DBSC_API TomlSerializer
 public:
   using InputType  = toml::table;
   using OutputType = InputType;
+  /// Transfer records by id, shared by the accounts that reference them.
+  using TransferRecords = std::unordered_map< UuidString, std::shared_ptr< Transfer const > >;
+  /// Split records by id, shared by the accounts that reference them.
+  using SplitRecords = std::unordered_map< UuidString, std::shared_ptr< Split const > >;
 
-  [[nodiscard]] static auto readAccountBook( std::filesystem::path const& filePath ) -> AccountBook;
+  [[nodiscard]] static auto readAccountBook( std::filesystem::path const& filePath,
+                                             AccountBook::allocator_type allocator = {} ) -> AccountBook;
+  /// As above, interning the notes of the book in @p notesPool.
+  [[nodiscard]] static auto readAccountBook( std::filesystem::path const& filePath,
+                                             std::shared_ptr< NotesPool > notesPool,
+                                             AccountBook::allocator_type allocator = {} ) -> AccountBook;
   [[nodiscard]] static auto readAccountInternal( InputType& inSource, UuidString const& accountId ) -> Account;
+  /// As above, resolving transfer references (and full legs of known
+  /// transfers) through @p transfers and split references through
+  /// @p splits, and building the account with @p allocator.
+  [[nodiscard]] static auto readAccountInternal( InputType& inSource,
+                                                 UuidString const& accountId,
+                                                 TransferRecords const& transfers,
+                                                 SplitRecords const& splits        = {},
+                                                 Account::allocator_type allocator = {} ) -> Account;
   [[nodiscard]] static auto readTransactionInternal( InputType& inSource, UuidString const& owningPartyId )
     -> Transaction;
+  /// Read a transfer record, interning its notes in @p notesPool.
+  [[nodiscard]] static auto readTransferInternal( InputType& inSource, std::shared_ptr< NotesPool > const& notesPool )
+    -> Transfer;
+  /// Read a split record, interning its notes in @p notesPool.
+  [[nodiscard]] static auto readSplitInternal( InputType& inSource, std::shared_ptr< NotesPool > const& notesPool )
+    -> Split;
   static void writeAccountBook( AccountBook const& accountBook, std::filesystem::path const& filePath );
   static void writeAccountInternal( OutputType& oDestinationBuf, Account const& account );
   static void writeTransactionInternal( OutputType& oDestinationBuf, Transaction const& transaction );
+  static void writeTransferInternal( OutputType& oDestinationBuf, Transfer const& transfer );
+  static void writeSplitInternal( OutputType& oDestinationBuf, Split const& split );
 };
 } // namespace dbsc
 
@@ -2,14 +2,25 @@
 #include <dbsc_account.h>
 #include <dbsc_accountbook.h>
 #include <dbsc_dbscserializer.h>
+#include <dbsc_notespool.h>
 #include <dbsc_tomlserializer.h>
 #include <dbsc_transaction.h>
+#include <dbsc_transactionstore.h>
+#include <dbsc_transfer.h>
+#include <dbsc_uuidstring.h>
 
 #include <bdldfp_decimal.h>
 #include <bsls_assert.h>
 
+#include <chrono>
+#include <cstddef>
 #include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
 #include <ranges>
+#include <string_view>
+#include <vector>
 
 namespace {
 using namespace BloombergLP::bdldfp::DecimalLiterals;
@@ -24,6 +35,7 @@ auto transactionAmount() -> BloombergLP::bdldfp::Decimal64
 auto createAccountBook() -> dbsc::AccountBook
 {
   dbsc::AccountBook book { "tjdwill" };
+  book.setTransactionIdPolicy( dbsc::TransactionIdPolicy::kTimeOrdered );
   auto accountId1 = book.createAccount( "TestAccount1", "The first test account in the book" );
   auto accountId2 = book.createAccount( "TestAccount2", "The second test account in the book" );
 
@@ -34,6 +46,10 @@ auto createAccountBook() -> dbsc::AccountBook
     book.makeTransaction( transactionAmount(), std::format( "Transaction #{}", count ), accountId1, accountId2 );
   }
 
+  std::vector< dbsc::SplitAllocation > const allocations { { book.handle( accountId1 ), "800.00"_d64 },
+                                                           { book.handle( accountId2 ), "200.00"_d64 } };
+  book.makeSplitTransaction( "1000.00"_d64, "Paycheck", allocations );
+
   return book;
 }
 
@@ -53,10 +69,90 @@ int main()
 
   auto const parsedAccountBook = dbsc::readAccountBook< dbsc::TomlSerializer >( saveFile );
   BSLS_ASSERT( parsedAccountBook.owner() == accountBook().owner() );
+  BSLS_ASSERT( parsedAccountBook.transactionIdPolicy() == accountBook().transactionIdPolicy() );
   for ( auto const& [parsed, groundTruth] : std::views::zip( parsedAccountBook, accountBook() ) ) {
     BSLS_ASSERT( parsed == groundTruth );
   }
 
+  // Transfers are written once and shared again after reading.
+  for ( auto const& [_, account] : parsedAccountBook ) {
+    auto const& store = account.transactions();
+    for ( dbsc::TransactionStore::Row row = 0; row < store.size(); ++row ) {
+      bool const isInternal = not dbsc::UuidStringUtil::isNil( store.counterpartyId( row ) );
+      BSLS_ASSERT( ( store.transfer( row ) != nullptr ) == isInternal );
+    }
+  }
+
+  // So are splits.
+  {
+    auto const& first      = *parsedAccountBook.begin();
+    auto const& second     = *std::next( parsedAccountBook.begin() );
+    auto const& firstStore = first.second.transactions();
+    auto const splitRow    = static_cast< dbsc::TransactionStore::Row >( firstStore.size() - 1 );
+    auto const& split      = firstStore.split( splitRow );
+    BSLS_ASSERT( split != nullptr );
+    BSLS_ASSERT( split->legs().size() == 2 );
+    BSLS_ASSERT( split.get() == second.second.transactions().split( *second.second.rowOf( split->id() ) ).get() );
+  }
+
+  // Files that list both legs of a transfer in full load as shared transfers.
+  {
+    auto const firstId    = dbsc::UuidStringUtil::generate();
+    auto const secondId   = dbsc::UuidStringUtil::generate();
+    auto const transferId = dbsc::UuidStringUtil::generate();
+    auto const timeStamp  = dbsc::TransactionUtil::timestampToString( std::chrono::system_clock::now() );
+    auto const leg        = [&]( dbsc::UuidString const& otherPartyId, std::string_view amount ) {
+      return std::format( "transactions = [ {{ transactionId = '{}', otherPartyId = '{}', amount = '{}', timeStamp = "
+                                 "'{}', notes = 'legacy' }} ]\n",
+                          transferId,
+                          otherPartyId,
+                          amount,
+                          timeStamp );
+    };
+    std::filesystem::path const legacyFile { "legacyAccountBook.toml"sv };
+    {
+      std::ofstream legacy { legacyFile };
+      legacy << "owner = 'legacy'\n";
+      legacy << std::format( "['{}']\nname = 'First'\ndescription = ''\nisActive = true\n", firstId )
+             << leg( secondId, "-10.00" );
+      legacy << std::format( "['{}']\nname = 'Second'\ndescription = ''\nisActive = true\n", secondId )
+             << leg( firstId, "10.00" );
+    }
+    auto const legacyBook = dbsc::readAccountBook< dbsc::TomlSerializer >( legacyFile );
+    auto const& firstRecord  = legacyBook.account( firstId ).transactions().transfer( 0 );
+    auto const& secondRecord = legacyBook.account( secondId ).transactions().transfer( 0 );
+    BSLS_ASSERT( firstRecord != nullptr );
+    BSLS_ASSERT( firstRecord.get() == secondRecord.get() );
+    BSLS_ASSERT( legacyBook.account( secondId ).balance() == "10.00"_d64 );
+    BSLS_ASSERT( firstRecord->sharedNotes().pool() == &legacyBook.notesPool() );
+  }
+
+  // Repeated transfer notes are stored once, in the book's pool.
+  {
+    constexpr std::size_t kRentCount = 12;
+    dbsc::AccountBook book { "rent" };
+    auto const checking = book.createAccount( "Checking", "" );
+    auto const landlord = book.createAccount( "Landlord", "" );
+    for ( std::size_t month = 0; month < kRentCount; ++month ) {
+      book.makeTransaction( "-1500.00"_d64, "Monthly rent", checking, landlord );
+    }
+    std::filesystem::path const rentFile { "rentAccountBook.toml"sv };
+    dbsc::writeAccountBook< dbsc::TomlSerializer >( book, rentFile );
+
+    auto const rentBook                = dbsc::readAccountBook< dbsc::TomlSerializer >( rentFile );
+    dbsc::NotesPool::Stats const stats = rentBook.notesPool().stats();
+    BSLS_ASSERT( stats.mUniqueCount == 1 );
+    BSLS_ASSERT( stats.mInternCount >= kRentCount );
+    BSLS_ASSERT( stats.bytesSaved() == ( stats.mInternCount - 1 ) * "Monthly rent"sv.size() );
+
+    auto const& store = rentBook.account( checking ).transactions();
+    BSLS_ASSERT( store.size() == kRentCount );
+    for ( dbsc::TransactionStore::Row row = 0; row < store.size(); ++row ) {
+      BSLS_ASSERT( store.transfer( row )->sharedNotes().pool() == &rentBook.notesPool() );
+      BSLS_ASSERT( store.transfer( row )->notes().data() == store.transfer( 0 )->notes().data() );
+    }
+  }
+
   return 0;
 }
 
@@ -0,0 +1,159 @@
+// dbsc_topamounts.cpp
+#include "dbsc_topamounts.h"
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace dbsc {
+
+TopAmounts::TopAmounts( AmountDirection direction, std::size_t capacity, allocator_type const& allocator )
+  : mDirection( direction )
+  , mCapacity( capacity )
+  , mHeap( allocator )
+{
+  mHeap.reserve( capacity );
+}
+
+TopAmounts::TopAmounts( TopAmounts const& original, allocator_type const& allocator )
+  : mDirection( original.mDirection )
+  , mCapacity( original.mCapacity )
+  , mHeap( allocator )
+{
+  mHeap.reserve( mCapacity );
+  mHeap.assign( original.mHeap.begin(), original.mHeap.end() );
+}
+
+TopAmounts::TopAmounts( TopAmounts&& original ) noexcept = default;
+
+TopAmounts::TopAmounts( TopAmounts&& original, allocator_type const& allocator )
+  : mDirection( original.mDirection )
+  , mCapacity( original.mCapacity )
+  , mHeap( std::move( original.mHeap ), allocator )
+{
+  mHeap.reserve( mCapacity );
+  original.mHeap.clear();
+}
+
+auto TopAmounts::operator=( TopAmounts const& rhs ) -> TopAmounts&
+{
+  if ( this != &rhs ) {
+    mDirection = rhs.mDirection;
+    mCapacity  = rhs.mCapacity;
+    mHeap.reserve( mCapacity );
+    mHeap.assign( rhs.mHeap.begin(), rhs.mHeap.end() );
+  }
+  return *this;
+}
+
+auto TopAmounts::operator=( TopAmounts&& rhs ) -> TopAmounts&
+{
+  mDirection = rhs.mDirection;
+  mCapacity  = rhs.mCapacity;
+  mHeap      = std::move( rhs.mHeap );
+  mHeap.reserve( mCapacity );
+  rhs.mHeap.clear();
+  return *this;
+}
+
+auto TopAmounts::direction() const noexcept -> AmountDirection
+{
+  return mDirection;
+}
+
+auto TopAmounts::capacity() const noexcept -> std::size_t
+{
+  return mCapacity;
+}
+
+auto TopAmounts::size() const noexcept -> std::size_t
+{
+  return mHeap.size();
+}
+
+auto TopAmounts::entries() const -> std::vector< RankedAmount >
+{
+  std::vector< RankedAmount > result( mHeap.begin(), mHeap.end() );
+  std::ranges::sort( result, [this]( RankedAmount const& a, RankedAmount const& b ) {
+    return outranks( mDirection, a, b );
+  } );
+  return result;
+}
+
+auto TopAmounts::outranks( AmountDirection direction, RankedAmount const& a, RankedAmount const& b ) -> bool
+{
+  if ( a.mAmount != b.mAmount ) {
+    return direction == AmountDirection::kInflow ? a.mAmount > b.mAmount : a.mAmount < b.mAmount;
+  }
+  if ( a.mTimeStamp != b.mTimeStamp ) {
+    return a.mTimeStamp < b.mTimeStamp;
+  }
+  if ( a.mTransactionId != b.mTransactionId ) {
+    return a.mTransactionId < b.mTransactionId;
+  }
+  return a.mAccountId < b.mAccountId;
+}
+
+auto TopAmounts::get_allocator() const noexcept -> allocator_type
+{
+  return mHeap.get_allocator();
+}
+
+void TopAmounts::add( RankedAmount const& amount )
+{
+  BloombergLP::bdldfp::Decimal64 const zero {};
+  if ( mDirection == AmountDirection::kInflow ? not( amount.mAmount > zero ) : not( amount.mAmount < zero ) ) {
+    return;
+  }
+  // With `outranks` as the ordering, the heap's front is the amount every
+  // other outranks.
+  auto const ordering = [this]( RankedAmount const& a, RankedAmount const& b ) {
+    return outranks( mDirection, a, b );
+  };
+  if ( mHeap.size() < mCapacity ) {
+    mHeap.push_back( amount );
+    std::ranges::push_heap( mHeap, ordering );
+  } else if ( not mHeap.empty() && outranks( mDirection, amount, mHeap.front() ) ) {
+    std::ranges::pop_heap( mHeap, ordering );
+    mHeap.back() = amount;
+    std::ranges::push_heap( mHeap, ordering );
+  }
+}
+
+void TopAmounts::merge( TopAmounts const& other )
+{
+  BSLS_ASSERT( other.mDirection == mDirection );
+  if ( &other == this ) {
+    TopAmounts const copy( other );
+    merge( copy );
+    return;
+  }
+  for ( RankedAmount const& amount : other.mHeap ) {
+    add( amount );
+  }
+}
+
+void TopAmounts::clear()
+{
+  mHeap.clear();
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,142 @@
+// dbsc_topamounts.h
+#ifndef INCLUDED_DBSC_TOPAMOUNTS
+#define INCLUDED_DBSC_TOPAMOUNTS
+
+//@PURPOSE: Provide the N largest deposits or withdrawals of a stream.
+//
+//@CLASSES:
+//  dbsc::TopAmounts: a bounded heap keeping the largest amounts in one
+//    direction.
+//  dbsc::RankedAmount: one transaction's amount, with what identifies it.
+//  dbsc::AmountDirection: selects deposits or withdrawals.
+//
+//@DESCRIPTION: "The twenty largest withdrawals" needs neither a copy of every
+//  transaction nor a sort. A TopAmounts of capacity N keeps the N largest
+//  amounts added to it in a min-heap, whose root is the smallest of them: a
+//  new amount either loses to the root, in O(1), or replaces it, in O(log N).
+//  Selecting the top N of n amounts thus costs O(n log N) time and O(N)
+//  memory.
+//
+//  Deposits rank by amount, withdrawals by magnitude; amounts of the other
+//  direction, and zero, are ignored. Equal amounts rank the earlier
+//  transaction first, then by transaction id and account id, so the entries
+//  kept do not depend on the order in which amounts are added. Two heaps of
+//  the same direction merge into the top N of their union, which makes the
+//  largest amounts of a book the merge of those of its accounts.
+//
+//  The heap is obtained from the allocator supplied at construction, with
+//  room for the capacity, so `add` never allocates.
+//
+/// Usage
+/// -----
+/// Example 1: The largest withdrawals of a year
+///
+/// ```cpp
+/// dbsc::TopAmounts top { dbsc::AmountDirection::kOutflow, 20 };
+/// for ( dbsc::Transaction const& transaction : account.transactionsBetween( january, nextJanuary ) ) {
+///     top.add( { account.id(), transaction.transactionId(), transaction.amount(), transaction.timestamp() } );
+/// }
+/// std::vector< dbsc::RankedAmount > const largest = top.entries(); // largest first
+/// ```
+
+#include <dbsc_sharedapi.h>
+#include <dbsc_transaction.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace dbsc {
+
+/// Which amounts a ranking considers.
+enum class AmountDirection
+{
+  /// Amounts above zero, largest first.
+  kInflow,
+  /// Amounts below zero, largest magnitude first.
+  kOutflow,
+};
+
+/// The amount of one account's transaction, as ranked by TopAmounts.
+struct RankedAmount
+{
+  UuidString mAccountId;
+  UuidString mTransactionId;
+  BloombergLP::bdldfp::Decimal64 mAmount;
+  TimeStamp mTimeStamp;
+
+  [[nodiscard]] friend auto operator==( RankedAmount const&, RankedAmount const& ) -> bool = default;
+};
+
+/// The largest amounts of one direction among those added.
+class TopAmounts
+{
+public:
+  using allocator_type = bsl::allocator< char >; // NOLINT
+
+  /// Keep the @p capacity largest amounts of @p direction.
+  DBSC_API TopAmounts( AmountDirection direction,
+                       std::size_t capacity,
+                       allocator_type const& allocator = allocator_type() );
+  DBSC_API TopAmounts( TopAmounts const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API TopAmounts( TopAmounts&& original ) noexcept;
+  DBSC_API TopAmounts( TopAmounts&& original, allocator_type const& allocator );
+  DBSC_API auto operator=( TopAmounts const& rhs ) -> TopAmounts&;
+  DBSC_API auto operator=( TopAmounts&& rhs ) -> TopAmounts&;
+
+  [[nodiscard]] DBSC_API auto direction() const noexcept -> AmountDirection;
+  [[nodiscard]] DBSC_API auto capacity() const noexcept -> std::size_t;
+  /// The number of amounts kept: the capacity, or fewer if fewer were added.
+  [[nodiscard]] DBSC_API auto size() const noexcept -> std::size_t;
+
+  /// @return the amounts kept, largest first.
+  [[nodiscard]] DBSC_API auto entries() const -> std::vector< RankedAmount >;
+
+  /// Query if @p a ranks ahead of @p b in @p direction.
+  [[nodiscard]] DBSC_API static auto outranks( AmountDirection direction, RankedAmount const& a, RankedAmount const& b )
+    -> bool;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+  /// Keep @p amount if it is of this direction and ranks among the largest.
+  /// Adding the same transaction twice keeps it twice.
+  DBSC_API void add( RankedAmount const& amount );
+
+  /// Keep the largest of the amounts kept here and by @p other.
+  /// @pre `other.direction() == direction()`
+  DBSC_API void merge( TopAmounts const& other );
+
+  /// Forget every amount.
+  DBSC_API void clear();
+
+private:
+  AmountDirection mDirection;
+  std::size_t mCapacity;
+  /// Ordered so that the front is the lowest ranked amount kept.
+  bsl::vector< RankedAmount > mHeap;
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
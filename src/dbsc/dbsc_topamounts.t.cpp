@@ -0,0 +1,129 @@
+// dbsc_topamounts.t.cpp
+// Test driver for dbsc::TopAmounts
+#include <dbsc_topamounts.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bslma_testallocator.h>
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+using namespace std::chrono;
+
+static auto amountOf( BloombergLP::bdldfp::Decimal64 amount, int day ) -> dbsc::RankedAmount
+{
+  static dbsc::UuidString const accountId = dbsc::UuidStringUtil::generate();
+  return { accountId, dbsc::UuidStringUtil::generate(), amount, sys_days( year( 2025 ) / 1 / 1 ) + days( day ) };
+}
+
+static void testDirections()
+{
+  dbsc::TopAmounts deposits { dbsc::AmountDirection::kInflow, 2 };
+  dbsc::TopAmounts withdrawals { dbsc::AmountDirection::kOutflow, 2 };
+  BSLS_ASSERT( deposits.direction() == dbsc::AmountDirection::kInflow );
+  BSLS_ASSERT( deposits.capacity() == 2 );
+  BSLS_ASSERT( deposits.entries().empty() );
+
+  std::vector< dbsc::RankedAmount > const amounts { amountOf( "10.00"_d64, 0 ),  amountOf( "-3.00"_d64, 1 ),
+                                                    amountOf( "0.00"_d64, 2 ),   amountOf( "250.50"_d64, 3 ),
+                                                    amountOf( "-400.00"_d64, 4 ), amountOf( "7.00"_d64, 5 ),
+                                                    amountOf( "-3.50"_d64, 6 ) };
+  for ( dbsc::RankedAmount const& amount : amounts ) {
+    deposits.add( amount );
+    withdrawals.add( amount );
+  }
+  BSLS_ASSERT( deposits.size() == 2 );
+  BSLS_ASSERT( deposits.entries() == ( std::vector< dbsc::RankedAmount > { amounts[3], amounts[0] } ) );
+  BSLS_ASSERT( withdrawals.entries() == ( std::vector< dbsc::RankedAmount > { amounts[4], amounts[6] } ) );
+
+  // Equal amounts rank the earlier transaction first.
+  dbsc::TopAmounts ties { dbsc::AmountDirection::kOutflow, 2 };
+  dbsc::RankedAmount const late  = amountOf( "-5.00"_d64, 9 );
+  dbsc::RankedAmount const early = amountOf( "-5.00"_d64, 8 );
+  dbsc::RankedAmount const first = amountOf( "-5.00"_d64, 7 );
+  ties.add( late );
+  ties.add( early );
+  ties.add( first );
+  BSLS_ASSERT( ties.entries() == ( std::vector< dbsc::RankedAmount > { first, early } ) );
+
+  dbsc::TopAmounts none { dbsc::AmountDirection::kInflow, 0 };
+  none.add( amounts[0] );
+  BSLS_ASSERT( none.size() == 0 );
+
+  deposits.clear();
+  BSLS_ASSERT( deposits.size() == 0 );
+}
+
+static void testAgainstSort()
+{
+  std::mt19937 generator { 3 };
+  std::uniform_int_distribution< int > cents { -100'000, 100'000 };
+  std::vector< dbsc::RankedAmount > amounts;
+  std::vector< dbsc::TopAmounts > parts( 3, dbsc::TopAmounts( dbsc::AmountDirection::kOutflow, 20 ) );
+  for ( int i = 0; i < 3'000; ++i ) {
+    amounts.push_back( amountOf( BloombergLP::bdldfp::Decimal64( cents( generator ) ), i % 50 ) );
+    parts[i % parts.size()].add( amounts.back() );
+  }
+
+  dbsc::TopAmounts merged { dbsc::AmountDirection::kOutflow, 20 };
+  for ( dbsc::TopAmounts const& part : parts ) {
+    merged.merge( part );
+  }
+
+  std::erase_if( amounts, []( dbsc::RankedAmount const& amount ) { return not( amount.mAmount < "0"_d64 ); } );
+  std::ranges::sort( amounts, []( dbsc::RankedAmount const& a, dbsc::RankedAmount const& b ) {
+    return dbsc::TopAmounts::outranks( dbsc::AmountDirection::kOutflow, a, b );
+  } );
+  amounts.resize( 20 );
+  BSLS_ASSERT( merged.entries() == amounts );
+}
+
+static void testAllocator()
+{
+  BloombergLP::bslma::TestAllocator allocator;
+  {
+    dbsc::TopAmounts top { dbsc::AmountDirection::kInflow, 8, &allocator };
+    auto const blocks = allocator.numBlocksTotal();
+    for ( int i = 1; i <= 100; ++i ) {
+      top.add( amountOf( BloombergLP::bdldfp::Decimal64( i ), i ) );
+    }
+    BSLS_ASSERT( allocator.numBlocksTotal() == blocks );
+    BSLS_ASSERT( top.entries().front().mAmount == "100"_d64 );
+
+    dbsc::TopAmounts const copy { top, &allocator };
+    BSLS_ASSERT( copy.entries() == top.entries() );
+  }
+  BSLS_ASSERT( allocator.numBlocksInUse() == 0 );
+}
+} // namespace
+
+auto main() -> int
+{
+  testDirections();
+  testAgainstSort();
+  testAllocator();
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -7,6 +7,7 @@
 #include <format>
 #include <sstream>
 #include <string_view>
+#include <utility>
 
 namespace dbsc {
 
@@ -31,12 +32,32 @@ Transaction::Transaction( UuidString const& transactionId,
 {
 }
 
+Transaction::Transaction( UuidString const& transactionId,
+                          UuidString const& owningPartyId,
+                          UuidString const& otherPartyID,
+                          BloombergLP::bdldfp::Decimal64 amount,
+                          TimeStamp timeStamp,
+                          Notes notes )
+  : mTransactionId( transactionId )
+  , mOwningPartyId( owningPartyId )
+  , mOtherPartyId( otherPartyID )
+  , mAmount( amount )
+  , mTimeStamp( timeStamp )
+  , mNotes( std::move( notes ) )
+{
+}
+
 auto Transaction::amount() const -> BloombergLP::bdldfp::Decimal64
 {
   return mAmount;
 }
 
-auto Transaction::notes() const -> std::string const&
+auto Transaction::notes() const -> std::string_view
+{
+  return mNotes.view();
+}
+
+auto Transaction::sharedNotes() const -> Notes const&
 {
   return mNotes;
 }
@@ -16,6 +16,7 @@
 //  - DateTime
 //  - Extra Notes
 
+#include <dbsc_notespool.h>
 #include <dbsc_sharedapi.h>
 #include <dbsc_uuidstring.h>
 
@@ -47,9 +48,20 @@ public:
                                       BloombergLP::bdldfp::Decimal64 amount,
                                       TimeStamp timeStamp,
                                       std::string const& notes );
+  /// As above, sharing @p notes (e.g. text interned in a dbsc::NotesPool).
+  [[nodiscard]] DBSC_API Transaction( UuidString const& transactionId,
+                                      UuidString const& owningPartyId,
+                                      UuidString const& otherPartyId,
+                                      BloombergLP::bdldfp::Decimal64 amount,
+                                      TimeStamp timeStamp,
+                                      Notes notes );
 
   [[nodiscard]] DBSC_API auto amount() const -> BloombergLP::bdldfp::Decimal64;
-  [[nodiscard]] DBSC_API auto notes() const -> std::string const&;
+  /// The view is valid while this object (or, for interned notes, the pool)
+  /// is alive and unmoved.
+  [[nodiscard]] DBSC_API auto notes() const -> std::string_view;
+  /// The notes, for sharing with other objects without copying the text.
+  [[nodiscard]] DBSC_API auto sharedNotes() const -> Notes const&;
   [[nodiscard]] DBSC_API auto owningPartyId() const -> UuidString const&;
   [[nodiscard]] DBSC_API auto otherPartyId() const -> UuidString const&;
   [[nodiscard]] DBSC_API auto timestamp() const -> TimeStamp;
@@ -70,7 +82,7 @@ private:
   UuidString mOtherPartyId;
   BloombergLP::bdldfp::Decimal64 mAmount;
   TimeStamp mTimeStamp;
-  std::string mNotes {};
+  Notes mNotes {};
 };
 
 struct TransactionUtil
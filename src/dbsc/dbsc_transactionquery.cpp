@@ -0,0 +1,497 @@
+// dbsc_transactionquery.cpp
+#include "dbsc_transactionquery.h"
+
+#include <dbsc_account.h>
+#include <dbsc_accountbook.h>
+#include <dbsc_money.h>
+#include <dbsc_parallelutil.h>
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace dbsc {
+
+namespace {
+  /// Rows evaluated together; the masks of a batch stay in L1.
+  constexpr std::size_t kBatchRows = 1024;
+
+  /// Rows per task of `collect` and `count`; large enough to amortize
+  /// claiming a task, small enough to balance the load across threads.
+  constexpr std::size_t kRowsPerBlock = 1U << 16;
+
+  enum class Kind
+  {
+    kAll,
+    kAmount,
+    kTime,
+    kCounterparty,
+    kActive,
+    kNotes,
+    kAnd,
+    kOr,
+    kNot,
+  };
+} // namespace
+
+struct TransactionFilter::Node
+{
+  Kind mKind { Kind::kAll };
+  std::optional< BloombergLP::bdldfp::Decimal64 > mLow {};
+  std::optional< BloombergLP::bdldfp::Decimal64 > mHigh {};
+  TimeStamp mBegin {};
+  TimeStamp mEnd {};
+  UuidString mCounterparty {};
+  bool mActive { false };
+  std::string mText {};
+  std::shared_ptr< Node const > mLeft {};
+  std::shared_ptr< Node const > mRight {};
+};
+
+struct TransactionQuery::Step
+{
+  Kind mKind;
+  /// Amount bounds; absent bounds are the extremes of the type.
+  BloombergLP::bdldfp::Decimal64 mLow {};
+  BloombergLP::bdldfp::Decimal64 mHigh {};
+  bool mHasLow { false };
+  bool mHasHigh { false };
+  /// The inclusive bounds in Money units, if both convert exactly.
+  std::optional< std::pair< Money::Rep, Money::Rep > > mUnits {};
+  /// Time bounds as ticks since the epoch.
+  TimeStamp::rep mBegin { 0 };
+  TimeStamp::rep mEnd { 0 };
+  UuidString mCounterparty {};
+  bool mActive { false };
+  std::string mText {};
+  std::optional< std::boyer_moore_horspool_searcher< std::string::const_iterator > > mSearcher {};
+  /// Operands of kAnd, kOr (both) and kNot (left).
+  std::uint32_t mLeft { 0 };
+  std::uint32_t mRight { 0 };
+};
+
+TransactionFilter::TransactionFilter() = default;
+
+TransactionFilter::TransactionFilter( std::shared_ptr< Node const > root )
+  : mRoot( std::move( root ) )
+{
+}
+
+auto TransactionFilter::amountBetween( BloombergLP::bdldfp::Decimal64 low, BloombergLP::bdldfp::Decimal64 high )
+  -> TransactionFilter
+{
+  return TransactionFilter(
+    std::make_shared< Node const >( Node { .mKind = Kind::kAmount, .mLow = low, .mHigh = high } ) );
+}
+
+auto TransactionFilter::amountAtLeast( BloombergLP::bdldfp::Decimal64 low ) -> TransactionFilter
+{
+  return TransactionFilter( std::make_shared< Node const >( Node { .mKind = Kind::kAmount, .mLow = low } ) );
+}
+
+auto TransactionFilter::amountBelow( BloombergLP::bdldfp::Decimal64 high ) -> TransactionFilter
+{
+  return TransactionFilter( std::make_shared< Node const >( Node { .mKind = Kind::kAmount, .mHigh = high } ) );
+}
+
+auto TransactionFilter::timeBetween( TimeStamp begin, TimeStamp end ) -> TransactionFilter
+{
+  return TransactionFilter(
+    std::make_shared< Node const >( Node { .mKind = Kind::kTime, .mBegin = begin, .mEnd = end } ) );
+}
+
+auto TransactionFilter::counterparty( UuidString const& counterpartyId ) -> TransactionFilter
+{
+  return TransactionFilter(
+    std::make_shared< Node const >( Node { .mKind = Kind::kCounterparty, .mCounterparty = counterpartyId } ) );
+}
+
+auto TransactionFilter::external() -> TransactionFilter
+{
+  return counterparty( UuidString() );
+}
+
+auto TransactionFilter::accountActive( bool active ) -> TransactionFilter
+{
+  return TransactionFilter( std::make_shared< Node const >( Node { .mKind = Kind::kActive, .mActive = active } ) );
+}
+
+auto TransactionFilter::notesContain( std::string_view text ) -> TransactionFilter
+{
+  if ( text.empty() ) {
+    return {};
+  }
+  return TransactionFilter(
+    std::make_shared< Node const >( Node { .mKind = Kind::kNotes, .mText = std::string( text ) } ) );
+}
+
+auto operator&&( TransactionFilter const& a, TransactionFilter const& b ) -> TransactionFilter
+{
+  if ( not a.mRoot ) {
+    return b;
+  }
+  if ( not b.mRoot ) {
+    return a;
+  }
+  return TransactionFilter( std::make_shared< TransactionFilter::Node const >(
+    TransactionFilter::Node { .mKind = Kind::kAnd, .mLeft = a.mRoot, .mRight = b.mRoot } ) );
+}
+
+auto operator||( TransactionFilter const& a, TransactionFilter const& b ) -> TransactionFilter
+{
+  if ( not a.mRoot || not b.mRoot ) {
+    return {};
+  }
+  return TransactionFilter( std::make_shared< TransactionFilter::Node const >(
+    TransactionFilter::Node { .mKind = Kind::kOr, .mLeft = a.mRoot, .mRight = b.mRoot } ) );
+}
+
+auto operator!( TransactionFilter const& filter ) -> TransactionFilter
+{
+  if ( filter.mRoot && filter.mRoot->mKind == Kind::kNot ) {
+    return TransactionFilter( filter.mRoot->mLeft );
+  }
+  auto operand = filter.mRoot ? filter.mRoot : std::make_shared< TransactionFilter::Node const >();
+  return TransactionFilter( std::make_shared< TransactionFilter::Node const >(
+    TransactionFilter::Node { .mKind = Kind::kNot, .mLeft = std::move( operand ) } ) );
+}
+
+TransactionQuery::MatchIterator::MatchIterator( TransactionQuery const* query )
+  : mQuery( query )
+  , mAccount( 0 )
+  , mNextRow( 0 )
+  , mPosition( 0 )
+{
+  if ( not mQuery->mAccounts.empty() ) {
+    mScan = mQuery->scan( 0 );
+  }
+  advance();
+}
+
+void TransactionQuery::MatchIterator::advance()
+{
+  mRows.clear();
+  mPosition = 0;
+  while ( mAccount < mQuery->mAccounts.size() ) {
+    std::size_t const rowCount = mScan.mStore->size();
+    if ( mNextRow < rowCount ) {
+      std::size_t const last = std::min( mNextRow + kBatchRows, rowCount );
+      mQuery->evaluate( mScan, mNextRow, last, mRows, mScratch );
+      mNextRow = last;
+      if ( not mRows.empty() ) {
+        return;
+      }
+    } else {
+      mNextRow = 0;
+      if ( ++mAccount < mQuery->mAccounts.size() ) {
+        mScan = mQuery->scan( mAccount );
+      }
+    }
+  }
+}
+
+TransactionQuery::TransactionQuery( AccountBook const& book, TransactionFilter const& filter )
+  : mBook( book )
+{
+  mAccounts.reserve( static_cast< std::size_t >( book.accountCount() ) );
+  for ( auto const& [accountId, account] : book ) {
+    mAccounts.push_back( book.handle( accountId ) );
+  }
+  if ( filter.mRoot ) {
+    static_cast< void >( compile( *filter.mRoot ) );
+  }
+  // The searchers refer to the patterns, so they are made once the steps no
+  // longer move.
+  for ( Step& step : mSteps ) {
+    if ( step.mKind == Kind::kNotes ) {
+      step.mSearcher.emplace( step.mText.cbegin(), step.mText.cend() );
+    }
+  }
+}
+
+TransactionQuery::~TransactionQuery() = default;
+
+auto TransactionQuery::matches() const -> MatchRange
+{
+  return { MatchIterator( this ), std::default_sentinel };
+}
+
+auto TransactionQuery::collect( unsigned threadCount ) const -> std::vector< QueryMatch >
+{
+  std::vector< AccountScan > scans;
+  std::vector< Block > const blocks = divide( threadCount, scans );
+
+  // Each block keeps its own rows, so the result is in book order whatever
+  // the threads' timing.
+  unsigned const blockThreadCount = ParallelUtil::threadCountFor( threadCount, blocks.size() );
+  std::vector< std::vector< TransactionStore::Row > > rows( blocks.size() );
+  std::vector< std::vector< std::uint8_t > > scratch( blockThreadCount );
+  ParallelUtil::forEachTask( blocks.size(), blockThreadCount, [&]( std::size_t i, unsigned thread ) {
+    evaluateBlock( scans[blocks[i].mAccount], blocks[i], rows[i], scratch[thread] );
+  } );
+
+  std::size_t matchCount = 0;
+  for ( std::vector< TransactionStore::Row > const& blockRows : rows ) {
+    matchCount += blockRows.size();
+  }
+  std::vector< QueryMatch > matches;
+  matches.reserve( matchCount );
+  for ( std::size_t i = 0; i < blocks.size(); ++i ) {
+    for ( TransactionStore::Row const row : rows[i] ) {
+      matches.push_back( { mAccounts[blocks[i].mAccount], row } );
+    }
+  }
+  return matches;
+}
+
+auto TransactionQuery::count( unsigned threadCount ) const -> std::size_t
+{
+  std::vector< AccountScan > scans;
+  std::vector< Block > const blocks = divide( threadCount, scans );
+
+  unsigned const blockThreadCount = ParallelUtil::threadCountFor( threadCount, blocks.size() );
+  std::vector< std::vector< TransactionStore::Row > > rows( blockThreadCount );
+  std::vector< std::vector< std::uint8_t > > scratch( blockThreadCount );
+  std::vector< std::size_t > counts( blockThreadCount );
+  ParallelUtil::forEachTask( blocks.size(), blockThreadCount, [&]( std::size_t i, unsigned thread ) {
+    rows[thread].clear();
+    evaluateBlock( scans[blocks[i].mAccount], blocks[i], rows[thread], scratch[thread] );
+    counts[thread] += rows[thread].size();
+  } );
+
+  std::size_t matchCount = 0;
+  for ( std::size_t const threadMatchCount : counts ) {
+    matchCount += threadMatchCount;
+  }
+  return matchCount;
+}
+
+auto TransactionQuery::compile( TransactionFilter::Node const& node ) -> std::uint32_t
+{
+  auto const index = static_cast< std::uint32_t >( mSteps.size() );
+  mSteps.push_back( { .mKind = node.mKind } );
+  switch ( node.mKind ) {
+  case Kind::kAll:
+    break;
+  case Kind::kAmount: {
+    Step& step    = mSteps[index];
+    step.mHasLow  = node.mLow.has_value();
+    step.mHasHigh = node.mHigh.has_value();
+    step.mLow     = node.mLow.value_or( BloombergLP::bdldfp::Decimal64() );
+    step.mHigh    = node.mHigh.value_or( BloombergLP::bdldfp::Decimal64() );
+    // Units are integers, so `units < high` is `units <= high - 1`.
+    std::optional< Money > const low  = node.mLow ? Money::fromDecimal( *node.mLow ) : Money();
+    std::optional< Money > const high = node.mHigh ? Money::fromDecimal( *node.mHigh ) : Money();
+    if ( low && high ) {
+      step.mUnits.emplace( node.mLow ? low->units() : std::numeric_limits< Money::Rep >::min(),
+                           node.mHigh ? high->units() - 1 : std::numeric_limits< Money::Rep >::max() );
+    }
+  } break;
+  case Kind::kTime:
+    mSteps[index].mBegin = node.mBegin.time_since_epoch().count();
+    mSteps[index].mEnd   = node.mEnd.time_since_epoch().count();
+    break;
+  case Kind::kCounterparty:
+    mSteps[index].mCounterparty = node.mCounterparty;
+    break;
+  case Kind::kActive:
+    mSteps[index].mActive = node.mActive;
+    break;
+  case Kind::kNotes:
+    mSteps[index].mText = node.mText;
+    break;
+  case Kind::kAnd:
+  case Kind::kOr: {
+    std::uint32_t const left  = compile( *node.mLeft );
+    std::uint32_t const right = compile( *node.mRight );
+    mSteps[index].mLeft       = left;
+    mSteps[index].mRight      = right;
+  } break;
+  case Kind::kNot: {
+    std::uint32_t const operand = compile( *node.mLeft );
+    mSteps[index].mLeft         = operand;
+  } break;
+  }
+  return index;
+}
+
+auto TransactionQuery::scan( std::size_t account ) const -> AccountScan
+{
+  Account const& owner = mBook.account( mAccounts[account] );
+  AccountScan scan;
+  scan.mStore      = &owner.transactions();
+  scan.mActive     = owner.isActive();
+  scan.mExactUnits = scan.mStore->amountsAreExact();
+  scan.mCounterparties.assign( mSteps.size(), kNoCounterparty );
+  std::span< UuidString const > const counterpartyIds = scan.mStore->counterpartyIds();
+  for ( std::size_t i = 0; i < mSteps.size(); ++i ) {
+    if ( mSteps[i].mKind == Kind::kCounterparty ) {
+      auto const found = std::ranges::find( counterpartyIds, mSteps[i].mCounterparty );
+      if ( found != counterpartyIds.end() ) {
+        scan.mCounterparties[i] =
+          static_cast< TransactionStore::CounterpartyIndex >( found - counterpartyIds.begin() );
+      }
+    }
+  }
+  return scan;
+}
+
+auto TransactionQuery::divide( unsigned threadCount, std::vector< AccountScan >& scans ) const -> std::vector< Block >
+{
+  scans.resize( mAccounts.size() );
+  ParallelUtil::forEachTask( mAccounts.size(),
+                             ParallelUtil::threadCountFor( threadCount, mAccounts.size() ),
+                             [&]( std::size_t account, unsigned ) { scans[account] = scan( account ); } );
+
+  std::vector< Block > blocks;
+  for ( std::size_t account = 0; account < scans.size(); ++account ) {
+    std::size_t const rowCount = scans[account].mStore->size();
+    for ( std::size_t first = 0; first < rowCount; first += kRowsPerBlock ) {
+      blocks.push_back( { account, first, std::min( first + kRowsPerBlock, rowCount ) } );
+    }
+  }
+  return blocks;
+}
+
+void TransactionQuery::evaluateBlock( AccountScan const& scan,
+                                      Block const& block,
+                                      std::vector< TransactionStore::Row >& rows,
+                                      std::vector< std::uint8_t >& scratch ) const
+{
+  for ( std::size_t first = block.mFirst; first < block.mLast; first += kBatchRows ) {
+    evaluate( scan, first, std::min( first + kBatchRows, block.mLast ), rows, scratch );
+  }
+}
+
+void TransactionQuery::evaluate( AccountScan const& scan,
+                                 std::size_t first,
+                                 std::size_t last,
+                                 std::vector< TransactionStore::Row >& rows,
+                                 std::vector< std::uint8_t >& scratch ) const
+{
+  BSLS_ASSERT( first <= last && last - first <= kBatchRows );
+  if ( mSteps.empty() ) {
+    for ( std::size_t row = first; row < last; ++row ) {
+      rows.push_back( static_cast< TransactionStore::Row >( row ) );
+    }
+    return;
+  }
+  // One mask per step, so that operands never overwrite one another.
+  scratch.resize( mSteps.size() * kBatchRows );
+  std::uint8_t* const mask = scratch.data();
+  evaluateStep( 0, scan, first, last - first, mask, scratch.data() );
+  for ( std::size_t i = 0; i < last - first; ++i ) {
+    if ( mask[i] != 0 ) {
+      rows.push_back( static_cast< TransactionStore::Row >( first + i ) );
+    }
+  }
+}
+
+void TransactionQuery::evaluateStep( std::uint32_t step,
+                                     AccountScan const& scan,
+                                     std::size_t first,
+                                     std::size_t count,
+                                     std::uint8_t* mask,
+                                     std::uint8_t* scratch ) const
+{
+  // Every loop over a column below is branch-free, so the compiler can
+  // vectorize it.
+  Step const& current           = mSteps[step];
+  TransactionStore const& store = *scan.mStore;
+  switch ( current.mKind ) {
+  case Kind::kAll:
+    std::fill_n( mask, count, std::uint8_t { 1 } );
+    break;
+  case Kind::kAmount:
+    if ( current.mUnits && scan.mExactUnits ) {
+      Money::Rep const* const units = store.amountUnits().data() + first;
+      auto const [low, high]        = *current.mUnits;
+      for ( std::size_t i = 0; i < count; ++i ) {
+        mask[i] = static_cast< std::uint8_t >( ( low <= units[i] ) & ( units[i] <= high ) );
+      }
+    } else {
+      BloombergLP::bdldfp::Decimal64 const* const amounts = store.amounts().data() + first;
+      for ( std::size_t i = 0; i < count; ++i ) {
+        mask[i] = static_cast< std::uint8_t >( ( not current.mHasLow || current.mLow <= amounts[i] )
+                                               && ( not current.mHasHigh || amounts[i] < current.mHigh ) );
+      }
+    }
+    break;
+  case Kind::kTime: {
+    TimeStamp const* const timeStamps = store.timestamps().data() + first;
+    for ( std::size_t i = 0; i < count; ++i ) {
+      TimeStamp::rep const ticks = timeStamps[i].time_since_epoch().count();
+      mask[i] = static_cast< std::uint8_t >( ( current.mBegin <= ticks ) & ( ticks < current.mEnd ) );
+    }
+  } break;
+  case Kind::kCounterparty: {
+    TransactionStore::CounterpartyIndex const wanted = scan.mCounterparties[step];
+    TransactionStore::CounterpartyIndex const* const counterparties = store.counterparties().data() + first;
+    for ( std::size_t i = 0; i < count; ++i ) {
+      mask[i] = static_cast< std::uint8_t >( counterparties[i] == wanted );
+    }
+  } break;
+  case Kind::kActive:
+    std::fill_n( mask, count, static_cast< std::uint8_t >( scan.mActive == current.mActive ) );
+    break;
+  case Kind::kNotes: {
+    std::string_view const* const notes = store.notesColumn().data() + first;
+    for ( std::size_t i = 0; i < count; ++i ) {
+      mask[i] = static_cast< std::uint8_t >( ( *current.mSearcher )( notes[i].begin(), notes[i].end() ).first
+                                             != notes[i].end() );
+    }
+  } break;
+  case Kind::kAnd:
+  case Kind::kOr: {
+    bool const isAnd = current.mKind == Kind::kAnd;
+    evaluateStep( current.mLeft, scan, first, count, mask, scratch );
+    // Skip the right operand if the left one decides every row.
+    bool const decided = isAnd ? std::all_of( mask, mask + count, []( std::uint8_t bit ) { return bit == 0; } )
+                               : std::all_of( mask, mask + count, []( std::uint8_t bit ) { return bit != 0; } );
+    if ( decided ) {
+      break;
+    }
+    std::uint8_t* const right = scratch + current.mRight * kBatchRows;
+    evaluateStep( current.mRight, scan, first, count, right, scratch );
+    if ( isAnd ) {
+      for ( std::size_t i = 0; i < count; ++i ) {
+        mask[i] &= right[i];
+      }
+    } else {
+      for ( std::size_t i = 0; i < count; ++i ) {
+        mask[i] |= right[i];
+      }
+    }
+  } break;
+  case Kind::kNot:
+    evaluateStep( current.mLeft, scan, first, count, mask, scratch );
+    for ( std::size_t i = 0; i < count; ++i ) {
+      mask[i] ^= 1U;
+    }
+    break;
+  }
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,289 @@
+// dbsc_transactionquery.h
+#ifndef INCLUDED_DBSC_TRANSACTIONQUERY
+#define INCLUDED_DBSC_TRANSACTIONQUERY
+
+//@PURPOSE: Provide composable filters over the transactions of a book.
+//
+//@CLASSES:
+//  dbsc::TransactionFilter: a predicate over transactions, built from
+//    conditions on single attributes and combined with `&&`, `||` and `!`.
+//  dbsc::TransactionQuery: evaluates a filter over an AccountBook, lazily or
+//    in parallel.
+//  dbsc::QueryMatch: identifies one matching transaction.
+//
+//@DESCRIPTION: Questions such as "withdrawals over 100.00 paid to external
+//  parties in Q3 whose notes mention rent" are written as a TransactionFilter:
+//
+//  - `amountBetween`, `amountAtLeast`, `amountBelow`: the amount;
+//  - `timeBetween`: the timestamp;
+//  - `counterparty`, `external`: the other party (the nil id is external);
+//  - `accountActive`: whether the owning account is active;
+//  - `notesContain`: a byte-exact (case-sensitive) substring of the notes.
+//
+//  Ranges are half-open, `[low, high)`. A default-constructed filter matches
+//  every transaction. Filters are immutable values; combining them shares
+//  the operands rather than copying them.
+//
+//  A TransactionQuery compiles the filter into a flat sequence of steps and
+//  evaluates it over batches of rows, one column at a time: each condition
+//  writes a byte per row of the batch with a loop over a single column (over
+//  Money units for amounts, where the account's amounts allow), and `&&`,
+//  `||` and `!` combine those bytes. The right operand of `&&` (`||`) is
+//  skipped for a batch in which no (every) row already matches. Counterparty
+//  conditions are resolved once per account to an index into the account's
+//  counterparty dictionary, so rows compare integers rather than ids.
+//
+//  Matches are produced in book order (accounts in the book's order, rows in
+//  logging order) in two ways:
+//
+//  - `matches()` is a lazy range that evaluates one batch at a time as it is
+//    consumed, so the first match is available early and an early `break`
+//    costs nothing more;
+//  - `collect()` and `count()` divide the book into blocks of rows and
+//    evaluate them on several threads.
+//
+//  A query refers to the book it was created for, which must outlive it and
+//  must not be modified while a query runs or a range is in use. Accounts and
+//  transactions added after the query was created are not seen.
+//
+/// Usage
+/// -----
+/// Example 1: Large external payments in the third quarter
+///
+/// ```cpp
+/// using dbsc::TransactionFilter;
+/// TransactionFilter const filter = TransactionFilter::amountBelow( -100.00_d64 ) && TransactionFilter::external()
+///                               && TransactionFilter::timeBetween( julyFirst, octoberFirst )
+///                               && TransactionFilter::notesContain( "Rent" );
+/// dbsc::TransactionQuery const query( book, filter );
+/// for ( dbsc::QueryMatch const match : query.matches() ) {
+///     std::println( "{}", book.account( match.mAccount ).transactions().id( match.mRow ) );
+/// }
+/// std::size_t const total = query.count();
+/// ```
+
+#include <dbsc_accounthandle.h>
+#include <dbsc_sharedapi.h>
+#include <dbsc_transaction.h>
+#include <dbsc_transactionstore.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+namespace dbsc {
+
+class AccountBook;
+
+/// A predicate over the transactions of a book.
+class TransactionFilter
+{
+public:
+  /// Matches every transaction.
+  DBSC_API TransactionFilter();
+
+  /// Matches amounts in [@p low, @p high).
+  [[nodiscard]] DBSC_API static auto amountBetween( BloombergLP::bdldfp::Decimal64 low,
+                                                    BloombergLP::bdldfp::Decimal64 high ) -> TransactionFilter;
+  [[nodiscard]] DBSC_API static auto amountAtLeast( BloombergLP::bdldfp::Decimal64 low ) -> TransactionFilter;
+  [[nodiscard]] DBSC_API static auto amountBelow( BloombergLP::bdldfp::Decimal64 high ) -> TransactionFilter;
+  /// Matches timestamps in [@p begin, @p end).
+  [[nodiscard]] DBSC_API static auto timeBetween( TimeStamp begin, TimeStamp end ) -> TransactionFilter;
+  /// Matches transactions whose other party is @p counterpartyId.
+  [[nodiscard]] DBSC_API static auto counterparty( UuidString const& counterpartyId ) -> TransactionFilter;
+  /// Matches transactions with an external party.
+  [[nodiscard]] DBSC_API static auto external() -> TransactionFilter;
+  /// Matches the transactions of accounts whose `isActive()` is @p active.
+  [[nodiscard]] DBSC_API static auto accountActive( bool active = true ) -> TransactionFilter;
+  /// Matches notes containing @p text; every note contains the empty text.
+  [[nodiscard]] DBSC_API static auto notesContain( std::string_view text ) -> TransactionFilter;
+
+  DBSC_API friend auto operator&&( TransactionFilter const& a, TransactionFilter const& b ) -> TransactionFilter;
+  DBSC_API friend auto operator||( TransactionFilter const& a, TransactionFilter const& b ) -> TransactionFilter;
+  DBSC_API friend auto operator!( TransactionFilter const& filter ) -> TransactionFilter;
+
+private:
+  friend class TransactionQuery;
+  struct Node;
+
+  explicit TransactionFilter( std::shared_ptr< Node const > root );
+
+  /// Null for the filter matching every transaction.
+  std::shared_ptr< Node const > mRoot;
+};
+
+/// A transaction matched by a TransactionQuery.
+struct QueryMatch
+{
+  AccountHandle mAccount;
+  TransactionStore::Row mRow;
+
+  [[nodiscard]] friend auto operator<=>( QueryMatch const&, QueryMatch const& ) = default;
+};
+
+/// A TransactionFilter compiled for one AccountBook.
+class TransactionQuery
+{
+  /// What the steps need to know about one account.
+  struct AccountScan
+  {
+    AccountScan()
+      : mStore( nullptr )
+      , mActive( false )
+      , mExactUnits( false )
+    {
+    }
+
+    TransactionStore const* mStore;
+    bool mActive;
+    bool mExactUnits;
+    /// Per step: the index of its counterparty in the store's dictionary, or
+    /// `kNoCounterparty`.
+    std::vector< TransactionStore::CounterpartyIndex > mCounterparties;
+  };
+
+public:
+  /// A lazy input iterator over the matches, in book order.
+  class MatchIterator
+  {
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type       = QueryMatch;
+    using difference_type  = std::ptrdiff_t;
+
+    MatchIterator()
+      : mQuery( nullptr )
+      , mAccount( 0 )
+      , mNextRow( 0 )
+      , mPosition( 0 )
+    {
+    }
+
+    [[nodiscard]] auto operator*() const -> QueryMatch { return { mQuery->mAccounts[mAccount], mRows[mPosition] }; }
+
+    auto operator++() -> MatchIterator&
+    {
+      if ( ++mPosition == mRows.size() ) {
+        advance();
+      }
+      return *this;
+    }
+
+    void operator++( int ) { ++*this; }
+
+    [[nodiscard]] friend auto operator==( MatchIterator const& iterator, std::default_sentinel_t ) -> bool
+    {
+      return iterator.atEnd();
+    }
+
+  private:
+    friend class TransactionQuery;
+    DBSC_API explicit MatchIterator( TransactionQuery const* query );
+
+    [[nodiscard]] auto atEnd() const -> bool { return mQuery == nullptr || mAccount == mQuery->mAccounts.size(); }
+
+    /// Evaluate batches until one holds a match or the book is exhausted.
+    DBSC_API void advance();
+
+    TransactionQuery const* mQuery;
+    std::size_t mAccount;
+    std::size_t mNextRow;
+    AccountScan mScan;
+    /// The matches of the current batch.
+    std::vector< TransactionStore::Row > mRows;
+    std::size_t mPosition;
+    std::vector< std::uint8_t > mScratch;
+  };
+
+  using MatchRange = std::ranges::subrange< MatchIterator, std::default_sentinel_t >;
+
+  /// Compile @p filter for @p book, which must outlive this object.
+  DBSC_API TransactionQuery( AccountBook const& book, TransactionFilter const& filter );
+  TransactionQuery( TransactionQuery const& )                    = delete;
+  auto operator=( TransactionQuery const& ) -> TransactionQuery& = delete;
+  DBSC_API ~TransactionQuery();
+
+  /// @return the matches, evaluated as the range is consumed.
+  [[nodiscard]] DBSC_API auto matches() const -> MatchRange;
+
+  /// @return every match, in book order, evaluated by @p threadCount threads
+  /// (0 selects one per hardware thread).
+  [[nodiscard]] DBSC_API auto collect( unsigned threadCount = 0 ) const -> std::vector< QueryMatch >;
+
+  /// @return the number of matches, evaluated as by `collect`.
+  [[nodiscard]] DBSC_API auto count( unsigned threadCount = 0 ) const -> std::size_t;
+
+private:
+  struct Step;
+
+  static constexpr TransactionStore::CounterpartyIndex kNoCounterparty = UINT32_MAX;
+
+  /// Rows [mFirst, mLast) of the account at mAccount in `mAccounts`.
+  struct Block
+  {
+    std::size_t mAccount;
+    std::size_t mFirst;
+    std::size_t mLast;
+  };
+
+  auto compile( TransactionFilter::Node const& node ) -> std::uint32_t;
+  [[nodiscard]] auto scan( std::size_t account ) const -> AccountScan;
+
+  /// Fill @p scans, one per account, and @return the blocks of rows to
+  /// evaluate, in book order.
+  [[nodiscard]] auto divide( unsigned threadCount, std::vector< AccountScan >& scans ) const -> std::vector< Block >;
+  /// Append the rows of @p block that match to @p rows.
+  void evaluateBlock( AccountScan const& scan,
+                      Block const& block,
+                      std::vector< TransactionStore::Row >& rows,
+                      std::vector< std::uint8_t >& scratch ) const;
+
+  /// Append the rows in [@p first, @p last) of @p scan that match to @p rows.
+  /// @pre `last - first` is at most the batch size.
+  void evaluate( AccountScan const& scan,
+                 std::size_t first,
+                 std::size_t last,
+                 std::vector< TransactionStore::Row >& rows,
+                 std::vector< std::uint8_t >& scratch ) const;
+  /// Set `mask[i]` to whether row `first + i` satisfies @p step.
+  void evaluateStep( std::uint32_t step,
+                     AccountScan const& scan,
+                     std::size_t first,
+                     std::size_t count,
+                     std::uint8_t* mask,
+                     std::uint8_t* scratch ) const;
+
+  AccountBook const& mBook;
+  std::vector< AccountHandle > mAccounts;
+  /// The compiled filter, root first; empty if it matches everything.
+  std::vector< Step > mSteps;
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
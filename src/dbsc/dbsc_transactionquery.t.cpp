@@ -0,0 +1,194 @@
+// dbsc_transactionquery.t.cpp
+// Test driver for dbsc::TransactionQuery
+#include <dbsc_account.h>
+#include <dbsc_accountbook.h>
+#include <dbsc_transaction.h>
+#include <dbsc_transactionquery.h>
+#include <dbsc_transactionstore.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bsls_assert.h>
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+using namespace std::chrono;
+using dbsc::TransactionFilter;
+
+using Predicate = std::function< bool( dbsc::Account const&, dbsc::TransactionStore::Row ) >;
+
+/// @return the matches of @p predicate, found by materializing every row.
+static auto scanBook( dbsc::AccountBook const& book, Predicate const& predicate ) -> std::vector< dbsc::QueryMatch >
+{
+  std::vector< dbsc::QueryMatch > matches;
+  for ( auto const& [accountId, account] : book ) {
+    for ( std::size_t row = 0; row < account.transactions().size(); ++row ) {
+      if ( predicate( account, static_cast< dbsc::TransactionStore::Row >( row ) ) ) {
+        matches.push_back( { book.handle( accountId ), static_cast< dbsc::TransactionStore::Row >( row ) } );
+      }
+    }
+  }
+  return matches;
+}
+
+/// Verify every way of running @p filter against @p predicate.
+static void checkQuery( dbsc::AccountBook const& book, TransactionFilter const& filter, Predicate const& predicate )
+{
+  std::vector< dbsc::QueryMatch > const expected = scanBook( book, predicate );
+  dbsc::TransactionQuery const query { book, filter };
+  std::vector< dbsc::QueryMatch > lazy;
+  for ( dbsc::QueryMatch const match : query.matches() ) {
+    lazy.push_back( match );
+  }
+  BSLS_ASSERT( lazy == expected );
+  for ( unsigned threadCount : { 1U, 4U } ) {
+    BSLS_ASSERT( query.collect( threadCount ) == expected );
+    BSLS_ASSERT( query.count( threadCount ) == expected.size() );
+  }
+}
+
+static void testFilters()
+{
+  sys_days const july { year( 2025 ) / 7 / 1 };
+  sys_days const october { year( 2025 ) / 10 / 1 };
+  std::array< dbsc::UuidString, 3 > const counterparties { dbsc::UuidString(),
+                                                           dbsc::UuidStringUtil::generate(),
+                                                           dbsc::UuidStringUtil::generate() };
+  std::array< std::string, 4 > const notes { "Rent for July", "Groceries", "rent refund", "" };
+
+  // Accounts of several sizes, one spanning more than a block of rows.
+  std::mt19937 generator { 21 };
+  std::uniform_int_distribution< int > daysOffset { -30, 180 };
+  std::uniform_int_distribution< int > units { -30'000, 30'000 };
+  dbsc::AccountBook book { std::string { "Owner" } };
+  std::vector< dbsc::AccountHandle > handles;
+  for ( std::size_t rowCount : { 0, 1, 900, 3000, 70'000 } ) {
+    dbsc::Account account { "Parsed", "" };
+    for ( std::size_t row = 0; row < rowCount; ++row ) {
+      account.logTransaction( { dbsc::UuidStringUtil::generate(),
+                                account.id(),
+                                counterparties[row % counterparties.size()],
+                                BloombergLP::bdldfp::Decimal64( units( generator ) ) / 100,
+                                july + days( daysOffset( generator ) ),
+                                notes[row % notes.size()] } );
+    }
+    dbsc::UuidString const accountId = account.id();
+    book.addParsedAccount( std::move( account ) );
+    handles.push_back( book.handle( accountId ) );
+  }
+  // An amount finer than a Money unit makes the account compare Decimal64s.
+  dbsc::Account fine { "Fine", "" };
+  fine.logTransaction( { dbsc::UuidStringUtil::generate(), fine.id(), {}, "-1.00005"_d64, july, "Fine rent" } );
+  fine.logTransaction( { dbsc::UuidStringUtil::generate(), fine.id(), {}, "-0.99"_d64, july, "Fine rent" } );
+  dbsc::UuidString const fineId = fine.id();
+  book.addParsedAccount( std::move( fine ) );
+  book.deactivate( handles[3] );
+
+  auto const store  = []( dbsc::Account const& account ) -> dbsc::TransactionStore const& {
+    return account.transactions();
+  };
+  auto const amount = [&]( dbsc::Account const& account, dbsc::TransactionStore::Row row ) {
+    return store( account ).amount( row );
+  };
+
+  checkQuery( book, {}, []( dbsc::Account const&, dbsc::TransactionStore::Row ) { return true; } );
+  checkQuery( book, !TransactionFilter(), []( dbsc::Account const&, dbsc::TransactionStore::Row ) {
+    return false;
+  } );
+
+  // The example of the component documentation.
+  TransactionFilter const rent = TransactionFilter::amountBelow( "-100.00"_d64 ) && TransactionFilter::external()
+                              && TransactionFilter::timeBetween( july, october )
+                              && TransactionFilter::notesContain( "Rent" );
+  checkQuery( book, rent, [&]( dbsc::Account const& account, dbsc::TransactionStore::Row row ) {
+    dbsc::TimeStamp const timeStamp = store( account ).timestamp( row );
+    return amount( account, row ) < "-100.00"_d64
+        && dbsc::UuidStringUtil::isNil( store( account ).counterpartyId( row ) ) && timeStamp >= july
+        && timeStamp < october && store( account ).notes( row ).contains( "Rent" );
+  } );
+  BSLS_ASSERT( dbsc::TransactionQuery( book, rent ).count() > 0 );
+
+  checkQuery( book,
+              TransactionFilter::amountBetween( "-0.50"_d64, "12.3456"_d64 )
+                || ( TransactionFilter::counterparty( counterparties[2] ) && !TransactionFilter::accountActive() ),
+              [&]( dbsc::Account const& account, dbsc::TransactionStore::Row row ) {
+                return ( amount( account, row ) >= "-0.50"_d64 && amount( account, row ) < "12.3456"_d64 )
+                    || ( store( account ).counterpartyId( row ) == counterparties[2] && not account.isActive() );
+              } );
+
+  // Bounds finer than a Money unit.
+  checkQuery( book,
+              TransactionFilter::amountAtLeast( "-1.00001"_d64 ) && !TransactionFilter::notesContain( "rent" ),
+              [&]( dbsc::Account const& account, dbsc::TransactionStore::Row row ) {
+                return amount( account, row ) >= "-1.00001"_d64
+                    && not store( account ).notes( row ).contains( "rent" );
+              } );
+  std::vector< dbsc::QueryMatch > const fineRent =
+    dbsc::TransactionQuery( book,
+                            TransactionFilter::amountBelow( "-1.00001"_d64 )
+                              && TransactionFilter::notesContain( "Fine" )
+                              && TransactionFilter::timeBetween( july, july + days( 1 ) ) )
+      .collect();
+  BSLS_ASSERT( fineRent.size() == 1 );
+  BSLS_ASSERT( fineRent[0].mAccount == book.handle( fineId ) && fineRent[0].mRow == 0 );
+
+  // A counterparty absent from every account matches nothing.
+  checkQuery( book,
+              TransactionFilter::counterparty( dbsc::UuidStringUtil::generate() ),
+              []( dbsc::Account const&, dbsc::TransactionStore::Row ) { return false; } );
+}
+
+static void testLaziness()
+{
+  dbsc::AccountBook book { std::string { "Owner" } };
+  auto const checking = book.handle( book.createAccount( "Checking", "" ) );
+  for ( int i = 0; i < 5000; ++i ) {
+    static_cast< void >( book.makeTransaction( "1.00"_d64, "Deposit", checking, std::nullopt ) );
+  }
+  dbsc::TransactionQuery const query { book, TransactionFilter::amountAtLeast( "1.00"_d64 ) };
+  auto matches = query.matches();
+  auto match   = matches.begin();
+  BSLS_ASSERT( match != matches.end() );
+  BSLS_ASSERT( ( *match ).mRow == 0 );
+  ++match;
+  BSLS_ASSERT( ( *match ).mRow == 1 );
+
+  dbsc::AccountBook const empty { std::string { "Owner" } };
+  dbsc::TransactionQuery const none { empty, {} };
+  BSLS_ASSERT( none.matches().begin() == none.matches().end() );
+  BSLS_ASSERT( none.collect().empty() );
+  BSLS_ASSERT( none.count() == 0 );
+}
+
+} // namespace
+
+int main()
+{
+  testFilters();
+  testLaziness();
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,387 @@
+// dbsc_transactionstore.cpp
+#include "dbsc_transactionstore.h"
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace dbsc {
+
+namespace {
+  /// Make room for @p count more elements, keeping geometric growth.
+  template< typename Column >
+  void growForAppend( Column& column, std::size_t count = 1 )
+  {
+    if ( column.capacity() - column.size() < count ) {
+      column.reserve( std::max( { std::size_t { 16 }, column.capacity() * 2, column.size() + count } ) );
+    }
+  }
+} // namespace
+
+TransactionStore::TransactionStore( allocator_type const& allocator )
+  : mIds( allocator )
+  , mAmounts( allocator )
+  , mAmountUnits( allocator )
+  , mTimeStamps( allocator )
+  , mCounterparties( allocator )
+  , mCounterpartyIds( allocator )
+  , mCounterpartyIndex( allocator )
+  , mNotes( allocator )
+  , mRecordSlots( allocator )
+  , mTransfers( allocator )
+  , mSplits( allocator )
+{
+}
+
+TransactionStore::TransactionStore( TransactionStore const& original, allocator_type const& allocator )
+  : mIds( original.mIds, allocator )
+  , mAmounts( original.mAmounts, allocator )
+  , mAmountUnits( original.mAmountUnits, allocator )
+  , mInexactAmountCount( original.mInexactAmountCount )
+  , mUnitTotal( original.mUnitTotal )
+  , mInexactTotal( original.mInexactTotal )
+  , mTimeStamps( original.mTimeStamps, allocator )
+  , mCounterparties( original.mCounterparties, allocator )
+  , mCounterpartyIds( original.mCounterpartyIds, allocator )
+  , mCounterpartyIndex( original.mCounterpartyIndex, allocator )
+  , mNotes( original.mNotes, allocator )
+  , mNotesPool( original.mNotesPool )
+  , mRecordSlots( original.mRecordSlots, allocator )
+  , mTransfers( original.mTransfers, allocator )
+  , mSplits( original.mSplits, allocator )
+{
+}
+
+TransactionStore::TransactionStore( TransactionStore&& original ) noexcept = default;
+
+TransactionStore::TransactionStore( TransactionStore&& original, allocator_type const& allocator )
+  : mIds( std::move( original.mIds ), allocator )
+  , mAmounts( std::move( original.mAmounts ), allocator )
+  , mAmountUnits( std::move( original.mAmountUnits ), allocator )
+  , mInexactAmountCount( original.mInexactAmountCount )
+  , mUnitTotal( original.mUnitTotal )
+  , mInexactTotal( original.mInexactTotal )
+  , mTimeStamps( std::move( original.mTimeStamps ), allocator )
+  , mCounterparties( std::move( original.mCounterparties ), allocator )
+  , mCounterpartyIds( std::move( original.mCounterpartyIds ), allocator )
+  , mCounterpartyIndex( std::move( original.mCounterpartyIndex ), allocator )
+  , mNotes( std::move( original.mNotes ), allocator )
+  , mNotesPool( std::move( original.mNotesPool ) )
+  , mRecordSlots( std::move( original.mRecordSlots ), allocator )
+  , mTransfers( std::move( original.mTransfers ), allocator )
+  , mSplits( std::move( original.mSplits ), allocator )
+{
+}
+
+auto TransactionStore::operator=( TransactionStore const& rhs ) -> TransactionStore& = default;
+
+auto TransactionStore::operator=( TransactionStore&& rhs ) -> TransactionStore& = default;
+
+auto TransactionStore::get_allocator() const noexcept -> allocator_type
+{
+  return mIds.get_allocator();
+}
+
+auto TransactionStore::size() const noexcept -> std::size_t
+{
+  return mIds.size();
+}
+
+auto TransactionStore::empty() const noexcept -> bool
+{
+  return mIds.empty();
+}
+
+auto TransactionStore::id( Row row ) const -> UuidString const&
+{
+  BSLS_ASSERT( row < size() );
+  return mIds[row];
+}
+
+auto TransactionStore::amount( Row row ) const -> BloombergLP::bdldfp::Decimal64
+{
+  BSLS_ASSERT( row < size() );
+  return mAmounts[row];
+}
+
+auto TransactionStore::timestamp( Row row ) const -> TimeStamp
+{
+  BSLS_ASSERT( row < size() );
+  return mTimeStamps[row];
+}
+
+auto TransactionStore::counterpartyId( Row row ) const -> UuidString const&
+{
+  BSLS_ASSERT( row < size() );
+  return mCounterpartyIds[mCounterparties[row]];
+}
+
+auto TransactionStore::notes( Row row ) const -> std::string_view
+{
+  BSLS_ASSERT( row < size() );
+  return mNotes[row];
+}
+
+auto TransactionStore::transfer( Row row ) const -> std::shared_ptr< Transfer const > const&
+{
+  static std::shared_ptr< Transfer const > const kNoTransfer {};
+
+  BSLS_ASSERT( row < size() );
+  std::uint32_t const slot = mRecordSlots[row];
+  return ( slot & kSplitSlotFlag ) != 0 ? kNoTransfer : mTransfers[slot];
+}
+
+auto TransactionStore::split( Row row ) const -> std::shared_ptr< Split const > const&
+{
+  static std::shared_ptr< Split const > const kNoSplit {};
+
+  BSLS_ASSERT( row < size() );
+  std::uint32_t const slot = mRecordSlots[row];
+  return slot == kNoRecord || ( slot & kSplitSlotFlag ) == 0 ? kNoSplit : mSplits[slot & ~kSplitSlotFlag];
+}
+
+auto TransactionStore::materialize( Row row, UuidString const& owningPartyId ) const -> Transaction
+{
+  if ( auto const& record = transfer( row ) ) {
+    return record->leg( owningPartyId );
+  }
+  if ( auto const& record = split( row ) ) {
+    return record->leg( owningPartyId );
+  }
+  Notes notes = mNotes[row].empty() ? Notes() : Notes( mNotesPool, mNotes[row] );
+  return { id( row ), owningPartyId, counterpartyId( row ), amount( row ), timestamp( row ), std::move( notes ) };
+}
+
+auto TransactionStore::ids() const noexcept -> std::span< UuidString const >
+{
+  return mIds;
+}
+
+auto TransactionStore::amounts() const noexcept -> std::span< BloombergLP::bdldfp::Decimal64 const >
+{
+  return mAmounts;
+}
+
+auto TransactionStore::amountUnits() const noexcept -> std::span< Money::Rep const >
+{
+  return mAmountUnits;
+}
+
+auto TransactionStore::amountsAreExact() const noexcept -> bool
+{
+  return mInexactAmountCount == 0;
+}
+
+auto TransactionStore::total() const -> BloombergLP::bdldfp::Decimal64
+{
+  BloombergLP::bdldfp::Decimal64 const unitTotal = mUnitTotal.toDecimal();
+  return mInexactTotal == BloombergLP::bdldfp::Decimal64() ? unitTotal : unitTotal + mInexactTotal;
+}
+
+auto TransactionStore::sumAmounts( Row first, Row last ) const -> BloombergLP::bdldfp::Decimal64
+{
+  BSLS_ASSERT( first <= last && last <= size() );
+  if ( amountsAreExact() ) {
+    if ( auto const units = MoneyUtil::sum( std::span( mAmountUnits ).subspan( first, last - first ) ) ) {
+      return Money::fromUnits( *units ).toDecimal();
+    }
+  }
+  BloombergLP::bdldfp::Decimal64 sum {};
+  for ( Row row = first; row < last; ++row ) {
+    sum += mAmounts[row];
+  }
+  return sum;
+}
+
+auto TransactionStore::timestamps() const noexcept -> std::span< TimeStamp const >
+{
+  return mTimeStamps;
+}
+
+auto TransactionStore::counterparties() const noexcept -> std::span< CounterpartyIndex const >
+{
+  return mCounterparties;
+}
+
+auto TransactionStore::counterpartyIds() const noexcept -> std::span< UuidString const >
+{
+  return mCounterpartyIds;
+}
+
+auto TransactionStore::notesColumn() const noexcept -> std::span< std::string_view const >
+{
+  return mNotes;
+}
+
+auto TransactionStore::notesPool() const noexcept -> std::shared_ptr< NotesPool > const&
+{
+  return mNotesPool;
+}
+
+auto TransactionStore::append( Transaction const& transaction ) -> Row
+{
+  if ( mNotesPool == nullptr ) {
+    mNotesPool = std::allocate_shared< NotesPool >( get_allocator() );
+  }
+  // Notes already interned in this store's pool need no lookup.
+  Notes const& notes           = transaction.sharedNotes();
+  std::string_view const text = notes.pool() == mNotesPool.get() ? notes.view() : mNotesPool->intern( notes.view() );
+  return appendRow( transaction.transactionId(),
+                    transaction.amount(),
+                    transaction.timestamp(),
+                    transaction.otherPartyId(),
+                    text,
+                    kNoRecord );
+}
+
+auto TransactionStore::appendTransfer( std::shared_ptr< Transfer const > transfer, UuidString const& owningPartyId )
+  -> Row
+{
+  BSLS_ASSERT( transfer != nullptr );
+  BSLS_ASSERT( transfer->involves( owningPartyId ) );
+  BSLS_ASSERT( mTransfers.size() < kSplitSlotFlag );
+
+  growForAppend( mTransfers );
+  auto const row = appendRow( transfer->id(),
+                              transfer->amountFor( owningPartyId ),
+                              transfer->timestamp(),
+                              transfer->counterpartyOf( owningPartyId ),
+                              transfer->notes(),
+                              static_cast< std::uint32_t >( mTransfers.size() ) );
+  mTransfers.push_back( std::move( transfer ) );
+  return row;
+}
+
+auto TransactionStore::appendSplit( std::shared_ptr< Split const > split, UuidString const& owningPartyId ) -> Row
+{
+  BSLS_ASSERT( split != nullptr );
+  BSLS_ASSERT( split->involves( owningPartyId ) );
+  BSLS_ASSERT( ( mSplits.size() | kSplitSlotFlag ) < kNoRecord );
+
+  growForAppend( mSplits );
+  auto const row = appendRow( split->id(),
+                              split->amountFor( owningPartyId ),
+                              split->timestamp(),
+                              UuidString(),
+                              split->notes(),
+                              static_cast< std::uint32_t >( mSplits.size() ) | kSplitSlotFlag );
+  mSplits.push_back( std::move( split ) );
+  return row;
+}
+
+auto TransactionStore::appendRow( UuidString const& id,
+                                  BloombergLP::bdldfp::Decimal64 amount,
+                                  TimeStamp timeStamp,
+                                  UuidString const& counterpartyId,
+                                  std::string_view notes,
+                                  std::uint32_t recordSlot ) -> Row
+{
+  BSLS_ASSERT( size() < std::numeric_limits< Row >::max() );
+  auto const row = static_cast< Row >( size() );
+
+  // Allocate up front so a failure cannot leave the columns different lengths.
+  growForAppend( mIds );
+  growForAppend( mAmounts );
+  growForAppend( mAmountUnits );
+  growForAppend( mTimeStamps );
+  growForAppend( mCounterparties );
+  growForAppend( mCounterpartyIds );
+  growForAppend( mNotes );
+  growForAppend( mRecordSlots );
+
+  CounterpartyIndex counterparty = static_cast< CounterpartyIndex >( mCounterpartyIds.size() );
+  if ( mCounterpartyIndex.insert( counterpartyId, counterparty ) ) {
+    mCounterpartyIds.push_back( counterpartyId );
+  } else {
+    counterparty = *mCounterpartyIndex.find( counterpartyId );
+  }
+
+  mIds.push_back( id );
+  mAmounts.push_back( amount );
+  auto const units = Money::fromDecimal( amount );
+  mAmountUnits.push_back( units ? units->units() : 0 );
+  if ( not units ) {
+    ++mInexactAmountCount;
+    mInexactTotal += amount;
+  } else if ( auto const unitTotal = Money::checkedAdd( mUnitTotal, *units ) ) {
+    mUnitTotal = *unitTotal;
+  } else {
+    mInexactTotal += amount;
+  }
+  mTimeStamps.push_back( timeStamp );
+  mCounterparties.push_back( counterparty );
+  mNotes.push_back( notes );
+  mRecordSlots.push_back( recordSlot );
+
+  return row;
+}
+
+void TransactionStore::reserve( std::size_t rowCount )
+{
+  mIds.reserve( rowCount );
+  mAmounts.reserve( rowCount );
+  mAmountUnits.reserve( rowCount );
+  mTimeStamps.reserve( rowCount );
+  mCounterparties.reserve( rowCount );
+  mNotes.reserve( rowCount );
+  mRecordSlots.reserve( rowCount );
+}
+
+void TransactionStore::reserveForAppend( std::size_t rowCount )
+{
+  growForAppend( mIds, rowCount );
+  growForAppend( mAmounts, rowCount );
+  growForAppend( mAmountUnits, rowCount );
+  growForAppend( mTimeStamps, rowCount );
+  growForAppend( mCounterparties, rowCount );
+  growForAppend( mCounterpartyIds, rowCount );
+  growForAppend( mNotes, rowCount );
+  growForAppend( mRecordSlots, rowCount );
+  growForAppend( mTransfers, rowCount );
+  growForAppend( mSplits, rowCount );
+  mCounterpartyIndex.reserve( mCounterpartyIds.size() + rowCount );
+}
+
+void TransactionStore::setNotesPool( std::shared_ptr< NotesPool > pool )
+{
+  BSLS_ASSERT( pool != nullptr );
+  if ( pool == mNotesPool ) {
+    return;
+  }
+  for ( std::size_t row = 0; row < size(); ++row ) {
+    if ( mRecordSlots[row] == kNoRecord ) {
+      mNotes[row] = pool->intern( mNotes[row] );
+    }
+  }
+  mNotesPool = std::move( pool );
+}
+
+auto operator==( TransactionStore const& a, TransactionStore const& b ) -> bool
+{
+  return a.mIds == b.mIds && a.mAmounts == b.mAmounts && a.mTimeStamps == b.mTimeStamps
+      && a.mCounterparties == b.mCounterparties && a.mCounterpartyIds == b.mCounterpartyIds
+      && a.mNotes == b.mNotes && a.mRecordSlots == b.mRecordSlots
+      && std::ranges::equal( a.mTransfers, b.mTransfers, []( auto const& x, auto const& y ) { return *x == *y; } )
+      && std::ranges::equal( a.mSplits, b.mSplits, []( auto const& x, auto const& y ) { return *x == *y; } );
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
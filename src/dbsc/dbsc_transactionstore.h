@@ -0,0 +1,239 @@
+// dbsc_transactionstore.h
+#ifndef INCLUDED_DBSC_TRANSACTIONSTORE
+#define INCLUDED_DBSC_TRANSACTIONSTORE
+
+//@PURPOSE: Provide columnar storage for the transactions of one account.
+//
+//@CLASSES:
+//  dbsc::TransactionStore: a structure-of-arrays container of transactions
+//    sharing one owning party.
+//
+//@DESCRIPTION: This component defines the storage behind dbsc::Account. Each
+//  transaction attribute lives in its own contiguous column, indexed by row:
+//
+//  - ids: the transaction UuidStrings
+//  - amounts: `Decimal64`, and the same amounts as dbsc::Money units
+//  - timestamps: `dbsc::TimeStamp`
+//  - counterparties: a 32-bit index into a per-store dictionary of
+//    counterparty ids (the nil id denotes an external party)
+//  - notes: views of text interned in a dbsc::NotesPool
+//  - records: for rows that are a leg of a dbsc::Transfer or a dbsc::Split,
+//    a slot holding the shared record (see dbsc_transfer, dbsc_split)
+//
+//  A scan over one attribute (e.g. summing amounts within a date range) thus
+//  reads only the columns it needs, sequentially. The owning party is the
+//  same for every row and is therefore not stored; callers supply it when a
+//  row is materialized into a dbsc::Transaction value.
+//
+//  Notes are interned in a pool that may be shared with other stores (an
+//  account book shares one pool across its accounts); a store creates its
+//  own pool on first use if none was set. Materialized Transactions reference
+//  the pooled text rather than copying it.
+//
+//  Transfer and split rows keep their id, amount, timestamp and counterparty
+//  in the columns like any other row, so scans need not distinguish them.
+//  Their notes column entry views the text held by the shared record. A row's
+//  leg is materialized from the record, so every account of a transfer or
+//  split always agrees.
+//
+//  Amounts are kept twice: as the `Decimal64` of the public interface, and
+//  as fixed-point units (see dbsc_money) for aggregation. The store maintains
+//  its total as it grows, in units where possible, and sums ranges of rows
+//  with the integer kernel of dbsc::MoneyUtil. Amounts finer than a Money
+//  unit are rare; while any is present, sums fall back to `Decimal64`.
+//
+//  Rows are append-only and keep their position for the store's lifetime.
+//
+//  The store is allocator-aware in the BDE style: every column, the
+//  counterparty dictionary and index, and a pool the store creates for itself
+//  are obtained from the allocator supplied at construction. A pool set with
+//  `setNotesPool`, and transfer and split records, are shared and owned by whoever
+//  created them; a copy shares them with the original.
+//
+/// Usage
+/// -----
+/// Example 1: Totalling deposits
+///
+/// ```cpp
+/// dbsc::TransactionStore const& store = account.transactions();
+/// Decimal64 deposits {};
+/// for (Decimal64 amount : store.amounts()) {
+///     if (amount > Decimal64()) {
+///         deposits += amount;
+///     }
+/// }
+/// ```
+
+#include <dbsc_money.h>
+#include <dbsc_notespool.h>
+#include <dbsc_sharedapi.h>
+#include <dbsc_split.h>
+#include <dbsc_transaction.h>
+#include <dbsc_transfer.h>
+#include <dbsc_uuidindex.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace dbsc {
+
+/// Structure-of-arrays storage for the transactions of a single account.
+class TransactionStore
+{
+public:
+  using Row               = std::uint32_t;
+  using CounterpartyIndex = std::uint32_t;
+  using allocator_type    = bsl::allocator< char >; // NOLINT
+
+  DBSC_API explicit TransactionStore( allocator_type const& allocator = allocator_type() );
+  DBSC_API TransactionStore( TransactionStore const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API TransactionStore( TransactionStore&& original ) noexcept;
+  DBSC_API TransactionStore( TransactionStore&& original, allocator_type const& allocator );
+  DBSC_API auto operator=( TransactionStore const& rhs ) -> TransactionStore&;
+  DBSC_API auto operator=( TransactionStore&& rhs ) -> TransactionStore&;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+  [[nodiscard]] DBSC_API auto size() const noexcept -> std::size_t;
+  [[nodiscard]] DBSC_API auto empty() const noexcept -> bool;
+
+  // Row accessors
+
+  [[nodiscard]] DBSC_API auto id( Row row ) const -> UuidString const&;
+  [[nodiscard]] DBSC_API auto amount( Row row ) const -> BloombergLP::bdldfp::Decimal64;
+  [[nodiscard]] DBSC_API auto timestamp( Row row ) const -> TimeStamp;
+  [[nodiscard]] DBSC_API auto counterpartyId( Row row ) const -> UuidString const&;
+  [[nodiscard]] DBSC_API auto notes( Row row ) const -> std::string_view;
+  /// @return the shared record of a transfer row, or null for other rows.
+  [[nodiscard]] DBSC_API auto transfer( Row row ) const -> std::shared_ptr< Transfer const > const&;
+  /// @return the shared record of a split row, or null for other rows.
+  [[nodiscard]] DBSC_API auto split( Row row ) const -> std::shared_ptr< Split const > const&;
+
+  /// @return the transaction at @p row as a value, owned by @p owningPartyId.
+  [[nodiscard]] DBSC_API auto materialize( Row row, UuidString const& owningPartyId ) const -> Transaction;
+
+  // Columns
+
+  [[nodiscard]] DBSC_API auto ids() const noexcept -> std::span< UuidString const >;
+  [[nodiscard]] DBSC_API auto amounts() const noexcept -> std::span< BloombergLP::bdldfp::Decimal64 const >;
+  /// Per-row amounts in dbsc::Money units; rows whose amount is not
+  /// representable hold 0 (see `amountsAreExact()`).
+  [[nodiscard]] DBSC_API auto amountUnits() const noexcept -> std::span< Money::Rep const >;
+  [[nodiscard]] DBSC_API auto timestamps() const noexcept -> std::span< TimeStamp const >;
+  /// Per-row indices into `counterpartyIds()`.
+  [[nodiscard]] DBSC_API auto counterparties() const noexcept -> std::span< CounterpartyIndex const >;
+  /// The distinct counterparty ids, in order of first appearance.
+  [[nodiscard]] DBSC_API auto counterpartyIds() const noexcept -> std::span< UuidString const >;
+  /// Per-row notes; the views stay valid for the lifetime of the store.
+  [[nodiscard]] DBSC_API auto notesColumn() const noexcept -> std::span< std::string_view const >;
+
+  /// Query if every amount is represented in `amountUnits()`.
+  [[nodiscard]] DBSC_API auto amountsAreExact() const noexcept -> bool;
+
+  /// @return the sum of all amounts, in constant time.
+  [[nodiscard]] DBSC_API auto total() const -> BloombergLP::bdldfp::Decimal64;
+  /// @return the sum of the amounts of rows [@p first, @p last).
+  /// @pre `first <= last && last <= size()`.
+  [[nodiscard]] DBSC_API auto sumAmounts( Row first, Row last ) const -> BloombergLP::bdldfp::Decimal64;
+
+  /// The pool this store interns notes into; null until the first append
+  /// unless set.
+  [[nodiscard]] DBSC_API auto notesPool() const noexcept -> std::shared_ptr< NotesPool > const&;
+
+  // Manipulators
+
+  /// Append @p transaction as a new row. Its owning party is not recorded.
+  /// @return the new row.
+  DBSC_API auto append( Transaction const& transaction ) -> Row;
+
+  /// Append the leg of @p transfer owned by @p owningPartyId as a new row
+  /// that shares the record.
+  /// @pre `transfer` is non-null and `transfer->involves( owningPartyId )`.
+  /// @return the new row.
+  DBSC_API auto appendTransfer( std::shared_ptr< Transfer const > transfer, UuidString const& owningPartyId ) -> Row;
+
+  /// Append the leg of @p split owned by @p owningPartyId as a new row that
+  /// shares the record. Its counterparty is the nil (external) id.
+  /// @pre `split` is non-null and `split->involves( owningPartyId )`.
+  /// @return the new row.
+  DBSC_API auto appendSplit( std::shared_ptr< Split const > split, UuidString const& owningPartyId ) -> Row;
+
+  /// Intern all notes into @p pool from now on, moving the notes of existing
+  /// rows into it. Does nothing if @p pool is already in use.
+  DBSC_API void setNotesPool( std::shared_ptr< NotesPool > pool );
+
+  /// Ensure @p rowCount rows fit without reallocating the fixed-width columns.
+  DBSC_API void reserve( std::size_t rowCount );
+
+  /// Ensure @p rowCount more rows of any kind can be appended without
+  /// allocating, provided their notes are already interned in `notesPool()`.
+  DBSC_API void reserveForAppend( std::size_t rowCount );
+
+  /// Stores are equal if they hold the same rows in the same order. Transfer
+  /// and split records are compared by value.
+  DBSC_API friend auto operator==( TransactionStore const& a, TransactionStore const& b ) -> bool;
+
+private:
+  static constexpr std::uint32_t kNoRecord = UINT32_MAX;
+  /// Marks a record slot as an index into `mSplits` rather than `mTransfers`.
+  static constexpr std::uint32_t kSplitSlotFlag = 1U << 31;
+
+  /// Append the column entries shared by every kind of row.
+  auto appendRow( UuidString const& id,
+                  BloombergLP::bdldfp::Decimal64 amount,
+                  TimeStamp timeStamp,
+                  UuidString const& counterpartyId,
+                  std::string_view notes,
+                  std::uint32_t recordSlot ) -> Row;
+
+  bsl::vector< UuidString > mIds;
+  bsl::vector< BloombergLP::bdldfp::Decimal64 > mAmounts;
+  bsl::vector< Money::Rep > mAmountUnits;
+  /// Number of rows whose amount is not representable as Money.
+  std::size_t mInexactAmountCount { 0 };
+  /// `total()` is `mUnitTotal` plus `mInexactTotal`; the latter holds the
+  /// amounts that are not representable or would overflow the former.
+  Money mUnitTotal {};
+  BloombergLP::bdldfp::Decimal64 mInexactTotal {};
+  bsl::vector< TimeStamp > mTimeStamps;
+  bsl::vector< CounterpartyIndex > mCounterparties;
+  bsl::vector< UuidString > mCounterpartyIds;
+  /// Maps counterparty ids to positions in `mCounterpartyIds`.
+  UuidIndex mCounterpartyIndex;
+  bsl::vector< std::string_view > mNotes;
+  std::shared_ptr< NotesPool > mNotesPool {};
+  /// Per-row index into `mTransfers`, `kSplitSlotFlag` plus an index into
+  /// `mSplits`, or `kNoRecord`.
+  bsl::vector< std::uint32_t > mRecordSlots;
+  bsl::vector< std::shared_ptr< Transfer const > > mTransfers;
+  bsl::vector< std::shared_ptr< Split const > > mSplits;
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,206 @@
+// dbsc_transactionstore.t.cpp
+// Test driver for dbsc::TransactionStore
+#include <dbsc_money.h>
+#include <dbsc_split.h>
+#include <dbsc_transaction.h>
+#include <dbsc_transactionstore.h>
+#include <dbsc_transfer.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bsls_assert.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+
+static void testAppendAndMaterialize()
+{
+  auto const owner        = dbsc::UuidStringUtil::generate();
+  auto const counterparty = dbsc::UuidStringUtil::generate();
+  dbsc::TimeStamp const start { std::chrono::system_clock::now() };
+
+  dbsc::TransactionStore store;
+  BSLS_ASSERT( store.empty() );
+
+  dbsc::Transaction const transfer {
+    dbsc::UuidStringUtil::generate(), owner, counterparty, "-5.25"_d64, start, "rent"
+  };
+  dbsc::Transaction const deposit {
+    dbsc::UuidStringUtil::generate(), owner, {}, "100.00"_d64, start + std::chrono::seconds( 1 ), ""
+  };
+  dbsc::Transaction const refund {
+    dbsc::UuidStringUtil::generate(), owner, counterparty, "1.50"_d64, start + std::chrono::seconds( 2 ), "refund"
+  };
+  BSLS_ASSERT( store.append( transfer ) == 0 );
+  BSLS_ASSERT( store.append( deposit ) == 1 );
+  BSLS_ASSERT( store.append( refund ) == 2 );
+  BSLS_ASSERT( store.size() == 3 );
+
+  BSLS_ASSERT( store.materialize( 0, owner ) == transfer );
+  BSLS_ASSERT( store.materialize( 1, owner ) == deposit );
+  BSLS_ASSERT( store.materialize( 2, owner ) == refund );
+  BSLS_ASSERT( store.notes( 1 ).empty() );
+  BSLS_ASSERT( store.notes( 2 ) == "refund" );
+
+  // Columns
+  BSLS_ASSERT( store.ids()[1] == deposit.transactionId() );
+  BSLS_ASSERT( store.amounts()[2] == "1.50"_d64 );
+  BSLS_ASSERT( store.timestamps()[1] == deposit.timestamp() );
+  BSLS_ASSERT( store.notesColumn().size() == store.size() );
+  BSLS_ASSERT( store.notesColumn()[0] == "rent" );
+
+  // Notes are interned: materialized transactions view the pooled text.
+  BSLS_ASSERT( store.notesPool() != nullptr );
+  BSLS_ASSERT( store.materialize( 2, owner ).notes().data() == store.notes( 2 ).data() );
+  BSLS_ASSERT( store.notesPool()->stats().mUniqueCount == 2 );
+
+  // Counterparties are deduplicated.
+  BSLS_ASSERT( store.counterpartyIds().size() == 2 );
+  BSLS_ASSERT( store.counterparties()[0] == store.counterparties()[2] );
+  BSLS_ASSERT( dbsc::UuidStringUtil::isNil( store.counterpartyId( 1 ) ) );
+
+  BloombergLP::bdldfp::Decimal64 total {};
+  for ( auto const amount : store.amounts() ) {
+    total += amount;
+  }
+  BSLS_ASSERT( total == "96.25"_d64 );
+}
+
+static void testTransferRows()
+{
+  auto const sourceId      = dbsc::UuidStringUtil::generate();
+  auto const destinationId = dbsc::UuidStringUtil::generate();
+  auto const transfer      = std::make_shared< dbsc::Transfer const >( dbsc::UuidStringUtil::generate(),
+                                                                  sourceId,
+                                                                  destinationId,
+                                                                  "-20.00"_d64,
+                                                                  std::chrono::system_clock::now(),
+                                                                  "shared notes" );
+
+  dbsc::TransactionStore sourceStore;
+  dbsc::TransactionStore destinationStore;
+  sourceStore.append( dbsc::Transaction(
+    dbsc::UuidStringUtil::generate(), sourceId, {}, "50.00"_d64, std::chrono::system_clock::now(), "local" ) );
+  BSLS_ASSERT( sourceStore.transfer( 0 ) == nullptr );
+  BSLS_ASSERT( sourceStore.appendTransfer( transfer, sourceId ) == 1 );
+  BSLS_ASSERT( destinationStore.appendTransfer( transfer, destinationId ) == 0 );
+
+  // Both stores reference the one record; notes are not copied.
+  BSLS_ASSERT( sourceStore.transfer( 1 ).get() == destinationStore.transfer( 0 ).get() );
+  BSLS_ASSERT( sourceStore.notes( 0 ) == "local" );
+  BSLS_ASSERT( destinationStore.notes( 0 ).data() == transfer->notes().data() );
+  BSLS_ASSERT( sourceStore.notes( 1 ).data() == transfer->notes().data() );
+
+  // The columns still hold each leg's own view.
+  BSLS_ASSERT( sourceStore.amounts()[1] == "-20.00"_d64 );
+  BSLS_ASSERT( destinationStore.amounts()[0] == "20.00"_d64 );
+  BSLS_ASSERT( destinationStore.counterpartyId( 0 ) == sourceId );
+  BSLS_ASSERT( sourceStore.materialize( 1, sourceId ) == transfer->leg( sourceId ) );
+  BSLS_ASSERT( dbsc::Transaction::isPair( sourceStore.materialize( 1, sourceId ),
+                                          destinationStore.materialize( 0, destinationId ) ) );
+
+  // Equality compares transfer records by value.
+  dbsc::TransactionStore copy;
+  copy.appendTransfer( std::make_shared< dbsc::Transfer const >( *transfer ), destinationId );
+  BSLS_ASSERT( copy == destinationStore );
+}
+
+static void testSplitRows()
+{
+  auto const rentId    = dbsc::UuidStringUtil::generate();
+  auto const savingsId = dbsc::UuidStringUtil::generate();
+  std::vector< dbsc::SplitLeg > const legs { { rentId, "70.00"_d64 }, { savingsId, "30.00"_d64 } };
+  auto const split = std::make_shared< dbsc::Split const >(
+    dbsc::UuidStringUtil::generate(), "100.00"_d64, std::chrono::system_clock::now(), dbsc::Notes( "paycheck" ), legs );
+
+  dbsc::TransactionStore store;
+  auto const transfer = std::make_shared< dbsc::Transfer const >(
+    dbsc::UuidStringUtil::generate(), rentId, savingsId, "-5.00"_d64, std::chrono::system_clock::now(), "" );
+  store.appendTransfer( transfer, rentId );
+  BSLS_ASSERT( store.appendSplit( split, rentId ) == 1 );
+
+  // Split and transfer rows keep apart.
+  BSLS_ASSERT( store.split( 0 ) == nullptr );
+  BSLS_ASSERT( store.transfer( 1 ) == nullptr );
+  BSLS_ASSERT( store.split( 1 ).get() == split.get() );
+  BSLS_ASSERT( store.notes( 1 ).data() == split->notes().data() );
+  BSLS_ASSERT( store.amounts()[1] == "70.00"_d64 );
+  BSLS_ASSERT( dbsc::UuidStringUtil::isNil( store.counterpartyId( 1 ) ) );
+  BSLS_ASSERT( store.materialize( 1, rentId ) == split->leg( rentId ) );
+
+  dbsc::TransactionStore copy;
+  copy.appendTransfer( transfer, rentId );
+  copy.appendSplit( std::make_shared< dbsc::Split const >( *split ), rentId );
+  BSLS_ASSERT( copy == store );
+}
+
+static void testTotals()
+{
+  auto const owner = dbsc::UuidStringUtil::generate();
+  dbsc::TransactionStore store;
+  for ( auto const amount : { "10.25"_d64, "-3.50"_d64, "100.00"_d64 } ) {
+    store.append( dbsc::Transaction(
+      dbsc::UuidStringUtil::generate(), owner, {}, amount, std::chrono::system_clock::now(), "" ) );
+  }
+  BSLS_ASSERT( store.amountsAreExact() );
+  BSLS_ASSERT( store.amountUnits()[1] == dbsc::Money::fromDecimal( "-3.50"_d64 )->units() );
+  BSLS_ASSERT( store.total() == "106.75"_d64 );
+  BSLS_ASSERT( store.sumAmounts( 1, 3 ) == "96.50"_d64 );
+  BSLS_ASSERT( store.sumAmounts( 2, 2 ) == "0.00"_d64 );
+
+  // Amounts finer than a Money unit fall back to Decimal64 arithmetic.
+  store.append( dbsc::Transaction(
+    dbsc::UuidStringUtil::generate(), owner, {}, "0.00001"_d64, std::chrono::system_clock::now(), "" ) );
+  BSLS_ASSERT( not store.amountsAreExact() );
+  BSLS_ASSERT( store.total() == "106.75001"_d64 );
+  BSLS_ASSERT( store.sumAmounts( 2, 4 ) == "100.00001"_d64 );
+}
+
+static void testEquality()
+{
+  auto const owner = dbsc::UuidStringUtil::generate();
+  dbsc::Transaction const transaction {
+    dbsc::UuidStringUtil::generate(), owner, {}, "1.00"_d64, std::chrono::system_clock::now(), "notes"
+  };
+
+  dbsc::TransactionStore first;
+  dbsc::TransactionStore second;
+  BSLS_ASSERT( first == second );
+  first.append( transaction );
+  BSLS_ASSERT( first != second );
+  second.reserve( 8 );
+  second.append( transaction );
+  BSLS_ASSERT( first == second );
+}
+} // namespace
+
+int main()
+{
+  testAppendAndMaterialize();
+  testTransferRows();
+  testSplitRows();
+  testTotals();
+  testEquality();
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
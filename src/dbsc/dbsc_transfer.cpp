@@ -0,0 +1,130 @@
+// dbsc_transfer.cpp
+#include "dbsc_transfer.h"
+
+#include <bsls_assert.h>
+
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+namespace dbsc {
+
+Transfer::Transfer( UuidString const& transferId,
+                    UuidString const& sourceId,
+                    UuidString const& destinationId,
+                    BloombergLP::bdldfp::Decimal64 sourceAmount,
+                    TimeStamp timeStamp,
+                    std::string const& notes )
+  : Transfer( transferId, sourceId, destinationId, sourceAmount, timeStamp, Notes( notes ) )
+{
+}
+
+Transfer::Transfer( UuidString const& transferId,
+                    UuidString const& sourceId,
+                    UuidString const& destinationId,
+                    BloombergLP::bdldfp::Decimal64 sourceAmount,
+                    TimeStamp timeStamp,
+                    Notes notes )
+  : mId( transferId )
+  , mSourceId( sourceId )
+  , mDestinationId( destinationId )
+  , mSourceAmount( sourceAmount )
+  , mTimeStamp( timeStamp )
+  , mNotes( std::move( notes ) )
+{
+  if ( UuidStringUtil::isNil( sourceId ) || UuidStringUtil::isNil( destinationId ) ) {
+    throw std::invalid_argument( std::format( "Transfer {} requires two internal parties.", transferId ) );
+  }
+  if ( sourceId == destinationId ) {
+    throw std::invalid_argument( std::format( "Transfer {} has the same source and destination.", transferId ) );
+  }
+}
+
+auto Transfer::fromLeg( Transaction const& leg ) -> Transfer
+{
+  return { leg.transactionId(),
+           leg.owningPartyId(),
+           leg.otherPartyId(),
+           leg.amount(),
+           leg.timestamp(),
+           leg.sharedNotes() };
+}
+
+auto Transfer::id() const -> UuidString const&
+{
+  return mId;
+}
+
+auto Transfer::sourceId() const -> UuidString const&
+{
+  return mSourceId;
+}
+
+auto Transfer::destinationId() const -> UuidString const&
+{
+  return mDestinationId;
+}
+
+auto Transfer::sourceAmount() const -> BloombergLP::bdldfp::Decimal64
+{
+  return mSourceAmount;
+}
+
+auto Transfer::timestamp() const -> TimeStamp
+{
+  return mTimeStamp;
+}
+
+auto Transfer::notes() const -> std::string_view
+{
+  return mNotes.view();
+}
+
+auto Transfer::sharedNotes() const -> Notes const&
+{
+  return mNotes;
+}
+
+auto Transfer::involves( UuidString const& partyId ) const -> bool
+{
+  return partyId == mSourceId || partyId == mDestinationId;
+}
+
+auto Transfer::counterpartyOf( UuidString const& partyId ) const -> UuidString const&
+{
+  BSLS_ASSERT( involves( partyId ) );
+  return partyId == mSourceId ? mDestinationId : mSourceId;
+}
+
+auto Transfer::amountFor( UuidString const& partyId ) const -> BloombergLP::bdldfp::Decimal64
+{
+  BSLS_ASSERT( involves( partyId ) );
+  return partyId == mSourceId ? mSourceAmount : -mSourceAmount;
+}
+
+auto Transfer::leg( UuidString const& partyId ) const -> Transaction
+{
+  if ( not involves( partyId ) ) {
+    throw std::invalid_argument( std::format( "Account {} is not a party to transfer {}.", partyId, mId ) );
+  }
+  return { mId, partyId, counterpartyOf( partyId ), amountFor( partyId ), mTimeStamp, mNotes };
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,122 @@
+// dbsc_transfer.h
+#ifndef INCLUDED_DBSC_TRANSFER
+#define INCLUDED_DBSC_TRANSFER
+
+//@PURPOSE: Provide a single record for a transfer between two accounts.
+//
+//@CLASSES:
+//  dbsc::Transfer: an immutable record of an internal transfer from which
+//    both of its Transaction legs are derived.
+//
+//@DESCRIPTION: An internal transfer appears in two accounts as a pair of
+//  Transactions (see `dbsc::Transaction::isPair`): same id, timestamp and
+//  notes, swapped parties, and amounts of opposite sign. This component
+//  stores that information once. The amount is expressed from the source
+//  party's perspective; the destination's leg carries the negated amount.
+//
+//  Both accounts of a transfer hold the same record (through a
+//  `std::shared_ptr< Transfer const >`), so the notes and ids are not
+//  duplicated in memory, and serializers can write the record once.
+//
+/// Usage
+/// -----
+/// Example 1: Deriving the legs
+///
+/// ```cpp
+/// dbsc::Transfer const transfer { id, savingsId, checkingId, -100.00_d64, now, "Move to checking" };
+/// dbsc::Transaction const savingsLeg  = transfer.leg( savingsId );  // -100.00
+/// dbsc::Transaction const checkingLeg = transfer.leg( checkingId ); // +100.00
+/// assert( dbsc::Transaction::isPair( savingsLeg, checkingLeg ) );
+/// ```
+
+#include <dbsc_notespool.h>
+#include <dbsc_sharedapi.h>
+#include <dbsc_transaction.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+
+#include <string>
+
+namespace dbsc {
+
+/// An internal transfer between two distinct accounts.
+class Transfer
+{
+public:
+  /// @throw @c std::invalid_argument if either party is nil or both parties
+  /// are the same.
+  [[nodiscard]] DBSC_API Transfer( UuidString const& transferId,
+                                   UuidString const& sourceId,
+                                   UuidString const& destinationId,
+                                   BloombergLP::bdldfp::Decimal64 sourceAmount,
+                                   TimeStamp timeStamp,
+                                   std::string const& notes );
+  /// As above, sharing @p notes (e.g. text interned in a dbsc::NotesPool).
+  [[nodiscard]] DBSC_API Transfer( UuidString const& transferId,
+                                   UuidString const& sourceId,
+                                   UuidString const& destinationId,
+                                   BloombergLP::bdldfp::Decimal64 sourceAmount,
+                                   TimeStamp timeStamp,
+                                   Notes notes );
+
+  /// @return the transfer whose source leg is @p leg.
+  /// @throw @c std::invalid_argument if @p leg is not an internal transfer.
+  [[nodiscard]] DBSC_API static auto fromLeg( Transaction const& leg ) -> Transfer;
+
+  [[nodiscard]] DBSC_API auto id() const -> UuidString const&;
+  [[nodiscard]] DBSC_API auto sourceId() const -> UuidString const&;
+  [[nodiscard]] DBSC_API auto destinationId() const -> UuidString const&;
+  /// The amount as seen by the source account.
+  [[nodiscard]] DBSC_API auto sourceAmount() const -> BloombergLP::bdldfp::Decimal64;
+  [[nodiscard]] DBSC_API auto timestamp() const -> TimeStamp;
+  [[nodiscard]] DBSC_API auto notes() const -> std::string_view;
+  /// The notes, for sharing with derived Transactions.
+  [[nodiscard]] DBSC_API auto sharedNotes() const -> Notes const&;
+
+  /// Query if @p partyId is the source or the destination.
+  [[nodiscard]] DBSC_API auto involves( UuidString const& partyId ) const -> bool;
+
+  /// @return the party opposite @p partyId.
+  /// @pre `involves( partyId )`
+  [[nodiscard]] DBSC_API auto counterpartyOf( UuidString const& partyId ) const -> UuidString const&;
+
+  /// @return the amount as seen by @p partyId.
+  /// @pre `involves( partyId )`
+  [[nodiscard]] DBSC_API auto amountFor( UuidString const& partyId ) const -> BloombergLP::bdldfp::Decimal64;
+
+  /// Materialize the Transaction owned by @p partyId.
+  /// @throw @c std::invalid_argument if @p partyId is not a party.
+  [[nodiscard]] DBSC_API auto leg( UuidString const& partyId ) const -> Transaction;
+
+  [[nodiscard]] friend auto operator==( Transfer const& a, Transfer const& b ) -> bool = default;
+
+private:
+  UuidString mId;
+  UuidString mSourceId;
+  UuidString mDestinationId;
+  BloombergLP::bdldfp::Decimal64 mSourceAmount;
+  TimeStamp mTimeStamp;
+  Notes mNotes {};
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,85 @@
+// dbsc_transfer.t.cpp
+// Test driver for dbsc::Transfer
+#include <dbsc_transaction.h>
+#include <dbsc_transfer.h>
+#include <dbsc_uuidstring.h>
+
+#include <bdldfp_decimal.h>
+#include <bsls_assert.h>
+
+#include <chrono>
+#include <stdexcept>
+
+namespace {
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+
+static void testLegs()
+{
+  auto const transferId    = dbsc::UuidStringUtil::generate();
+  auto const sourceId      = dbsc::UuidStringUtil::generate();
+  auto const destinationId = dbsc::UuidStringUtil::generate();
+  dbsc::TimeStamp const timeStamp { std::chrono::system_clock::now() };
+  dbsc::Transfer const transfer { transferId, sourceId, destinationId, "-42.50"_d64, timeStamp, "groceries" };
+
+  BSLS_ASSERT( transfer.involves( sourceId ) );
+  BSLS_ASSERT( transfer.involves( destinationId ) );
+  BSLS_ASSERT( not transfer.involves( transferId ) );
+  BSLS_ASSERT( transfer.counterpartyOf( sourceId ) == destinationId );
+  BSLS_ASSERT( transfer.amountFor( destinationId ) == "42.50"_d64 );
+
+  dbsc::Transaction const sourceLeg      = transfer.leg( sourceId );
+  dbsc::Transaction const destinationLeg = transfer.leg( destinationId );
+  BSLS_ASSERT( sourceLeg
+               == dbsc::Transaction( transferId, sourceId, destinationId, "-42.50"_d64, timeStamp, "groceries" ) );
+  BSLS_ASSERT( dbsc::Transaction::isPair( sourceLeg, destinationLeg ) );
+
+  // Either leg reconstructs an equivalent record.
+  BSLS_ASSERT( dbsc::Transfer::fromLeg( sourceLeg ) == transfer );
+  BSLS_ASSERT( dbsc::Transfer::fromLeg( destinationLeg ).leg( sourceId ) == sourceLeg );
+
+  try {
+    static_cast< void >( transfer.leg( dbsc::UuidStringUtil::generate() ) );
+    BSLS_ASSERT( false );
+  } catch ( std::invalid_argument const& ) {
+  }
+}
+
+static void testInvalidParties()
+{
+  auto const partyId = dbsc::UuidStringUtil::generate();
+  dbsc::TimeStamp const timeStamp { std::chrono::system_clock::now() };
+  try {
+    dbsc::Transfer const selfTransfer { dbsc::UuidStringUtil::generate(), partyId, partyId, "1.00"_d64, timeStamp, "" };
+    BSLS_ASSERT( false );
+  } catch ( std::invalid_argument const& ) {
+  }
+  try {
+    dbsc::Transfer const externalTransfer { dbsc::UuidStringUtil::generate(), partyId, {}, "1.00"_d64, timeStamp, "" };
+    BSLS_ASSERT( false );
+  } catch ( std::invalid_argument const& ) {
+  }
+}
+} // namespace
+
+int main()
+{
+  testLegs();
+  testInvalidParties();
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,178 @@
+// dbsc_uuidindex.cpp
+#include "dbsc_uuidindex.h"
+
+#include <bsls_assert.h>
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace dbsc {
+
+namespace {
+  constexpr std::size_t kMinimumSlotCount = 16;
+
+  /// Keep the load factor at or below 7/8 so probe sequences stay short.
+  constexpr auto slotCountFor( std::size_t keyCount ) -> std::size_t
+  {
+    return std::bit_ceil( std::max( kMinimumSlotCount, keyCount + keyCount / 7 + 1 ) );
+  }
+} // namespace
+
+UuidIndex::UuidIndex( allocator_type const& allocator )
+  : mSlots( allocator )
+{
+}
+
+UuidIndex::UuidIndex( UuidIndex const& original, allocator_type const& allocator )
+  : mSlots( original.mSlots, allocator )
+  , mSize( original.mSize )
+{
+}
+
+UuidIndex::UuidIndex( UuidIndex&& original ) noexcept
+  : mSlots( std::move( original.mSlots ) )
+  , mSize( std::exchange( original.mSize, 0 ) )
+{
+}
+
+UuidIndex::UuidIndex( UuidIndex&& original, allocator_type const& allocator )
+  : mSlots( std::move( original.mSlots ), allocator )
+  , mSize( std::exchange( original.mSize, 0 ) )
+{
+  original.mSlots.clear();
+}
+
+auto UuidIndex::operator=( UuidIndex const& rhs ) -> UuidIndex&
+{
+  mSlots = rhs.mSlots;
+  mSize  = rhs.mSize;
+  return *this;
+}
+
+auto UuidIndex::operator=( UuidIndex&& rhs ) -> UuidIndex&
+{
+  mSlots = std::move( rhs.mSlots );
+  mSize  = std::exchange( rhs.mSize, 0 );
+  rhs.mSlots.clear();
+  return *this;
+}
+
+auto UuidIndex::get_allocator() const noexcept -> allocator_type
+{
+  return mSlots.get_allocator();
+}
+
+auto UuidIndex::slotFor( UuidString const& key ) const -> std::size_t
+{
+  BSLS_ASSERT( std::has_single_bit( mSlots.size() ) );
+  std::size_t const mask = mSlots.size() - 1;
+  std::size_t slot       = static_cast< std::size_t >( key.hash() ) & mask;
+  while ( mSlots[slot].mPosition != kEmptySlot && mSlots[slot].mKey != key ) {
+    slot = ( slot + 1 ) & mask;
+  }
+  return slot;
+}
+
+auto UuidIndex::find( UuidString const& key ) const -> std::optional< Position >
+{
+  if ( mSize == 0 ) {
+    return std::nullopt;
+  }
+  Slot const& slot = mSlots[slotFor( key )];
+  return slot.mPosition == kEmptySlot ? std::nullopt : std::optional( slot.mPosition );
+}
+
+auto UuidIndex::find( std::string_view key ) const -> std::optional< Position >
+{
+  auto const parsed = UuidStringUtil::tryFromString( key );
+  return parsed ? find( *parsed ) : std::nullopt;
+}
+
+auto UuidIndex::contains( UuidString const& key ) const -> bool
+{
+  return find( key ).has_value();
+}
+
+auto UuidIndex::contains( std::string_view key ) const -> bool
+{
+  return find( key ).has_value();
+}
+
+auto UuidIndex::size() const -> std::size_t
+{
+  return mSize;
+}
+
+auto UuidIndex::insert( UuidString const& key, Position position ) -> bool
+{
+  BSLS_ASSERT( position != kEmptySlot );
+  if ( mSlots.size() < slotCountFor( mSize + 1 ) ) {
+    rehash( slotCountFor( mSize + 1 ) * 2 );
+  }
+
+  Slot& slot = mSlots[slotFor( key )];
+  if ( slot.mPosition != kEmptySlot ) {
+    return false;
+  }
+  slot = { key, position };
+  ++mSize;
+  return true;
+}
+
+auto UuidIndex::update( UuidString const& key, Position position ) -> bool
+{
+  BSLS_ASSERT( position != kEmptySlot );
+  if ( mSize == 0 ) {
+    return false;
+  }
+  Slot& slot = mSlots[slotFor( key )];
+  if ( slot.mPosition == kEmptySlot ) {
+    return false;
+  }
+  slot.mPosition = position;
+  return true;
+}
+
+void UuidIndex::reserve( std::size_t count )
+{
+  if ( mSlots.size() < slotCountFor( count ) ) {
+    rehash( slotCountFor( count ) );
+  }
+}
+
+void UuidIndex::clear()
+{
+  mSlots.clear();
+  mSize = 0;
+}
+
+void UuidIndex::rehash( std::size_t slotCount )
+{
+  bsl::vector< Slot > previous( slotCount, Slot(), mSlots.get_allocator() );
+  mSlots.swap( previous );
+  for ( Slot const& slot : previous ) {
+    if ( slot.mPosition != kEmptySlot ) {
+      mSlots[slotFor( slot.mKey )] = slot;
+    }
+  }
+}
+
+} // namespace dbsc
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
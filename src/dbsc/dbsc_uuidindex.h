@@ -0,0 +1,127 @@
+// dbsc_uuidindex.h
+#ifndef INCLUDED_DBSC_UUIDINDEX
+#define INCLUDED_DBSC_UUIDINDEX
+
+//@PURPOSE: Provide a flat hash index from UuidStrings to dense positions.
+//
+//@CLASSES:
+//  dbsc::UuidIndex: an open-addressing map from UuidString to a 32-bit
+//    position in some caller-owned storage.
+//
+//@DESCRIPTION: This component defines the point-lookup structure used by the
+//  dbsc containers. Containers keep their elements in contiguous storage and
+//  use a UuidIndex to find an element's position from its id.
+//
+//  Slots live in a single array and collisions are resolved by linear
+//  probing, so a lookup touches one or two cache lines regardless of the
+//  number of keys. The index only grows; entries are never erased, matching
+//  the append-only nature of accounts and transactions. Lookups also accept a
+//  `std::string_view`, which is parsed as a UUID; invalid text is simply not
+//  found.
+//
+//  The index does not order its keys. Containers that need a particular
+//  iteration order maintain it separately.
+//
+//  UuidIndex is allocator-aware in the BDE style: the slot array is obtained
+//  from the allocator supplied at construction (the default allocator if
+//  none is), and containers of UuidIndex propagate their allocator to it.
+//
+/// Usage
+/// -----
+/// Example 1: Indexing a vector by id
+///
+/// ```cpp
+/// std::vector<dbsc::Transaction> transactions = ...;
+/// dbsc::UuidIndex index;
+/// for (std::uint32_t i = 0; i < transactions.size(); ++i) {
+///     index.insert(transactions[i].transactionId(), i);
+/// }
+/// if (auto position = index.find("0123abcd-4567-89ef-a0b1-c2d3e4f5a6b7")) {
+///     use(transactions[*position]);
+/// }
+/// ```
+
+#include <dbsc_sharedapi.h>
+#include <dbsc_uuidstring.h>
+
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace dbsc {
+
+/// An append-only, open-addressing hash map from UuidString to a position.
+class UuidIndex
+{
+public:
+  using Position       = std::uint32_t;
+  using allocator_type = bsl::allocator< char >; // NOLINT
+
+  DBSC_API explicit UuidIndex( allocator_type const& allocator = allocator_type() );
+  DBSC_API UuidIndex( UuidIndex const& original, allocator_type const& allocator = allocator_type() );
+  DBSC_API UuidIndex( UuidIndex&& original ) noexcept;
+  DBSC_API UuidIndex( UuidIndex&& original, allocator_type const& allocator );
+  DBSC_API auto operator=( UuidIndex const& rhs ) -> UuidIndex&;
+  DBSC_API auto operator=( UuidIndex&& rhs ) -> UuidIndex&;
+
+  [[nodiscard]] DBSC_API auto get_allocator() const noexcept -> allocator_type; // NOLINT
+
+  [[nodiscard]] DBSC_API auto find( UuidString const& key ) const -> std::optional< Position >;
+  [[nodiscard]] DBSC_API auto find( std::string_view key ) const -> std::optional< Position >;
+  [[nodiscard]] DBSC_API auto contains( UuidString const& key ) const -> bool;
+  [[nodiscard]] DBSC_API auto contains( std::string_view key ) const -> bool;
+  [[nodiscard]] DBSC_API auto size() const -> std::size_t;
+
+  /// Associate @p key with @p position.
+  /// @return false, leaving the index unchanged, if @p key is already present.
+  DBSC_API auto insert( UuidString const& key, Position position ) -> bool;
+
+  /// Re-associate an existing @p key with @p position.
+  /// @return false, leaving the index unchanged, if @p key is absent.
+  DBSC_API auto update( UuidString const& key, Position position ) -> bool;
+
+  /// Ensure @p count keys fit without rehashing.
+  DBSC_API void reserve( std::size_t count );
+
+  DBSC_API void clear();
+
+private:
+  static constexpr Position kEmptySlot = UINT32_MAX;
+
+  struct Slot
+  {
+    UuidString mKey {};
+    Position mPosition { kEmptySlot };
+  };
+
+  [[nodiscard]] auto slotFor( UuidString const& key ) const -> std::size_t;
+  void rehash( std::size_t slotCount );
+
+  bsl::vector< Slot > mSlots;
+  std::size_t mSize { 0 };
+};
+
+} // namespace dbsc
+
+#endif // include guard
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -0,0 +1,98 @@
+// dbsc_uuidindex.t.cpp
+// Test driver for dbsc::UuidIndex
+#include <dbsc_uuidindex.h>
+#include <dbsc_uuidstring.h>
+
+#include <bsls_assert.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace {
+static void testInsertAndFind()
+{
+  constexpr std::uint32_t kKeyCount = 100'000;
+  std::vector< dbsc::UuidString > keys( kKeyCount );
+  dbsc::UuidStringUtil::generateBatch( keys );
+
+  dbsc::UuidIndex index;
+  BSLS_ASSERT( not index.find( keys.front() ).has_value() );
+  for ( std::uint32_t position = 0; position < kKeyCount; ++position ) {
+    BSLS_ASSERT( index.insert( keys[position], position ) );
+  }
+  BSLS_ASSERT( index.size() == kKeyCount );
+
+  for ( std::uint32_t position = 0; position < kKeyCount; ++position ) {
+    BSLS_ASSERT( index.find( keys[position] ) == position );
+  }
+  BSLS_ASSERT( not index.contains( dbsc::UuidStringUtil::generate() ) );
+
+  // Duplicate keys are rejected and keep their original position.
+  BSLS_ASSERT( not index.insert( keys[42], 7 ) );
+  BSLS_ASSERT( index.find( keys[42] ) == 42U );
+  BSLS_ASSERT( index.size() == kKeyCount );
+
+  BSLS_ASSERT( index.update( keys[42], 7 ) );
+  BSLS_ASSERT( index.find( keys[42] ) == 7U );
+  BSLS_ASSERT( not index.update( dbsc::UuidStringUtil::generate(), 7 ) );
+  BSLS_ASSERT( index.size() == kKeyCount );
+}
+
+static void testStringLookup()
+{
+  dbsc::UuidIndex index;
+  auto const key = dbsc::UuidStringUtil::generate();
+  index.reserve( 1 );
+  BSLS_ASSERT( index.insert( key, 3 ) );
+
+  BSLS_ASSERT( index.find( key.toStdString() ) == 3U );
+  BSLS_ASSERT( index.contains( std::string_view( key.view() ) ) );
+  BSLS_ASSERT( not index.contains( std::string_view( "not a uuid" ) ) );
+
+  index.clear();
+  BSLS_ASSERT( index.size() == 0 );
+  BSLS_ASSERT( not index.contains( key ) );
+}
+
+static void testTimeOrderedKeys()
+{
+  // v7 ids share their high word within a millisecond; they must still spread
+  // across the table.
+  auto const now = std::chrono::system_clock::now();
+  dbsc::UuidIndex index;
+  std::vector< dbsc::UuidString > keys;
+  for ( std::uint32_t position = 0; position < 10'000; ++position ) {
+    keys.push_back( dbsc::UuidStringUtil::generateTimeOrdered( now ) );
+    BSLS_ASSERT( index.insert( keys.back(), position ) );
+  }
+  for ( std::uint32_t position = 0; position < keys.size(); ++position ) {
+    BSLS_ASSERT( index.find( keys[position] ) == position );
+  }
+}
+} // namespace
+
+int main()
+{
+  testInsertAndFind();
+  testStringLookup();
+  testTimeOrderedKeys();
+}
+
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
@@ -3,59 +3,311 @@
 
 #include <algorithm>
 #include <array>
-#include <cassert>
+#include <chrono>
+#include <cstring>
 #include <functional>
+#include <ostream>
 #include <random>
+#include <span>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define DBSC_UUIDSTRING_SSE2 1
+#endif
 
 namespace dbsc {
 
-UuidString::UuidString()
-  : mData( uuids::to_string( uuids::uuid {} ) )
+namespace {
+  /// Number of hex digits in a UUID.
+  constexpr std::size_t kHexDigitCount = 2 * UuidString::kByteCount;
+  /// Offsets of the hyphens in the canonical 8-4-4-4-12 form.
+  constexpr std::array< std::size_t, 4 > kHyphenOffsets { 8, 13, 18, 23 };
+  /// [offset, length] of each hex group in the canonical form.
+  constexpr std::array< std::pair< std::size_t, std::size_t >, 5 > kHexGroups {
+    { { 0, 8 }, { 9, 4 }, { 14, 4 }, { 19, 4 }, { 24, 12 } }
+  };
+
+  /// The version nibble lives in byte 6, i.e. bits [12, 16) of the high word.
+  constexpr std::uint64_t kVersionMask  = 0xF000;
+  constexpr std::uint64_t kVersion4Bits = 0x4000;
+  constexpr std::uint64_t kVersion7Bits = 0x7000;
+  constexpr int kVersionShift           = 12;
+  /// UUIDv7 layout of the high word: 48 bits of Unix milliseconds, the
+  /// version nibble, then 12 bits of sub-millisecond fraction.
+  constexpr int kTimeOrderedMillisecondShift = 16;
+  constexpr std::uint64_t kMillisecondMask   = 0xFFFF'FFFF'FFFF;
+  constexpr std::uint64_t kFractionScale     = 4096;
+  /// The RFC4122 variant is the top two bits of byte 8, i.e. of the low word.
+  constexpr std::uint64_t kVariantMask = 0xC000'0000'0000'0000;
+  constexpr std::uint64_t kVariantBits = 0x8000'0000'0000'0000;
+
+  using RandomWordSource = std::mt19937_64;
+
+  /// Each thread owns its engine, so generation needs no synchronization. The
+  /// engine is seeded from std::random_device the first time a thread
+  /// generates an id.
+  auto threadRandomWordSource() -> RandomWordSource&
+  {
+    thread_local RandomWordSource tSource = [] {
+      std::random_device rd {};
+      auto seedData = std::array< std::random_device::result_type, RandomWordSource::state_size > {};
+      std::generate( std::begin( seedData ), std::end( seedData ), std::ref( rd ) );
+      std::seed_seq seq( std::begin( seedData ), std::end( seedData ) );
+      return RandomWordSource { seq };
+    }();
+    return tSource;
+  }
+
+  auto loadBigEndian( std::uint8_t const* bytes ) -> std::uint64_t
+  {
+    std::uint64_t word { 0 };
+    for ( std::size_t i = 0; i < sizeof( word ); ++i ) {
+      word = ( word << 8 ) | bytes[i];
+    }
+    return word;
+  }
+
+  void storeBigEndian( std::uint64_t word, std::uint8_t* bytes )
+  {
+    for ( std::size_t i = sizeof( word ); i > 0; --i ) {
+      bytes[i - 1] = static_cast< std::uint8_t >( word & 0xFF );
+      word >>= 8;
+    }
+  }
+
+  auto hexValue( char c ) -> int
+  {
+    if ( c >= '0' && c <= '9' ) {
+      return c - '0';
+    }
+    char const lower = static_cast< char >( c | 0x20 );
+    if ( lower >= 'a' && lower <= 'f' ) {
+      return lower - 'a' + 10;
+    }
+    return -1;
+  }
+
+  /// Decode exactly 32 hex digits into 16 bytes. @return false on a non-hex
+  /// character.
+  auto decodeHex( char const* digits, std::uint8_t* bytes ) -> bool
+  {
+#if defined( DBSC_UUIDSTRING_SSE2 )
+    auto decodeHalf = []( __m128i chars, __m128i& nibbles ) -> bool {
+      // SSE2 has no unsigned byte compare, so bias into the signed range.
+      __m128i const bias      = _mm_set1_epi8( static_cast< char >( 0x80 ) );
+      __m128i const asDigit   = _mm_sub_epi8( chars, _mm_set1_epi8( '0' ) );
+      __m128i const asLetter  = _mm_sub_epi8( _mm_or_si128( chars, _mm_set1_epi8( 0x20 ) ), _mm_set1_epi8( 'a' ) );
+      __m128i const digitMax  = _mm_set1_epi8( static_cast< char >( 0x80 + 10 ) );
+      __m128i const letterMax = _mm_set1_epi8( static_cast< char >( 0x80 + 6 ) );
+      __m128i const isDigit   = _mm_cmplt_epi8( _mm_xor_si128( asDigit, bias ), digitMax );
+      __m128i const isLetter  = _mm_cmplt_epi8( _mm_xor_si128( asLetter, bias ), letterMax );
+      __m128i const letterVal = _mm_add_epi8( asLetter, _mm_set1_epi8( 10 ) );
+
+      nibbles = _mm_or_si128( _mm_and_si128( isDigit, asDigit ), _mm_andnot_si128( isDigit, letterVal ) );
+      return _mm_movemask_epi8( _mm_or_si128( isDigit, isLetter ) ) == 0xFFFF;
+    };
+    auto packPairs = []( __m128i nibbles ) -> __m128i {
+      __m128i const high = _mm_and_si128( _mm_slli_epi16( nibbles, 4 ), _mm_set1_epi16( 0x00F0 ) );
+      __m128i const low  = _mm_srli_epi16( nibbles, 8 );
+      return _mm_or_si128( high, low );
+    };
+
+    __m128i first {};
+    __m128i second {};
+    bool const valid = decodeHalf( _mm_loadu_si128( reinterpret_cast< __m128i const* >( digits ) ), first )
+                     & decodeHalf( _mm_loadu_si128( reinterpret_cast< __m128i const* >( digits + 16 ) ), second );
+    if ( not valid ) {
+      return false;
+    }
+    __m128i const packed = _mm_packus_epi16( packPairs( first ), packPairs( second ) );
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( bytes ), packed );
+    return true;
+#else
+    for ( std::size_t i = 0; i < UuidString::kByteCount; ++i ) {
+      int const high = hexValue( digits[2 * i] );
+      int const low  = hexValue( digits[2 * i + 1] );
+      if ( high < 0 || low < 0 ) {
+        return false;
+      }
+      bytes[i] = static_cast< std::uint8_t >( ( high << 4 ) | low );
+    }
+    return true;
+#endif
+  }
+
+  /// Encode 16 bytes into 32 lowercase hex digits.
+  void encodeHex( std::uint8_t const* bytes, char* digits )
+  {
+#if defined( DBSC_UUIDSTRING_SSE2 )
+    __m128i const input   = _mm_loadu_si128( reinterpret_cast< __m128i const* >( bytes ) );
+    __m128i const lowMask = _mm_set1_epi8( 0x0F );
+    __m128i const high    = _mm_and_si128( _mm_srli_epi16( input, 4 ), lowMask );
+    __m128i const low     = _mm_and_si128( input, lowMask );
+    auto toAscii          = []( __m128i nibbles ) -> __m128i {
+      // '0' + n for n < 10, 'a' + (n - 10) otherwise.
+      __m128i const isLetter     = _mm_cmpgt_epi8( nibbles, _mm_set1_epi8( 9 ) );
+      __m128i const letterOffset = _mm_and_si128( isLetter, _mm_set1_epi8( 'a' - '0' - 10 ) );
+      return _mm_add_epi8( nibbles, _mm_add_epi8( _mm_set1_epi8( '0' ), letterOffset ) );
+    };
+    __m128i const firstHalf  = toAscii( _mm_unpacklo_epi8( high, low ) );
+    __m128i const secondHalf = toAscii( _mm_unpackhi_epi8( high, low ) );
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( digits ), firstHalf );
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( digits + 16 ), secondHalf );
+#else
+    constexpr std::string_view kHexDigits { "0123456789abcdef" };
+    for ( std::size_t i = 0; i < UuidString::kByteCount; ++i ) {
+      digits[2 * i]     = kHexDigits[bytes[i] >> 4];
+      digits[2 * i + 1] = kHexDigits[bytes[i] & 0x0F];
+    }
+#endif
+  }
+
+  /// Handle the non-canonical inputs `uuids::uuid::from_string` has
+  /// historically accepted: hyphens anywhere, as long as there are exactly 32
+  /// hex digits.
+  auto parseRelaxed( std::string_view candidate, std::uint8_t* bytes ) -> bool
+  {
+    std::size_t digitCount { 0 };
+    for ( char const c : candidate ) {
+      if ( c == '-' ) {
+        continue;
+      }
+      int const value = hexValue( c );
+      if ( value < 0 || digitCount >= kHexDigitCount ) {
+        return false;
+      }
+      if ( digitCount % 2 == 0 ) {
+        bytes[digitCount / 2] = static_cast< std::uint8_t >( value << 4 );
+      } else {
+        bytes[digitCount / 2] |= static_cast< std::uint8_t >( value );
+      }
+      ++digitCount;
+    }
+    return digitCount == kHexDigitCount;
+  }
+} // namespace
+
+UuidString::UuidString() = default;
+
+UuidString::UuidString( std::uint64_t high, std::uint64_t low )
+  : mHigh( high )
+  , mLow( low )
 {
 }
 
-UuidString::UuidString( std::string str )
-  : mData( std::move( str ) )
+auto UuidString::bytes() const noexcept -> Bytes
 {
+  Bytes bytes {};
+  storeBigEndian( mHigh, bytes.data() );
+  storeBigEndian( mLow, bytes.data() + sizeof( mHigh ) );
+  return bytes;
 }
 
 auto UuidString::toStdString() const -> std::string
 {
-  return mData;
+  return std::string( view() );
+}
+
+auto UuidString::view() const noexcept -> Text
+{
+  std::array< char, kHexDigitCount > digits;
+  Bytes const rawBytes = bytes();
+  encodeHex( rawBytes.data(), digits.data() );
+
+  Text text {};
+  std::size_t digitOffset { 0 };
+  for ( auto const& [textOffset, length] : kHexGroups ) {
+    std::memcpy( text.mChars.data() + textOffset, digits.data() + digitOffset, length );
+    digitOffset += length;
+  }
+  for ( auto const offset : kHyphenOffsets ) {
+    text.mChars[offset] = '-';
+  }
+  return text;
+}
+
+auto UuidStringUtil::tryFromString( std::string_view candidate ) -> std::optional< UuidString >
+{
+  if ( not candidate.empty() && candidate.front() == '{' ) {
+    if ( candidate.size() < 2 || candidate.back() != '}' ) {
+      return std::nullopt;
+    }
+    candidate = candidate.substr( 1, candidate.size() - 2 );
+  }
+
+  UuidString::Bytes bytes {};
+  bool const isCanonical = candidate.size() == UuidString::kTextLength
+                        && std::ranges::all_of( kHyphenOffsets, [candidate]( std::size_t offset ) {
+                             return candidate[offset] == '-';
+                           } );
+  if ( isCanonical ) {
+    std::array< char, kHexDigitCount > digits;
+    std::size_t digitOffset { 0 };
+    for ( auto const& [textOffset, length] : kHexGroups ) {
+      std::memcpy( digits.data() + digitOffset, candidate.data() + textOffset, length );
+      digitOffset += length;
+    }
+    if ( not decodeHex( digits.data(), bytes.data() ) ) {
+      return std::nullopt;
+    }
+  } else if ( not parseRelaxed( candidate, bytes.data() ) ) {
+    return std::nullopt;
+  }
+
+  return fromBytes( bytes );
 }
 
-auto UuidString::view() const noexcept -> std::string_view
+auto UuidStringUtil::fromBytes( UuidString::Bytes const& bytes ) -> UuidString
 {
-  return mData;
+  return UuidString( loadBigEndian( bytes.data() ), loadBigEndian( bytes.data() + sizeof( std::uint64_t ) ) );
 }
 
 auto UuidStringUtil::generate() -> UuidString
 {
-  static bool sGeneratorInitialized { false };
-  static std::mt19937 sGenerator;
-
-  if ( not sGeneratorInitialized ) {
-    std::random_device rd {};
-    auto seedData = std::array< int, std::mt19937::state_size > {};
-    std::generate( std::begin( seedData ), std::end( seedData ), std::ref( rd ) );
-    std::seed_seq seq( std::begin( seedData ), std::end( seedData ) );
-    sGenerator            = std::mt19937 { seq };
-    sGeneratorInitialized = true;
+  UuidString uuid;
+  generateBatch( std::span< UuidString >( &uuid, 1 ) );
+  return uuid;
+}
+
+void UuidStringUtil::generateBatch( std::span< UuidString > output )
+{
+  RandomWordSource& source = threadRandomWordSource();
+  for ( UuidString& uuid : output ) {
+    std::uint64_t const high = ( source() & ~kVersionMask ) | kVersion4Bits;
+    std::uint64_t const low  = ( source() & ~kVariantMask ) | kVariantBits;
+    uuid                     = UuidString( high, low );
   }
-  static uuids::uuid_random_generator sUuidGenerator { sGenerator };
+}
 
-  return UuidString( uuids::to_string( sUuidGenerator() ) );
+auto UuidStringUtil::generateTimeOrdered( std::chrono::sys_time< std::chrono::nanoseconds > time ) -> UuidString
+{
+  using namespace std::chrono;
+  auto const sinceEpoch = std::max( time.time_since_epoch(), nanoseconds::zero() );
+  auto const wholeMs    = floor< milliseconds >( sinceEpoch );
+  auto const subMs      = duration_cast< nanoseconds >( sinceEpoch - wholeMs ).count();
+
+  auto const millis   = static_cast< std::uint64_t >( wholeMs.count() ) & kMillisecondMask;
+  auto const fraction = static_cast< std::uint64_t >( subMs ) * kFractionScale / nanoseconds( 1ms ).count();
+
+  std::uint64_t const high = ( millis << kTimeOrderedMillisecondShift ) | kVersion7Bits | fraction;
+  std::uint64_t const low  = ( threadRandomWordSource()() & ~kVariantMask ) | kVariantBits;
+  return UuidString( high, low );
+}
+
+auto UuidStringUtil::version( UuidString const& uuid ) -> int
+{
+  return static_cast< int >( ( uuid.mHigh & kVersionMask ) >> kVersionShift );
 }
 
 auto UuidStringUtil::isNil( UuidString const& uuid ) -> bool
 {
-  return uuids::uuid::from_string( uuid.view() ).value().is_nil();
+  return uuid == UuidString();
 }
 } // namespace dbsc
 
 auto dbsc::operator<<( std::ostream& os, dbsc::UuidString const& uuid ) -> std::ostream&
 {
-  os << uuid.view();
+  os << std::string_view( uuid.view() );
   return os;
 }
 
@@ -2,21 +2,33 @@
 #ifndef INCLUDED_DBSC_UUID_STRING
 #define INCLUDED_DBSC_UUID_STRING
 
-//@PURPOSE: Provide a wrapper around a string that enforces UUID format.
+//@PURPOSE: Provide a compact value type that enforces UUID format.
 //
 //@CLASSES:
 //  dbsc::DuplicateUuidException: an error to note that an entity with some Uuid
 //    already exists.
 //  dbsc::InvalidUuidException: an error to note that a non-uuid-conforming string
 //    was provided.
-//  dbsc::UuidString: a non-modifiable string representing a valid
+//  dbsc::UuidString: a non-modifiable value representing a valid
 //    RFC4122 UUID.
-//  dbsc::UuidStringFactory: an interface to create UuidStrings.
+//  dbsc::UuidStringUtil: an interface to create UuidStrings.
 //
-//@DESCRIPTION: This component defines a wrapper to a string that ensures its
-// RFC4122 compliance as a universal unique indentifier (UUID). Since it is
-// intended to represent uniqueness, the string should be read-only, immune to
-// outside (and possibly internal) modification.
+//@DESCRIPTION: This component defines a value type that ensures its RFC4122
+// compliance as a universal unique indentifier (UUID). Since it is intended to
+// represent uniqueness, the value should be read-only, immune to outside (and
+// possibly internal) modification.
+//
+// Although the type behaves like a string at its boundaries, the UUID is
+// stored as its raw 128 bits in two 64-bit words. This keeps the object
+// allocation-free and makes comparisons (e.g. as a `std::map` key) two integer
+// compares. The words are stored in big-endian byte order so that ordering
+// UuidStrings is identical to ordering their canonical textual forms. Parsing
+// and formatting of the canonical form use SSE2 kernels when available.
+//
+// Generation is thread-safe: every thread seeds its own random engine on first
+// use, so concurrent callers never contend on shared state. Besides random
+// (v4) ids, time-ordered (v7) ids can be minted so that ordering by id is
+// ordering by creation time.
 //
 /// Usage
 /// -----
@@ -30,15 +42,29 @@
 ///     randomId);
 ///
 /// std::cout << randomId << "\n";
+/// std::cout << std::format("{}", randomId) << "\n";
+/// ```
+///
+/// Example 2: Bulk Generation
+///
+/// ```cpp
+/// std::vector<dbsc::UuidString> ids(100'000);
+/// dbsc::UuidStringUtil::generateBatch(ids);
 /// ```
 ///
 
 #include <dbsc_registerexception.h>
 #include <dbsc_sharedapi.h>
 
-#include <uuid.h>
-
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
 #include <iosfwd>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -51,15 +77,37 @@ DBSC_REGISTER_EXCEPTION( DuplicateUuidException, "An object with this UUID alrea
 /// Represents a Uuid construction error due to invalid formatting.
 DBSC_REGISTER_EXCEPTION( InvalidUuidException, "Input is not a UUID-conformant string." );
 
-/// This class provides a read-only, UUID-compliant string. Note that this class
+/// This class provides a read-only, UUID-compliant value. Note that this class
 /// only guarantees UUID compliance in terms of RFC4122; this class makes no
 /// guarantees that there are no duplicate UUIDs (for example, default
 /// construction will always return the null UUID).
 ///
-/// Note that this class assumes UUIDv4, but should work with others.
+/// Note that this class is version-agnostic; UuidStringUtil mints v4 and v7
+/// ids.
 class UuidString
 {
 public:
+  static constexpr std::size_t kByteCount  = 16;
+  static constexpr std::size_t kTextLength = 36;
+  /// The UUID's bytes in RFC4122 (network) order.
+  using Bytes = std::array< std::uint8_t, kByteCount >;
+
+  /// Inline storage for the canonical, lowercase textual form of a UUID
+  /// (ex. "123e4567-e89b-12d3-a456-426614174000"). Converts implicitly to
+  /// `std::string_view`; the view is only valid for the lifetime of this
+  /// object.
+  class Text
+  {
+  public:
+    [[nodiscard]] constexpr auto data() const noexcept -> char const* { return mChars.data(); }
+    [[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return mChars.size(); }
+    [[nodiscard]] constexpr operator std::string_view() const noexcept { return { mChars.data(), mChars.size() }; }
+
+  private:
+    friend class UuidString;
+    std::array< char, kTextLength > mChars {};
+  };
+
   // Constructors enforce the invariant that the object represents a valid UUID.
 
   /// Returns the nil UUID "00000000-0000-0000-0000-000000000000"
@@ -67,16 +115,33 @@ public:
 
   [[nodiscard]] DBSC_API auto operator<=>( UuidString const& other ) const        = default;
   [[nodiscard]] DBSC_API auto operator==( UuidString const& other ) const -> bool = default;
+  [[nodiscard]] DBSC_API auto bytes() const noexcept -> Bytes;
+  /// @return a well-mixed hash of the 128 bits. Cheap enough to recompute on
+  /// every probe; both halves contribute since v7 ids only randomize the low
+  /// word.
+  [[nodiscard]] constexpr auto hash() const noexcept -> std::uint64_t
+  {
+    std::uint64_t mixed = mHigh ^ ( mLow * 0x9E37'79B9'7F4A'7C15 );
+    mixed ^= mixed >> 32;
+    mixed *= 0xD6E8'FEB8'6659'FD93;
+    mixed ^= mixed >> 32;
+    return mixed;
+  }
   [[nodiscard]] DBSC_API auto toStdString() const -> std::string;
-  [[nodiscard]] DBSC_API auto view() const noexcept -> std::string_view;
+  /// @return the canonical textual form. Formatting does not allocate.
+  [[nodiscard]] DBSC_API auto view() const noexcept -> Text;
 
 private:
   friend struct UuidStringUtil;
-  /// Construct a UuidString from an external string source.
+  /// Construct a UuidString from its two big-endian words.
   /// Private since this constructor assumes validation is performed before it's
   /// called.
-  DBSC_API UuidString( std::string str );
-  std::string mData {};
+  DBSC_API UuidString( std::uint64_t high, std::uint64_t low );
+
+  // Declaration order matters: the defaulted comparisons compare `mHigh`
+  // first.
+  std::uint64_t mHigh { 0 };
+  std::uint64_t mLow { 0 };
 };
 
 DBSC_API auto operator<<( std::ostream& oss, UuidString const& str ) -> std::ostream&;
@@ -90,22 +155,59 @@ struct UuidStringUtil
     requires std::is_convertible_v< StringViewable, std::string_view >
   [[nodiscard]] static auto fromString( StringViewable candidate ) -> UuidString
   {
-    std::string_view const candidateView = std::string_view( candidate );
-    auto test                            = uuids::uuid::from_string( candidateView );
-    if ( not test.has_value() ) {
+    auto parsed = tryFromString( std::string_view( candidate ) );
+    if ( not parsed.has_value() ) {
       throw InvalidUuidException {};
     }
 
-    return UuidString( std::string( candidateView ) );
+    return *parsed;
   }
 
-  /// Generate a UUIDv4 (i.e. randomly-generated) string
+  /// Parse @p candidate, accepting upper or lower case hex digits and optional
+  /// enclosing braces. @return std::nullopt if the input is non-conformant.
+  [[nodiscard]] DBSC_API static auto tryFromString( std::string_view candidate ) -> std::optional< UuidString >;
+  /// Construct a UuidString from bytes in RFC4122 order.
+  [[nodiscard]] DBSC_API static auto fromBytes( UuidString::Bytes const& bytes ) -> UuidString;
+  /// Generate a UUIDv4 (i.e. randomly-generated) string. Safe to call
+  /// concurrently; each thread draws from its own lazily-seeded engine.
   [[nodiscard]] DBSC_API static auto generate() -> UuidString;
+  /// Fill @p output with freshly generated UUIDv4 values. Equivalent to
+  /// calling `generate()` for each element, but amortizes the per-thread
+  /// engine lookup.
+  DBSC_API static void generateBatch( std::span< UuidString > output );
+  /// Generate a UUIDv7 whose leading bits encode @p time (Unix milliseconds
+  /// followed by a 12-bit sub-millisecond fraction, RFC9562 method 3). Ids
+  /// minted this way order the same as their timestamps down to ~244ns; ties
+  /// within that window are broken randomly. Times before the Unix epoch are
+  /// clamped to the epoch.
+  [[nodiscard]] DBSC_API static auto generateTimeOrdered( std::chrono::sys_time< std::chrono::nanoseconds > time )
+    -> UuidString;
+  /// @return the RFC4122/RFC9562 version nibble (ex. 4 or 7) of @p uuid.
+  [[nodiscard]] DBSC_API static auto version( UuidString const& uuid ) -> int;
   /// Queries if the uuid is the "00000000-0000-0000-0000-000000000000" string.
   [[nodiscard]] DBSC_API static auto isNil( UuidString const& uuid ) -> bool;
 };
 } // namespace dbsc
 
+template<>
+struct std::hash< dbsc::UuidString >
+{
+  auto operator()( dbsc::UuidString const& uuid ) const noexcept -> std::size_t
+  {
+    return static_cast< std::size_t >( uuid.hash() );
+  }
+};
+
+/// Allow `std::format("{}", uuid)` without an intermediate string.
+template<>
+struct std::formatter< dbsc::UuidString > : std::formatter< std::string_view >
+{
+  auto format( dbsc::UuidString const& uuid, std::format_context& context ) const
+  {
+    return std::formatter< std::string_view >::format( uuid.view(), context );
+  }
+};
+
 #endif // include guard
 
 // -----------------------------------------------------------------------------
@@ -4,8 +4,15 @@
 
 #include <bsls_assert.h>
 
+#include <array>
+#include <chrono>
 #include <iostream>
+#include <mutex>
 #include <ranges>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace {
 static void testException()
@@ -33,12 +40,101 @@ static void testGeneration()
     BSLS_ASSERT( generated == dbsc::UuidStringUtil::fromString( generated.toStdString() ) );
   }
 }
+
+static void testParsing()
+{
+  static_assert( sizeof( dbsc::UuidString ) == dbsc::UuidString::kByteCount );
+
+  std::string const canonical { "0123abcd-4567-89ef-a0b1-c2d3e4f5a6b7" };
+  auto const parsed = dbsc::UuidStringUtil::fromString( canonical );
+  BSLS_ASSERT( parsed.toStdString() == canonical );
+  BSLS_ASSERT( std::string_view( parsed.view() ) == canonical );
+
+  // Inputs accepted for compatibility normalize to the canonical form.
+  BSLS_ASSERT( parsed == dbsc::UuidStringUtil::fromString( "0123ABCD-4567-89EF-A0B1-C2D3E4F5A6B7" ) );
+  BSLS_ASSERT( parsed == dbsc::UuidStringUtil::fromString( "{0123abcd-4567-89ef-a0b1-c2d3e4f5a6b7}" ) );
+  BSLS_ASSERT( parsed == dbsc::UuidStringUtil::fromString( "0123abcd456789efa0b1c2d3e4f5a6b7" ) );
+
+  for ( auto const* invalid : { "", "{0123abcd-4567-89ef-a0b1-c2d3e4f5a6b7", "0123abcd-4567-89ef-a0b1-c2d3e4f5a6bg",
+                                "0123abcd-4567-89ef-a0b1-c2d3e4f5a6b", "0123abcd-4567-89ef-a0b1-c2d3e4f5a6b7a",
+                                "0123abcd-4567-89ef-a0b1-c2d3e4f5a6:7", "0123abcd-4567-89ef-a0b1-c2d3e4f5a6G7" } ) {
+    BSLS_ASSERT( not dbsc::UuidStringUtil::tryFromString( invalid ).has_value() );
+  }
+
+  auto const bytes = parsed.bytes();
+  BSLS_ASSERT( bytes.front() == 0x01 && bytes.back() == 0xB7 );
+  BSLS_ASSERT( dbsc::UuidStringUtil::fromBytes( bytes ) == parsed );
+}
+
+static void testOrdering()
+{
+  // Binary ordering must agree with the ordering of the textual forms so that
+  // iteration order of UuidString-keyed containers is unchanged.
+  auto previous = dbsc::UuidStringUtil::generate();
+  for ( [[maybe_unused]] auto _ : std::views::iota( 0, 1000 ) ) {
+    auto const current = dbsc::UuidStringUtil::generate();
+    BSLS_ASSERT( ( previous < current ) == ( previous.toStdString() < current.toStdString() ) );
+    previous = current;
+  }
+}
+
+static void testBatchGeneration()
+{
+  constexpr int kBatchSize   = 10'000;
+  constexpr int kThreadCount = 4;
+
+  std::mutex mutex;
+  std::set< dbsc::UuidString > seen;
+  {
+    std::vector< std::jthread > workers;
+    for ( [[maybe_unused]] auto _ : std::views::iota( 0, kThreadCount ) ) {
+      workers.emplace_back( [&mutex, &seen]() {
+        std::vector< dbsc::UuidString > batch( kBatchSize );
+        dbsc::UuidStringUtil::generateBatch( batch );
+        std::scoped_lock const lock { mutex };
+        seen.insert( batch.begin(), batch.end() );
+      } );
+    }
+  }
+  BSLS_ASSERT( seen.size() == kBatchSize * kThreadCount );
+
+  for ( auto const& uuid : seen ) {
+    auto const bytes = uuid.bytes();
+    BSLS_ASSERT( ( bytes[6] & 0xF0 ) == 0x40 ); // version 4
+    BSLS_ASSERT( ( bytes[8] & 0xC0 ) == 0x80 ); // RFC4122 variant
+  }
+}
+
+static void testTimeOrderedGeneration()
+{
+  using namespace std::chrono_literals;
+  std::chrono::sys_time< std::chrono::nanoseconds > time { std::chrono::system_clock::now() };
+
+  auto previous = dbsc::UuidStringUtil::generateTimeOrdered( time );
+  BSLS_ASSERT( dbsc::UuidStringUtil::version( previous ) == 7 );
+  BSLS_ASSERT( ( previous.bytes()[8] & 0xC0 ) == 0x80 );
+  BSLS_ASSERT( dbsc::UuidStringUtil::version( dbsc::UuidStringUtil::generate() ) == 4 );
+
+  // Steps both below and above the millisecond boundary must preserve order.
+  std::array< std::chrono::nanoseconds, 5 > const kSteps { 500ns, 250us, 1ms, 37ms, 24h };
+  for ( auto const step : kSteps ) {
+    time += step;
+    auto const current = dbsc::UuidStringUtil::generateTimeOrdered( time );
+    BSLS_ASSERT( previous < current );
+    BSLS_ASSERT( previous.toStdString() < current.toStdString() );
+    previous = current;
+  }
+}
 } // namespace
 
 int main()
 {
   testException();
   testGeneration();
+  testParsing();
+  testOrdering();
+  testBatchGeneration();
+  testTimeOrderedGeneration();
 }
 
 // -----------------------------------------------------------------------------
@@ -56,7 +56,7 @@ auto dbscqt::createAccountItemData( dbsc::Account const& account ) -> dbscqt::Ac
     .mName        = QString::fromStdString( account.name() ),
     .mDescription = QString::fromStdString( account.description() ),
     .mBalance     = dbscqt::DisplayUtil::toDecimalQString( account.balance() ),
-    .mId          = QUuid::fromString( account.id().view() ),
+    .mId          = dbscqt::DisplayUtil::toQUuid( account.id() ),
     .mIsActive    = account.isActive(),
   };
 }
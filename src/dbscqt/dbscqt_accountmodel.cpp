@@ -4,10 +4,11 @@
 #include <dbscqt_transactionitem.h>
 #include <dbsutl_helpers.h>
 
-#include <bsls_assert.h>
-
 #include <QtCore/QTimeZone>
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
 
@@ -121,13 +122,16 @@ auto dbscqt::AccountModel::headerData( int section, Qt::Orientation orientation,
 
 void dbscqt::AccountModel::addTransactionItem( std::unique_ptr< dbscqt::TransactionItem > transactionItemPtr )
 {
-  // Check greater than or equal to in case the timestamps are truncated to the
-  // same value when converting from nanosecond precision to millisecond.
-  BSLS_ASSERT( ( rowCount() > 0 ? transactionItemPtr->timeStamp() >= mImp->mItems.back()->timeStamp() : true ) );
-
-  beginInsertRows( QModelIndex(), 0, 0 );
+  // Backdated transactions go after every item with the same or an earlier
+  // timestamp, matching the order of dbscqt::createTransactionItems.
+  auto const position = std::ranges::upper_bound(
+    mImp->mItems, transactionItemPtr->timeStamp(), std::less(), []( auto const& item ) { return item->timeStamp(); } );
+  // Rows are presented most recent first.
+  int const row = static_cast< int >( std::distance( position, mImp->mItems.end() ) );
+
+  beginInsertRows( QModelIndex(), row, row );
   {
-    mImp->mItems.push_back( std::move( transactionItemPtr ) );
+    mImp->mItems.insert( position, std::move( transactionItemPtr ) );
   }
   endInsertRows();
 }
@@ -45,6 +45,8 @@ public:
   [[nodiscard]] auto headerData( int section, Qt::Orientation orientation, int role = Qt::DisplayRole ) const
     -> QVariant final;
 
+  /// Insert the item at its chronological position; it need not be newer
+  /// than the items already present.
   /// @note Assumes validation has been done on this transaction before adding to the
   /// model. Takes ownership of the incoming transaction item.
   void addTransactionItem( std::unique_ptr< TransactionItem > transactionItemPtr );
@@ -1,6 +1,10 @@
 // dbscqt_displayutil.cpp
 #include "dbscqt_displayutil.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
 auto dbscqt::DisplayUtil::accountNameWithShortenedUuid( QUuid id, QString const& name ) -> QString
 {
   return QString( "%1 (%2)" ).arg( name ).arg( id.toString( QUuid::WithoutBraces ).split( '-' ).front() );
@@ -8,12 +12,45 @@ auto dbscqt::DisplayUtil::accountNameWithShortenedUuid( QUuid id, QString const&
 
 auto dbscqt::DisplayUtil::toQUuid( dbsc::UuidString const& uuidString ) -> QUuid
 {
-  return QUuid::fromString( uuidString.toStdString() );
+  // Both types hold the RFC 4122 (big-endian) bytes; copy them field by field
+  // rather than formatting and re-parsing text.
+  dbsc::UuidString::Bytes const bytes = uuidString.bytes();
+  auto const readBigEndian            = [&bytes]( std::size_t offset, std::size_t count ) {
+    std::uint32_t value { 0 };
+    for ( std::size_t i = 0; i < count; ++i ) {
+      value = ( value << 8U ) | bytes[offset + i];
+    }
+    return value;
+  };
+
+  return { readBigEndian( 0, 4 ),
+           static_cast< ushort >( readBigEndian( 4, 2 ) ),
+           static_cast< ushort >( readBigEndian( 6, 2 ) ),
+           bytes[8],
+           bytes[9],
+           bytes[10],
+           bytes[11],
+           bytes[12],
+           bytes[13],
+           bytes[14],
+           bytes[15] };
 }
 
 auto dbscqt::DisplayUtil::toDbscUuidString( QUuid const uuid ) -> dbsc::UuidString
 {
-  return dbsc::UuidStringUtil::fromString( uuid.toString( QUuid::WithoutBraces ).toStdString() );
+  dbsc::UuidString::Bytes bytes {};
+  auto const writeBigEndian = [&bytes]( std::size_t offset, std::size_t count, std::uint32_t value ) {
+    for ( std::size_t i = count; i > 0; --i ) {
+      bytes[offset + i - 1] = static_cast< std::uint8_t >( value & 0xFFU );
+      value >>= 8U;
+    }
+  };
+  writeBigEndian( 0, 4, uuid.data1 );
+  writeBigEndian( 4, 2, uuid.data2 );
+  writeBigEndian( 6, 2, uuid.data3 );
+  std::ranges::copy( uuid.data4, bytes.begin() + 8 );
+
+  return dbsc::UuidStringUtil::fromBytes( bytes );
 }
 
 auto dbscqt::DisplayUtil::toQDateTime( dbsc::TimeStamp const& timestamp ) -> QDateTime
@@ -25,7 +25,9 @@ struct DBSCQT_API DisplayUtil
 {
   /// @return Formatted string for displaying shortened uuid + name.
   [[nodiscard]] static auto accountNameWithShortenedUuid( QUuid id, QString const& name ) -> QString;
+  /// Convert by copying the 16 raw bytes; no text is produced or parsed.
   [[nodiscard]] static auto toQUuid( dbsc::UuidString const& uuidString ) -> QUuid;
+  /// Convert by copying the 16 raw bytes; no text is produced or parsed.
   [[nodiscard]] static auto toDbscUuidString( QUuid const uuid ) -> dbsc::UuidString;
   [[nodiscard]] static auto toQDateTime( dbsc::TimeStamp const& timestamp ) -> QDateTime;
   [[nodiscard]] static auto toDecimalQString( BloombergLP::bdldfp::Decimal64 amount ) -> QString;
@@ -71,6 +71,13 @@ struct DisplayUtilTest
       auto const quuid = QUuid::createUuid();
       BSLS_ASSERT( ( testRoundTrip< QUuid, dbsc::UuidString >(
         quuid, dbscqt::DisplayUtil::toDbscUuidString, dbscqt::DisplayUtil::toQUuid ) ) );
+
+      // The byte-wise conversion agrees with the textual representation.
+      BSLS_ASSERT( quuid.toString( QUuid::WithoutBraces ).toStdString()
+                   == dbscqt::DisplayUtil::toDbscUuidString( quuid ).toStdString() );
+      BSLS_ASSERT( dbscqt::DisplayUtil::toQUuid( uuidString ) == QUuid::fromString( uuidString.toStdString() ) );
+      BSLS_ASSERT( dbscqt::DisplayUtil::toQUuid( dbsc::UuidString() ).isNull() );
+      BSLS_ASSERT( dbsc::UuidStringUtil::isNil( dbscqt::DisplayUtil::toDbscUuidString( QUuid() ) ) );
     }
   };
 
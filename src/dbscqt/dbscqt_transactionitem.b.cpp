@@ -0,0 +1,120 @@
+// dbscqt_transactionitem.b.cpp
+//
+// Benchmark: cost of building @c dbscqt::TransactionItemData for every
+// transaction in a large account, and of the uuid conversions it performs.
+// Usage: dbscqt_transactionitem.b [transactionCount]
+#include <dbsc_account.h>
+#include <dbsc_accountbook.h>
+#include <dbsc_uuidstring.h>
+#include <dbscqt_displayutil.h>
+#include <dbscqt_transactionitem.h>
+
+#include <bdldfp_decimal.h>
+
+#include <QtCore/QUuid>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace BloombergLP::bdldfp::DecimalLiterals;
+
+/// @return the mean wall-clock nanoseconds per call of @p operation over @p count calls.
+template< typename Operation >
+auto nanosecondsPerItem( std::size_t count, Operation operation ) -> double
+{
+  auto const start = std::chrono::steady_clock::now();
+  for ( std::size_t i = 0; i < count; ++i ) {
+    operation( i );
+  }
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast< double >( std::chrono::duration_cast< std::chrono::nanoseconds >( elapsed ).count() )
+         / static_cast< double >( count );
+}
+
+/// The text-based conversions @c DisplayUtil used before the byte-wise path.
+auto toQUuidViaText( dbsc::UuidString const& uuidString ) -> QUuid
+{
+  return QUuid::fromString( uuidString.toStdString() );
+}
+
+auto toDbscUuidStringViaText( QUuid const uuid ) -> dbsc::UuidString
+{
+  return dbsc::UuidStringUtil::fromString( uuid.toString( QUuid::WithoutBraces ).toStdString() );
+}
+
+} // namespace
+
+int main( int argc, char* argv[] )
+{
+  std::size_t const transactionCount = argc > 1 ? std::strtoull( argv[1], nullptr, 10 ) : 100'000;
+
+  dbsc::AccountBook accountBook { "benchmark" };
+  auto const accountId      = accountBook.createAccount( "Checking", "" );
+  auto const otherAccountId = accountBook.createAccount( "Savings", "" );
+  for ( std::size_t i = 0; i < transactionCount; ++i ) {
+    // Alternate internal transfers and external deposits.
+    std::optional< std::reference_wrapper< dbsc::UuidString const > > otherParty {};
+    if ( i % 2 == 0 ) {
+      otherParty = std::cref( otherAccountId );
+    }
+    accountBook.makeTransaction( "1.00"_d64, "benchmark", accountId, otherParty );
+  }
+
+  std::vector< dbsc::Transaction > transactions;
+  std::vector< dbsc::UuidString > ids;
+  transactions.reserve( transactionCount );
+  ids.reserve( transactionCount );
+  for ( auto const& [id, transaction] : accountBook.account( accountId ) ) {
+    transactions.push_back( transaction );
+    ids.push_back( id );
+  }
+  std::vector< QUuid > quuids( transactionCount );
+
+  // Accumulate results so the optimizer cannot drop the work.
+  std::size_t sink { 0 };
+  auto report = []( char const* label, double nanoseconds ) {
+    std::cout << label << ": " << nanoseconds << " ns/item\n";
+  };
+
+  report( "toQUuid (text)", nanosecondsPerItem( transactionCount, [&]( std::size_t i ) {
+            quuids[i] = toQUuidViaText( ids[i] );
+          } ) );
+  report( "toQUuid (bytes)", nanosecondsPerItem( transactionCount, [&]( std::size_t i ) {
+            quuids[i] = dbscqt::DisplayUtil::toQUuid( ids[i] );
+          } ) );
+  report( "toDbscUuidString (text)", nanosecondsPerItem( transactionCount, [&]( std::size_t i ) {
+            sink += toDbscUuidStringViaText( quuids[i] ).hash();
+          } ) );
+  report( "toDbscUuidString (bytes)", nanosecondsPerItem( transactionCount, [&]( std::size_t i ) {
+            sink += dbscqt::DisplayUtil::toDbscUuidString( quuids[i] ).hash();
+          } ) );
+  report( "createTransactionItemData", nanosecondsPerItem( transactionCount, [&]( std::size_t i ) {
+            sink += static_cast< std::size_t >(
+              dbscqt::createTransactionItemData( transactions[i], accountBook ).mNotes.size() );
+          } ) );
+
+  std::cout << "(checksum " << sink << ")\n";
+}
+// -----------------------------------------------------------------------------
+// Copyright (C) 2025 Terrance Williams
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+// ------------------------------ END_OF_FILE ----------------------------------
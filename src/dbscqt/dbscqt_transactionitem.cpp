@@ -3,10 +3,10 @@
 
 #include <dbsc_account.h>
 #include <dbsc_accountbook.h>
+#include <dbsc_bookviewutil.h>
 #include <dbscqt_displayutil.h>
 
-#include <algorithm>
-#include <ranges>
+#include <iterator>
 
 namespace dbscqt {
 class TransactionItem::Private
@@ -75,7 +75,7 @@ auto dbscqt::createTransactionItemData( dbsc::Transaction const& transaction, db
   return {
     .mTimeStamp             = timestamp,
     .mTransactionAmount     = transactionAmount,
-    .mNotes                 = QString::fromStdString( transaction.notes() ),
+    .mNotes                 = QString::fromUtf8( transaction.notes().data(), std::ssize( transaction.notes() ) ),
     .mOtherPartyAccountName = otherPartyAccountName,
     .mTransactionId         = dbscqt::DisplayUtil::toQUuid( transaction.transactionId() ),
     .mOtherPartyId          = otherPartyId,
@@ -85,20 +85,13 @@ auto dbscqt::createTransactionItemData( dbsc::Transaction const& transaction, db
 auto dbscqt::createTransactionItems( dbsc::Account const& account, dbsc::AccountBook const& accountBook )
   -> std::vector< std::unique_ptr< dbscqt::TransactionItem > >
 {
-  auto transactionsSortedByAscendingDate =
-    account | std::views::transform( []( auto const& transaction ) { return std::cref( transaction ); } )
-    | std::ranges::to< std::vector >();
-  std::ranges::sort( transactionsSortedByAscendingDate, std::less(), []( auto&& item ) -> dbsc::TimeStamp {
-    auto const& [_, transaction] = item.get();
-    return transaction.timestamp();
-  } );
-
+  // The account's balance index already orders its rows chronologically, so
+  // only materialization remains.
   std::vector< std::unique_ptr< dbscqt::TransactionItem > > items;
   items.reserve( account.transactionCount() );
-  for ( auto const& item : transactionsSortedByAscendingDate ) {
-    auto const& [id, transaction] = item.get();
-    items.push_back(
-      std::make_unique< dbscqt::TransactionItem >( dbscqt::createTransactionItemData( transaction, accountBook ) ) );
+  for ( dbsc::TransactionRef const transaction : dbsc::BookViewUtil::transactionsInTimeOrderOf( account ) ) {
+    items.push_back( std::make_unique< dbscqt::TransactionItem >(
+      dbscqt::createTransactionItemData( transaction.materialize(), accountBook ) ) );
   }
 
   return items;